@@ -0,0 +1,30 @@
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <stdint.h>
+#include <chrono>
+
+// Shared bits of the host micro-benchmarks. They print numbers and never
+// fail on timing; their exit code only covers the correctness checks
+// they make along the way.
+
+#define BENCH_ROUNDS 5
+
+// Written with every result so the compiler can't drop the work
+inline volatile uint64_t benchSink;
+
+// Best of BENCH_ROUNDS runs of fn(), in ns. The best run is the one
+// least disturbed by the rest of the machine.
+template <typename Fn>
+double benchBestNs(Fn fn) {
+    double best = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        if (r == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+#endif
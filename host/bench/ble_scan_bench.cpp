@@ -0,0 +1,303 @@
+// BLE scan callbacks per second, and heap allocations per callback, for a
+// crowded room: more advertisers than the MAX_BT_DEVICES table holds, so
+// most advertisements are lookups that find nothing.
+//
+//   copy only          an empty onResult: what the by-value
+//                      BLEAdvertisedDevice costs before any of our code
+//   old onResult       the callback as it was: address toString() per
+//                      table entry in a linear lookup, String name
+//                      classification with indexOf chains
+//   BTHandler          today's BTHandler::onResult, registered by a real
+//                      startScan(): packed 48-bit key, hash index, raw
+//                      advertisement bytes
+//
+// All three see the same advertisements through the BLE shim in the same
+// order. Checks that the old and the new callback build the same device
+// table, and that the new one allocates nothing beyond the argument copy.
+//
+// usage: ble_scan_bench [--advertisers N] [--passes N]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "host_platform.h"
+#include "bt_handler.h"
+#include "oui_lookup.h"
+
+static size_t allocations;
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ==================== THE CALLBACK AS IT WAS ====================
+
+namespace legacy {
+
+BTDevice devices[MAX_BT_DEVICES];
+int deviceCount = 0;
+BTStats stats = {0, 0, 0, false};
+SemaphoreHandle_t deviceMutex = NULL;
+SortedIndex<BTDevice> sortedDevices;
+uint16_t deviceOrder[MAX_BT_DEVICES];
+uint16_t deviceRanks[MAX_BT_DEVICES];
+int8_t rssiHistory[50];
+int rssiIndex = 0;
+int8_t strongestRSSI = -100;
+
+int byRssi(const BTDevice& a, const BTDevice& b) {
+    return b.rssi - a.rssi;
+}
+
+class Callbacks : public BLEAdvertisedDeviceCallbacks {
+public:
+    void onResult(BLEAdvertisedDevice advertisedDevice) {
+        if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(10))) {
+
+            // Check if device already exists
+            bool found = false;
+            for (int i = 0; i < deviceCount; i++) {
+                if (strcmp(devices[i].address, advertisedDevice.getAddress().toString().c_str()) == 0) {
+                    // Update existing device
+                    devices[i].rssi = advertisedDevice.getRSSI();
+                    devices[i].lastSeen = millis();
+                    sortedDevices.update(i);
+                    found = true;
+                    break;
+                }
+            }
+
+            // Add new device
+            if (!found && deviceCount < MAX_BT_DEVICES) {
+                strncpy(devices[deviceCount].address,
+                        advertisedDevice.getAddress().toString().c_str(), 17);
+                devices[deviceCount].address[17] = '\0';
+
+                if (advertisedDevice.haveName()) {
+                    strncpy(devices[deviceCount].name,
+                            advertisedDevice.getName().c_str(), 32);
+                    devices[deviceCount].name[32] = '\0';
+                    devices[deviceCount].hasName = true;
+                } else {
+                    strcpy(devices[deviceCount].name, "Unknown");
+                    devices[deviceCount].hasName = false;
+                }
+
+                devices[deviceCount].rssi = advertisedDevice.getRSSI();
+                devices[deviceCount].isBLE = true;
+                devices[deviceCount].lastSeen = millis();
+
+                BLEAddress address = advertisedDevice.getAddress();
+                devices[deviceCount].vendor = (advertisedDevice.getAddressType() == BLE_ADDR_TYPE_PUBLIC)
+                    ? macVendor(*address.getNative())
+                    : OUI_VENDOR_RANDOM;
+
+                // Detect device type
+                String deviceName = String(devices[deviceCount].name);
+                deviceName.toLowerCase();
+
+                if (deviceName.indexOf("phone") >= 0 || deviceName.indexOf("iphone") >= 0 ||
+                    deviceName.indexOf("galaxy") >= 0 || deviceName.indexOf("pixel") >= 0) {
+                    devices[deviceCount].deviceType = 1; // Phone
+                } else if (deviceName.indexOf("airpod") >= 0 || deviceName.indexOf("buds") >= 0 ||
+                           deviceName.indexOf("headphone") >= 0 || deviceName.indexOf("wh-") >= 0) {
+                    devices[deviceCount].deviceType = 2; // Headset
+                } else if (deviceName.indexOf("speaker") >= 0 || deviceName.indexOf("jbl") >= 0 ||
+                           deviceName.indexOf("bose") >= 0) {
+                    devices[deviceCount].deviceType = 3; // Speaker
+                } else if (deviceName.indexOf("watch") >= 0 || deviceName.indexOf("band") >= 0) {
+                    devices[deviceCount].deviceType = 4; // Watch
+                } else if (deviceName.indexOf("tile") >= 0 || deviceName.indexOf("airtag") >= 0 ||
+                           deviceName.indexOf("tracker") >= 0) {
+                    devices[deviceCount].deviceType = 5; // Tracker
+                } else {
+                    devices[deviceCount].deviceType = 0; // Unknown
+                }
+
+                sortedDevices.insert(deviceCount);
+                deviceCount++;
+                stats.devicesFound++;
+                stats.bleDevices++;
+            }
+
+            // Update RSSI tracking
+            if (advertisedDevice.getRSSI() > strongestRSSI) {
+                strongestRSSI = advertisedDevice.getRSSI();
+            }
+
+            rssiHistory[rssiIndex] = advertisedDevice.getRSSI();
+            rssiIndex = (rssiIndex + 1) % 50;
+
+            xSemaphoreGive(deviceMutex);
+        }
+    }
+};
+
+} // namespace legacy
+
+class CopyOnly : public BLEAdvertisedDeviceCallbacks {
+public:
+    void onResult(BLEAdvertisedDevice advertisedDevice) {
+        benchSink = benchSink + advertisedDevice.getPayloadLength();
+    }
+};
+
+// ==================== THE ROOM ====================
+
+static const char* const NAMES[] = {
+    "iPhone", "Galaxy S24", "Pixel 8", "AirPods Pro", "Galaxy Buds2 Pro", "WH-1000XM4",
+    "JBL Flip 6", "LE-Bose Revolve+ II", "Apple Watch", "Mi Smart Band 7", "Tile",
+    "Chipolo ONE", "[TV] Samsung 7 Series", "Surface Keyboard", NULL, NULL,
+};
+#define NAME_COUNT (sizeof(NAMES) / sizeof(NAMES[0]))
+
+struct Advertiser {
+    uint8_t payload[62];   // Advertisement + scan response, as the stack reports them
+    BLEAdvertisedDevice device;
+};
+
+// Flags, complete local name if any, 20 bytes of manufacturer data
+static void buildAdvertiser(Advertiser& a, uint32_t n) {
+    uint8_t mac[6] = {0x3C, 0x22, 0xFB, (uint8_t)(n >> 16), (uint8_t)(n >> 8), (uint8_t)n};
+    bool isPublic = n % 3 != 0;
+    if (!isPublic) mac[0] = 0xC0 | (uint8_t)(n * 7);   // Static random
+
+    size_t len = 0;
+    a.payload[len++] = 2;
+    a.payload[len++] = 0x01;
+    a.payload[len++] = 0x06;
+
+    const char* name = NAMES[n % NAME_COUNT];
+    if (name != NULL) {
+        size_t nameLen = strlen(name);
+        a.payload[len++] = (uint8_t)(nameLen + 1);
+        a.payload[len++] = 0x09;
+        memcpy(&a.payload[len], name, nameLen);
+        len += nameLen;
+        a.device.setName(name);
+    }
+
+    std::string mfr(20, '\0');
+    mfr[0] = 0x4C;
+    for (size_t i = 2; i < mfr.size(); i++) mfr[i] = (char)(n * 13 + i);
+    a.payload[len++] = (uint8_t)(mfr.size() + 1);
+    a.payload[len++] = 0xFF;
+    memcpy(&a.payload[len], mfr.data(), mfr.size());
+    len += mfr.size();
+
+    a.device.setAddress(BLEAddress(mac));
+    a.device.setAddressType(isPublic ? BLE_ADDR_TYPE_PUBLIC : BLE_ADDR_TYPE_RANDOM);
+    a.device.setRSSI(-40 - (int)((n * 7) % 50));
+    a.device.setManufacturerData(mfr);
+    a.device.setPayload(a.payload, len);
+}
+
+struct Run {
+    double ns;
+    double allocsPerCallback;
+};
+
+static Run runCallbacks(BLEAdvertisedDeviceCallbacks* cb, std::vector<Advertiser>& room, long passes) {
+    // First pass fills the table; the timed ones are the steady state
+    for (Advertiser& a : room) cb->onResult(a.device);
+
+    size_t before = allocations;
+    Run r;
+    r.ns = benchBestNs([&] {
+        for (long p = 0; p < passes; p++) {
+            for (Advertiser& a : room) cb->onResult(a.device);
+        }
+    });
+    r.allocsPerCallback = (double)(allocations - before) / ((double)room.size() * passes * BENCH_ROUNDS);
+    return r;
+}
+
+static void report(const char* name, const Run& r, double calls) {
+    double per = r.ns / calls;
+    printf("%-14s %8.1f ns/callback %8.0f k callbacks/s %6.1f allocs/callback\n",
+           name, per, 1e6 / per, r.allocsPerCallback);
+}
+
+static const BTDevice* findByAddress(const BTDevice* list, int n, const char* address) {
+    for (int i = 0; i < n; i++) {
+        if (!strcmp(list[i].address, address)) return &list[i];
+    }
+    return NULL;
+}
+
+static BTHandler bt;
+
+int main(int argc, char** argv) {
+    long advertisers = 60;
+    long passes = 2000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--advertisers")) advertisers = atol(argv[i + 1]);
+        else if (!strcmp(argv[i], "--passes")) passes = atol(argv[i + 1]);
+    }
+    if (advertisers < 1 || passes < 1) {
+        fprintf(stderr, "usage: ble_scan_bench [--advertisers N] [--passes N]\n");
+        return 2;
+    }
+
+    std::vector<Advertiser> room(advertisers);
+    for (long i = 0; i < advertisers; i++) buildAdvertiser(room[i], (uint32_t)i);
+
+    CopyOnly copyOnly;
+    Run copyRun = runCallbacks(&copyOnly, room, passes);
+
+    legacy::deviceMutex = xSemaphoreCreateMutex();
+    legacy::sortedDevices.attach(legacy::devices, legacy::deviceOrder, legacy::deviceRanks);
+    legacy::sortedDevices.setCompare(legacy::byRssi);
+    legacy::Callbacks legacyCallbacks;
+    Run legacyRun = runCallbacks(&legacyCallbacks, room, passes);
+
+    bt.begin();
+    bt.startScan();
+    BLEAdvertisedDeviceCallbacks* scan = hostBleScanCallbacks();
+    if (scan == NULL) {
+        fprintf(stderr, "ble_scan_bench: startScan() registered no callbacks\n");
+        return 1;
+    }
+    Run btRun = runCallbacks(scan, room, passes);
+    BTDevice table[MAX_BT_DEVICES];
+    int count = bt.copyDevices(table, MAX_BT_DEVICES);
+    bt.stop();
+
+    double calls = (double)advertisers * passes;
+    printf("%ld advertisers, %d-device table, %ld passes\n", advertisers, MAX_BT_DEVICES, passes);
+    report("copy only", copyRun, calls);
+    report("old onResult", legacyRun, calls);
+    report("BTHandler", btRun, calls);
+    printf("BTHandler is %.1fx the old callback's rate\n", legacyRun.ns / btRun.ns);
+
+    int failed = 0;
+    if (count != legacy::deviceCount) {
+        fprintf(stderr, "ble_scan_bench: %d devices, the old callback kept %d\n", count, legacy::deviceCount);
+        failed = 1;
+    }
+    for (int i = 0; i < count; i++) {
+        const BTDevice* old = findByAddress(legacy::devices, legacy::deviceCount, table[i].address);
+        if (old == NULL || strcmp(old->name, table[i].name) || old->hasName != table[i].hasName ||
+            old->deviceType != table[i].deviceType || old->vendor != table[i].vendor || old->rssi != table[i].rssi) {
+            fprintf(stderr, "ble_scan_bench: %s (%s) differs from the old callback's entry\n",
+                    table[i].address, table[i].name);
+            failed = 1;
+        }
+    }
+    if (btRun.allocsPerCallback != copyRun.allocsPerCallback) {
+        fprintf(stderr, "ble_scan_bench: onResult allocates (%.2f per callback, the argument copy %.2f)\n",
+                btRun.allocsPerCallback, copyRun.allocsPerCallback);
+        failed = 1;
+    }
+    return failed;
+}
@@ -0,0 +1,330 @@
+// Promiscuous-callback cost before and after raw MACs: how many frames per
+// second each RX callback sustains on a capture's mix of frames.
+//
+//   sniffer snprintf   snifferCallback as it was: address 2 formatted
+//                      into a char[18] record with snprintf
+//   sniffer raw MAC    the same callback copying the 6 address bytes
+//   deauth snprintf    deauthCallback as it was: addresses 1 and 2
+//                      formatted for every deauth/disassoc frame
+//   deauth raw MAC     the same callback copying them
+//   rxCallback         today's shared callback, registered by a running
+//                      WiFiHandler (sniffer + deauth detector): FrameView,
+//                      decodeRxFrame and the push onto the rx ring
+//
+// The old callbacks posted to a FreeRTOS queue, which the host has no
+// stand-in for; here they push onto an SpscRing, so all five pay the same
+// hand-off and differ only in what they do with the frame. Frames are fed
+// in chunks the consumer can absorb without drops, and only the callback
+// calls are timed. The exit code covers the checks: every variant must
+// queue the same frames, carrying the same addresses, and the real
+// handler must not drop any.
+//
+// usage: capture_path_bench [--passes N] capture.pcap
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "host_platform.h"
+#include "pcap_file.h"
+#include "ieee80211.h"
+#include "spsc_ring.h"
+#include "wifi_handler.h"
+
+#define SLOT_BYTES 512    // RX buffer per frame; the old callbacks read fixed offsets
+#define CHUNK_FRAMES 64   // Callbacks between drains, well under either ring
+#define LEGACY_RING_SIZE 256
+
+// ==================== THE CALLBACKS AS THEY WERE ====================
+
+struct SnifferTextRecord {
+    char bssid[18];
+    int8_t rssi;
+    int channel;
+    PktType type;
+    uint32_t timestamp;
+};
+
+struct SnifferRawRecord {
+    uint8_t bssid[MAC_LEN];
+    int8_t rssi;
+    int channel;
+    PktType type;
+    uint32_t timestamp;
+};
+
+struct DeauthTextEvent {
+    char apMac[18];
+    char clientMac[18];
+    uint8_t reasonCode;
+    uint32_t timestamp;
+    int8_t rssi;
+};
+
+struct DeauthRawEvent {
+    uint8_t apMac[MAC_LEN];
+    uint8_t clientMac[MAC_LEN];
+    uint8_t reasonCode;
+    uint32_t timestamp;
+    int8_t rssi;
+};
+
+static SpscRing<SnifferTextRecord, LEGACY_RING_SIZE> snifferTextRing;
+static SpscRing<SnifferRawRecord, LEGACY_RING_SIZE> snifferRawRing;
+static SpscRing<DeauthTextEvent, LEGACY_RING_SIZE> deauthTextRing;
+static SpscRing<DeauthRawEvent, LEGACY_RING_SIZE> deauthRawRing;
+static int currentChannel = 1;
+
+static PktType legacyType(wifi_promiscuous_pkt_type_t type) {
+    if (type == WIFI_PKT_MGMT) return PKT_MGMT;
+    if (type == WIFI_PKT_DATA) return PKT_DATA;
+    return PKT_CTRL;
+}
+
+static void snifferSnprintf(void* buf, wifi_promiscuous_pkt_type_t type) {
+    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
+    SnifferTextRecord data;
+    data.rssi = pkt->rx_ctrl.rssi;
+    data.channel = currentChannel;
+    data.timestamp = millis();
+    data.type = legacyType(type);
+
+    uint8_t* payload = pkt->payload;
+    snprintf(data.bssid, 18, "%02X:%02X:%02X:%02X:%02X:%02X",
+             payload[10], payload[11], payload[12],
+             payload[13], payload[14], payload[15]);
+    snifferTextRing.push(data);
+}
+
+static void snifferRaw(void* buf, wifi_promiscuous_pkt_type_t type) {
+    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
+    SnifferRawRecord data;
+    data.rssi = pkt->rx_ctrl.rssi;
+    data.channel = currentChannel;
+    data.timestamp = millis();
+    data.type = legacyType(type);
+
+    memcpy(data.bssid, pkt->payload + 10, MAC_LEN);
+    snifferRawRing.push(data);
+}
+
+static void deauthSnprintf(void* buf, wifi_promiscuous_pkt_type_t type) {
+    if (type != WIFI_PKT_MGMT) return;
+    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
+    uint8_t* payload = pkt->payload;
+    if (payload[0] != 0xC0 && payload[0] != 0xA0) return;
+
+    DeauthTextEvent event;
+    event.timestamp = millis();
+    event.rssi = pkt->rx_ctrl.rssi;
+    event.reasonCode = payload[24];
+    snprintf(event.apMac, 18, "%02X:%02X:%02X:%02X:%02X:%02X",
+             payload[10], payload[11], payload[12],
+             payload[13], payload[14], payload[15]);
+    snprintf(event.clientMac, 18, "%02X:%02X:%02X:%02X:%02X:%02X",
+             payload[4], payload[5], payload[6],
+             payload[7], payload[8], payload[9]);
+    deauthTextRing.push(event);
+}
+
+static void deauthRaw(void* buf, wifi_promiscuous_pkt_type_t type) {
+    if (type != WIFI_PKT_MGMT) return;
+    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
+    uint8_t* payload = pkt->payload;
+    if (payload[0] != 0xC0 && payload[0] != 0xA0) return;
+
+    DeauthRawEvent event;
+    event.timestamp = millis();
+    event.rssi = pkt->rx_ctrl.rssi;
+    event.reasonCode = payload[24];
+    memcpy(event.apMac, payload + 10, MAC_LEN);
+    memcpy(event.clientMac, payload + 4, MAC_LEN);
+    deauthRawRing.push(event);
+}
+
+// ==================== CONSUMERS ====================
+
+// What each variant queued over one pass, for the cross-checks
+struct Queued {
+    uint32_t count;
+    uint64_t macHash;   // Over the transmitter bytes, raw or parsed back from text
+};
+
+static void hashMac(Queued& q, const uint8_t* mac) {
+    for (int i = 0; i < MAC_LEN; i++) q.macHash = q.macHash * 131 + mac[i];
+}
+
+static void hashText(Queued& q, const char* text) {
+    uint8_t mac[MAC_LEN];
+    for (int i = 0; i < MAC_LEN; i++) mac[i] = (uint8_t)strtoul(text + i * 3, NULL, 16);
+    hashMac(q, mac);
+}
+
+template <typename Ring, typename Rec, typename Fn>
+static void drainRing(Ring& ring, Queued& q, Fn onRecord) {
+    Rec batch[32];
+    size_t n;
+    while ((n = ring.popBatch(batch, 32)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            q.count++;
+            onRecord(batch[i]);
+        }
+    }
+}
+
+// ==================== FEED ====================
+
+struct Packet {
+    wifi_promiscuous_pkt_t* pkt;
+    wifi_promiscuous_pkt_type_t type;
+};
+
+static wifi_promiscuous_pkt_type_t frameClass(const uint8_t* p, uint16_t len) {
+    if (len == 0) return WIFI_PKT_MISC;
+    switch ((p[0] >> 2) & 0x03) {
+        case FC_TYPE_MGMT: return WIFI_PKT_MGMT;
+        case FC_TYPE_CTRL: return WIFI_PKT_CTRL;
+        case FC_TYPE_DATA: return WIFI_PKT_DATA;
+        default:           return WIFI_PKT_MISC;
+    }
+}
+
+// Best of BENCH_ROUNDS, each `passes` runs over the capture; only the
+// callback calls count, drain() runs between chunks off the clock
+template <typename Drain>
+static double timeCallbackNs(wifi_promiscuous_cb_t cb, const std::vector<Packet>& packets,
+                             long passes, Drain drain) {
+    double best = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        double ns = 0;
+        for (long p = 0; p < passes; p++) {
+            for (size_t i = 0; i < packets.size(); i += CHUNK_FRAMES) {
+                size_t end = i + CHUNK_FRAMES < packets.size() ? i + CHUNK_FRAMES : packets.size();
+                auto t0 = std::chrono::steady_clock::now();
+                for (size_t k = i; k < end; k++) cb(packets[k].pkt, packets[k].type);
+                ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+                drain();
+            }
+        }
+        if (r == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+static void report(const char* name, double ns, double calls, double baselineNs) {
+    double per = ns / calls;
+    printf("%-18s %7.1f ns/frame %8.2f M frames/s", name, per, 1e3 / per);
+    if (baselineNs > 0) printf("  (%.1fx)", baselineNs / ns);
+    printf("\n");
+}
+
+static WiFiHandler wifi;
+
+int main(int argc, char** argv) {
+    long passes = 50;
+    const char* path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--passes") && i + 1 < argc) passes = atol(argv[++i]);
+        else if (path == NULL) path = argv[i];
+    }
+    if (path == NULL || passes < 1) {
+        fprintf(stderr, "usage: capture_path_bench [--passes N] capture.pcap\n");
+        return 2;
+    }
+
+    PcapCapture cap;
+    std::string err;
+    if (!pcapLoad(path, cap, err)) {
+        fprintf(stderr, "capture_path_bench: %s: %s\n", path, err.c_str());
+        return 2;
+    }
+
+    // One RX buffer per frame, as the radio hands them over
+    size_t stride = (sizeof(wifi_promiscuous_pkt_t) + SLOT_BYTES + 7) & ~(size_t)7;
+    std::vector<uint64_t> arena((cap.frames.size() * stride) / 8 + 1);
+    std::vector<Packet> packets;
+    for (size_t i = 0; i < cap.frames.size(); i++) {
+        const PcapFrame& f = cap.frames[i];
+        wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)((uint8_t*)arena.data() + i * stride);
+        uint16_t len = f.len > SLOT_BYTES ? SLOT_BYTES : f.len;
+        pkt->rx_ctrl.rssi = f.rssi;
+        pkt->rx_ctrl.channel = f.channel;
+        pkt->rx_ctrl.sig_len = len;
+        memcpy(pkt->payload, &cap.data[f.offset], len);
+        packets.push_back({pkt, frameClass(pkt->payload, len)});
+    }
+    hostSetMillis(1000);
+
+    Queued snifferText = {}, snifferRawQ = {}, deauthText = {}, deauthRawQ = {};
+    double snifferTextNs = timeCallbackNs(snifferSnprintf, packets, passes, [&] {
+        drainRing<decltype(snifferTextRing), SnifferTextRecord>(snifferTextRing, snifferText,
+            [&](const SnifferTextRecord& rec) { hashText(snifferText, rec.bssid); });
+    });
+    double snifferRawNs = timeCallbackNs(snifferRaw, packets, passes, [&] {
+        drainRing<decltype(snifferRawRing), SnifferRawRecord>(snifferRawRing, snifferRawQ,
+            [&](const SnifferRawRecord& rec) { hashMac(snifferRawQ, rec.bssid); });
+    });
+    double deauthTextNs = timeCallbackNs(deauthSnprintf, packets, passes, [&] {
+        drainRing<decltype(deauthTextRing), DeauthTextEvent>(deauthTextRing, deauthText,
+            [&](const DeauthTextEvent& ev) { hashText(deauthText, ev.apMac); hashText(deauthText, ev.clientMac); });
+    });
+    double deauthRawNs = timeCallbackNs(deauthRaw, packets, passes, [&] {
+        drainRing<decltype(deauthRawRing), DeauthRawEvent>(deauthRawRing, deauthRawQ,
+            [&](const DeauthRawEvent& ev) { hashMac(deauthRawQ, ev.apMac); hashMac(deauthRawQ, ev.clientMac); });
+    });
+
+    // The real thing: rxTask drains the ring once per tick, so give it
+    // a couple between chunks
+    wifi.begin();
+    wifi.startSniffer();
+    wifi.startDeauthDetector();
+    for (int i = 0; i < 1000 && hostPromiscuousCallback() == NULL; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    wifi_promiscuous_cb_t rxCallback = hostPromiscuousCallback();
+    if (rxCallback == NULL) {
+        fprintf(stderr, "capture_path_bench: rxTask never enabled promiscuous mode\n");
+        return 1;
+    }
+    std::vector<Packet> accepted;
+    for (const Packet& p : packets) {
+        if (hostRadioAccepts(p.type)) accepted.push_back(p);
+    }
+    long rxPasses = passes / 10 > 0 ? passes / 10 : 1;
+    double rxNs = timeCallbackNs(rxCallback, accepted, rxPasses, [] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    PipelineStats pipeline = wifi.getPipelineStats();
+    wifi.stop();
+
+    double calls = (double)packets.size() * passes * BENCH_ROUNDS;
+    printf("%zu frames x %ld passes, callbacks timed in chunks of %d\n", packets.size(), passes, CHUNK_FRAMES);
+    report("sniffer snprintf", snifferTextNs, packets.size() * (double)passes, 0);
+    report("sniffer raw MAC", snifferRawNs, packets.size() * (double)passes, snifferTextNs);
+    report("deauth snprintf", deauthTextNs, packets.size() * (double)passes, 0);
+    report("deauth raw MAC", deauthRawNs, packets.size() * (double)passes, deauthTextNs);
+    report("rxCallback", rxNs, accepted.size() * (double)rxPasses, 0);
+    printf("rx queue           %u queued, %u dropped, %u malformed\n",
+           pipeline.rx.enqueued, pipeline.rx.dropped, pipeline.rxMalformed);
+
+    int failed = 0;
+    if (snifferText.count != calls || snifferRawQ.count != calls || snifferText.macHash != snifferRawQ.macHash) {
+        fprintf(stderr, "capture_path_bench: sniffer variants queued different records\n");
+        failed = 1;
+    }
+    if (deauthText.count == 0 || deauthText.count != deauthRawQ.count || deauthText.macHash != deauthRawQ.macHash) {
+        fprintf(stderr, "capture_path_bench: deauth variants queued different events\n");
+        failed = 1;
+    }
+    if (pipeline.rx.dropped != 0) {
+        fprintf(stderr, "capture_path_bench: rx ring dropped %u frames\n", pipeline.rx.dropped);
+        failed = 1;
+    }
+    return failed;
+}
@@ -0,0 +1,220 @@
+// Replays a capture through the per-subtype frame histogram and times it
+// against the MGMT/DATA/CTRL counting it replaced:
+//
+//   type buckets       the old snifferCallback counting: one of three
+//                      counters, from the radio's packet type; never
+//                      touches the frame, so it is the floor
+//   fc histogram       the frame-control decode alone: slot, to/from-DS
+//                      and retry straight off the first two bytes
+//   TrafficAnalyzer    decodeRxFrame plus TrafficAnalyzer::onFrame, with
+//                      a snapshot published per RX_BATCH_SIZE batch, as
+//                      the RX pipeline runs it
+//
+// Checks that the histogram matches one built the slow way, byte by byte,
+// that the analyzer's published snapshot matches too, and that none of
+// the timed loops allocates (operator new is counted).
+//
+// usage: frame_histogram_bench [--passes N] capture.pcap
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "pcap_file.h"
+#include "frame_decode.h"
+#include "ieee80211.h"
+#include "rx_analyzers.h"
+#include "wifi_handler.h"
+
+static size_t allocations;
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+struct TypeCounts {
+    uint32_t mgmt;
+    uint32_t data;
+    uint32_t ctrl;
+};
+
+static PktType radioType(const uint8_t* p) {
+    switch ((p[0] >> 2) & 0x03) {
+        case FC_TYPE_MGMT: return PKT_MGMT;
+        case FC_TYPE_DATA: return PKT_DATA;
+        default:           return PKT_CTRL;
+    }
+}
+
+__attribute__((noinline)) static void countTypes(const std::vector<RxFrame>& frames, TypeCounts& out) {
+    for (const RxFrame& f : frames) {
+        switch (f.type) {
+            case PKT_MGMT: out.mgmt++; break;
+            case PKT_DATA: out.data++; break;
+            case PKT_CTRL: out.ctrl++; break;
+            default: break;
+        }
+    }
+}
+
+__attribute__((noinline)) static void countSlots(const std::vector<RxFrame>& frames, FrameHistogram& out) {
+    for (const RxFrame& f : frames) {
+        uint16_t fc = fcFromPayload(f.payload);
+        out.slots[fcSlot(fc)]++;
+        out.dsFlags[fcDsBits(fc)]++;
+        if (fcIsRetry(fc)) out.retries++;
+        out.total++;
+    }
+}
+
+// clockMs carries on from pass to pass so the RSSI windows see time move forward
+__attribute__((noinline)) static void analyze(const std::vector<RxFrame>& frames, TrafficAnalyzer& traffic,
+                                              uint32_t& clockMs) {
+    WiFiEventData batch[RX_BATCH_SIZE];
+    size_t n = 0;
+    uint32_t startMs = clockMs;
+    uint32_t nowMs = startMs;
+    for (const RxFrame& f : frames) {
+        nowMs = startMs + f.rxTimestamp / 1000;
+        decodeRxFrame(f, nowMs, batch[n++], false);
+        if (n == RX_BATCH_SIZE) {
+            for (size_t i = 0; i < n; i++) traffic.onFrame(batch[i]);
+            traffic.onBatchEnd(nowMs);
+            n = 0;
+        }
+    }
+    for (size_t i = 0; i < n; i++) traffic.onFrame(batch[i]);
+    traffic.onBatchEnd(nowMs);
+    clockMs = nowMs + 1;
+}
+
+// Reference: every field pulled out of the bytes on its own
+static void slowHistogram(const std::vector<RxFrame>& frames, FrameHistogram& out) {
+    memset(&out, 0, sizeof(out));
+    for (const RxFrame& f : frames) {
+        int type = (f.payload[0] >> 2) & 0x03;
+        int subtype = f.payload[0] >> 4;
+        bool toDs = (f.payload[1] & 0x01) != 0;
+        bool fromDs = (f.payload[1] & 0x02) != 0;
+        bool retry = (f.payload[1] & 0x08) != 0;
+        out.slots[type * 16 + subtype]++;
+        out.dsFlags[(fromDs ? 2 : 0) + (toDs ? 1 : 0)]++;
+        if (retry) out.retries++;
+        out.total++;
+    }
+}
+
+static bool sameHistogram(const FrameHistogram& a, const FrameHistogram& b) {
+    return !memcmp(a.slots, b.slots, sizeof(a.slots)) && !memcmp(a.dsFlags, b.dsFlags, sizeof(a.dsFlags)) &&
+           a.retries == b.retries && a.total == b.total;
+}
+
+static TrafficAnalyzer traffic;
+
+int main(int argc, char** argv) {
+    long passes = 2000;
+    const char* path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--passes") && i + 1 < argc) passes = atol(argv[++i]);
+        else if (path == NULL) path = argv[i];
+    }
+    if (path == NULL || passes < 1) {
+        fprintf(stderr, "usage: frame_histogram_bench [--passes N] capture.pcap\n");
+        return 2;
+    }
+
+    PcapCapture cap;
+    std::string err;
+    if (!pcapLoad(path, cap, err)) {
+        fprintf(stderr, "frame_histogram_bench: %s: %s\n", path, err.c_str());
+        return 2;
+    }
+
+    // What reaches the histogram: frames the RX callback doesn't drop as runts
+    std::vector<RxFrame> frames;
+    for (const PcapFrame& f : cap.frames) {
+        const uint8_t* p = &cap.data[f.offset];
+        if (!FrameView(p, f.len).valid()) continue;
+        frames.push_back({p, f.len, radioType(p), f.rssi, f.channel,
+                          (uint32_t)(f.tsUs - cap.frames.front().tsUs)});
+    }
+    if (frames.empty()) {
+        fprintf(stderr, "frame_histogram_bench: %s: no frames to replay\n", path);
+        return 2;
+    }
+
+    FrameHistogram reference;
+    slowHistogram(frames, reference);
+
+    // One pass each for the checks
+    TypeCounts types = {};
+    FrameHistogram hist = {};
+    uint32_t clockMs = 0;
+    traffic.reset(0);
+    countTypes(frames, types);
+    countSlots(frames, hist);
+    analyze(frames, traffic, clockMs);
+    FrameHistogram published = {};
+    bool haveSnapshot = traffic.readFrames(published);
+
+    size_t allocsBefore = allocations;
+    double typesNs = benchBestNs([&] {
+        TypeCounts t = {};
+        for (long p = 0; p < passes; p++) countTypes(frames, t);
+        benchSink = benchSink + t.mgmt + t.data + t.ctrl;
+    });
+    double slotsNs = benchBestNs([&] {
+        FrameHistogram h = {};
+        for (long p = 0; p < passes; p++) countSlots(frames, h);
+        benchSink = benchSink + h.total;
+    });
+    double analyzeNs = benchBestNs([&] {
+        for (long p = 0; p < passes; p++) analyze(frames, traffic, clockMs);
+    });
+    size_t timedAllocs = allocations - allocsBefore;
+
+    double n = (double)frames.size() * passes;
+    printf("%zu frames x %ld passes\n", frames.size(), passes);
+    printf("type buckets      %6.2f ns/frame\n", typesNs / n);
+    printf("fc histogram      %6.2f ns/frame\n", slotsNs / n);
+    printf("TrafficAnalyzer   %6.2f ns/frame (decodeRxFrame + onFrame)\n", analyzeNs / n);
+    int order[FRAME_SLOT_COUNT];
+    for (int i = 0; i < FRAME_SLOT_COUNT; i++) order[i] = i;
+    std::sort(order, order + FRAME_SLOT_COUNT, [&](int a, int b) { return reference.slots[a] > reference.slots[b]; });
+    printf("retries %u, to/from DS %u/%u/%u/%u, busiest:",
+           reference.retries, reference.dsFlags[0], reference.dsFlags[1], reference.dsFlags[2], reference.dsFlags[3]);
+    for (int i = 0; i < 4 && reference.slots[order[i]] > 0; i++) {
+        printf(" %s %u", frameSlotName(order[i]), reference.slots[order[i]]);
+    }
+    printf("\n");
+
+    int failed = 0;
+    if (types.mgmt + types.data + types.ctrl != reference.total) {
+        fprintf(stderr, "frame_histogram_bench: type buckets counted %u frames, expected %u\n",
+                types.mgmt + types.data + types.ctrl, reference.total);
+        failed = 1;
+    }
+    if (!sameHistogram(hist, reference)) {
+        fprintf(stderr, "frame_histogram_bench: fc histogram differs from the byte-by-byte one\n");
+        failed = 1;
+    }
+    if (!haveSnapshot || !sameHistogram(published, reference)) {
+        fprintf(stderr, "frame_histogram_bench: TrafficAnalyzer published a different histogram\n");
+        failed = 1;
+    }
+    if (timedAllocs != 0) {
+        fprintf(stderr, "frame_histogram_bench: %zu allocations while replaying\n", timedAllocs);
+        failed = 1;
+    }
+    return failed;
+}
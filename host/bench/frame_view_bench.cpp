@@ -0,0 +1,144 @@
+// FrameView against the fixed-offset reads the RX callback made before it:
+// frame control, receiver, transmitter and reason code out of every frame
+// of a capture. The unchecked variant reads past short frames, so each
+// frame sits in its own RX-buffer-sized slot, as on the radio. Also checks
+// that both agree wherever the frame really carries the field.
+//
+// usage: frame_view_bench [--passes N] capture.pcap
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "pcap_file.h"
+#include "frame_decode.h"
+#include "ieee80211.h"
+
+#define SLOT_BYTES 512
+
+struct Fields {
+    uint16_t fc;
+    uint8_t receiver[MAC_LEN];
+    uint8_t transmitter[MAC_LEN];
+    uint16_t reason;
+};
+
+struct Frame {
+    const uint8_t* p;
+    uint16_t len;
+};
+
+// The reads as they were: fixed offsets, sig_len never looked at
+__attribute__((noinline)) static uint64_t readUnchecked(const std::vector<Frame>& frames, Fields* out) {
+    uint64_t h = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        const uint8_t* p = frames[i].p;
+        Fields& f = out[i];
+        f.fc = fcFromPayload(p);
+        memcpy(f.receiver, p + HDR_ADDR1_OFFSET, MAC_LEN);
+        memcpy(f.transmitter, p + HDR_ADDR2_OFFSET, MAC_LEN);
+        f.reason = slotIsDeauth(fcSlot(f.fc)) ? (uint16_t)(p[24] | (p[25] << 8)) : 0;
+        h += f.fc + f.receiver[5] + f.transmitter[5] + f.reason;
+    }
+    return h;
+}
+
+__attribute__((noinline)) static uint64_t readChecked(const std::vector<Frame>& frames, Fields* out) {
+    uint64_t h = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        FrameView view(frames[i].p, frames[i].len);
+        Fields& f = out[i];
+        if (!view.valid()) {
+            f.fc = 0;
+            continue;
+        }
+        f.fc = view.fc();
+        memcpy(f.receiver, view.addr1(), MAC_LEN);
+        const uint8_t* ta = view.addr2();
+        if (ta != nullptr) memcpy(f.transmitter, ta, MAC_LEN);
+        else memset(f.transmitter, 0, MAC_LEN);
+        f.reason = 0;
+        view.reasonCode(f.reason);
+        h += f.fc + f.receiver[5] + f.transmitter[5] + f.reason;
+    }
+    return h;
+}
+
+__attribute__((noinline)) static uint64_t decodeAll(const std::vector<Frame>& frames, WiFiEventData* out) {
+    uint64_t h = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        RxFrame frame = {frames[i].p, frames[i].len, PKT_MGMT, -50, 1, 0};
+        if (decodeRxFrame(frame, 0, out[i], false)) h += out[i].frameControl + out[i].bssid[5];
+    }
+    return h;
+}
+
+int main(int argc, char** argv) {
+    long passes = 2000;
+    const char* path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--passes") && i + 1 < argc) passes = atol(argv[++i]);
+        else if (path == NULL) path = argv[i];
+    }
+    if (path == NULL || passes < 1) {
+        fprintf(stderr, "usage: frame_view_bench [--passes N] capture.pcap\n");
+        return 2;
+    }
+
+    PcapCapture cap;
+    std::string err;
+    if (!pcapLoad(path, cap, err)) {
+        fprintf(stderr, "frame_view_bench: %s: %s\n", path, err.c_str());
+        return 2;
+    }
+
+    std::vector<uint8_t> arena(cap.frames.size() * SLOT_BYTES);
+    std::vector<Frame> frames;
+    for (size_t i = 0; i < cap.frames.size(); i++) {
+        const PcapFrame& pf = cap.frames[i];
+        uint16_t len = pf.len > SLOT_BYTES ? SLOT_BYTES : pf.len;
+        memcpy(&arena[i * SLOT_BYTES], &cap.data[pf.offset], len);
+        frames.push_back({&arena[i * SLOT_BYTES], len});
+    }
+
+    std::vector<Fields> unchecked(frames.size());
+    std::vector<Fields> checked(frames.size());
+    std::vector<WiFiEventData> records(frames.size());
+
+    double uncheckedNs = benchBestNs([&] {
+        for (long p = 0; p < passes; p++) benchSink = benchSink + readUnchecked(frames, unchecked.data());
+    });
+    double checkedNs = benchBestNs([&] {
+        for (long p = 0; p < passes; p++) benchSink = benchSink + readChecked(frames, checked.data());
+    });
+    double decodeNs = benchBestNs([&] {
+        for (long p = 0; p < passes; p++) benchSink = benchSink + decodeAll(frames, records.data());
+    });
+
+    // Same answer wherever the frame is long enough to hold the field
+    int mismatches = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        FrameView view(frames[i].p, frames[i].len);
+        if (!view.valid()) continue;
+        const Fields& u = unchecked[i];
+        const Fields& c = checked[i];
+        bool same = u.fc == c.fc && !memcmp(u.receiver, c.receiver, MAC_LEN);
+        if (view.addr2() != nullptr) same = same && !memcmp(u.transmitter, c.transmitter, MAC_LEN);
+        uint16_t reason;
+        if (view.reasonCode(reason)) same = same && u.reason == c.reason;
+        if (!same) mismatches++;
+    }
+
+    double n = (double)frames.size() * passes;
+    printf("%zu frames x %ld passes\n", frames.size(), passes);
+    printf("unchecked reads   %6.2f ns/frame\n", uncheckedNs / n);
+    printf("FrameView         %6.2f ns/frame (%+.0f%%)\n", checkedNs / n, (checkedNs / uncheckedNs - 1) * 100);
+    printf("decodeRxFrame     %6.2f ns/frame\n", decodeNs / n);
+    if (mismatches) {
+        fprintf(stderr, "frame_view_bench: %d frames read differently\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
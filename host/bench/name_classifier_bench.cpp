@@ -0,0 +1,229 @@
+// classifyName() against the String/indexOf chains it replaced. A name
+// used to be lowercased into a String and scanned up to 15 times for its
+// device type (onResult, detectDeviceType), then copied and lowercased
+// again and scanned up to 5 times by isTracker. classifyName answers
+// both in one pass over the DFA in name_keywords.h.
+//
+//   String/indexOf     type chain plus tracker chain, as the three call
+//                      sites ran them
+//   keyword loop       one case-folding substring scan per keyword, no
+//                      String (the step between the two); tolower() on
+//                      every character of every scan, where indexOf gets
+//                      the library's strstr
+//   classifyName       the generated DFA
+//
+// The host String is std::string, whose small-string buffer spares short
+// names the heap; the allocations per name printed are a floor for the
+// device's String. Before timing, all three must agree on every name of
+// a fixed list and of a few hundred thousand generated ones.
+//
+// usage: name_classifier_bench [--passes N]
+
+#include <Arduino.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "name_classifier.h"
+
+static size_t allocations;
+
+void* operator new(size_t size) {
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ==================== THE CHAINS AS THEY WERE ====================
+
+static uint8_t stringType(const char* text) {
+    String deviceName = String(text);
+    deviceName.toLowerCase();
+
+    if (deviceName.indexOf("phone") >= 0 || deviceName.indexOf("iphone") >= 0 ||
+        deviceName.indexOf("galaxy") >= 0 || deviceName.indexOf("pixel") >= 0) {
+        return 1; // Phone
+    } else if (deviceName.indexOf("airpod") >= 0 || deviceName.indexOf("buds") >= 0 ||
+               deviceName.indexOf("headphone") >= 0 || deviceName.indexOf("wh-") >= 0) {
+        return 2; // Headset
+    } else if (deviceName.indexOf("speaker") >= 0 || deviceName.indexOf("jbl") >= 0 ||
+               deviceName.indexOf("bose") >= 0) {
+        return 3; // Speaker
+    } else if (deviceName.indexOf("watch") >= 0 || deviceName.indexOf("band") >= 0) {
+        return 4; // Watch
+    } else if (deviceName.indexOf("tile") >= 0 || deviceName.indexOf("airtag") >= 0 ||
+               deviceName.indexOf("tracker") >= 0) {
+        return 5; // Tracker
+    }
+    return 0; // Unknown
+}
+
+static bool stringTracker(const char* text) {
+    String name = String(text);
+    name.toLowerCase();
+
+    return name.indexOf("tile") >= 0 || name.indexOf("airtag") >= 0 ||
+           name.indexOf("chipolo") >= 0 || name.indexOf("trackr") >= 0 ||
+           name.indexOf("nutfind") >= 0;
+}
+
+// ==================== KEYWORD LOOP ====================
+
+struct TypeKeyword {
+    const char* word;   // Lower case
+    uint8_t type;
+};
+
+static const TypeKeyword TYPE_KEYWORDS[] = {
+    {"phone", 1}, {"iphone", 1}, {"galaxy", 1}, {"pixel", 1},
+    {"airpod", 2}, {"buds", 2}, {"headphone", 2}, {"wh-", 2},
+    {"speaker", 3}, {"jbl", 3}, {"bose", 3},
+    {"watch", 4}, {"band", 4},
+    {"tile", 5}, {"airtag", 5}, {"tracker", 5}
+};
+
+static const char* const TRACKER_KEYWORDS[] = {"tile", "airtag", "chipolo", "trackr", "nutfind"};
+
+static bool containsNoCase(const char* s, const char* word) {
+    for (; *s; s++) {
+        int i = 0;
+        while (word[i] && tolower((unsigned char)s[i]) == word[i]) i++;
+        if (!word[i]) return true;
+    }
+    return false;
+}
+
+static NameClass loopClassify(const char* name) {
+    NameClass out = {0, false};
+    for (const TypeKeyword& k : TYPE_KEYWORDS) {
+        if (containsNoCase(name, k.word)) {
+            out.deviceType = k.type;
+            break;
+        }
+    }
+    for (const char* word : TRACKER_KEYWORDS) {
+        if (containsNoCase(name, word)) {
+            out.tracker = true;
+            break;
+        }
+    }
+    return out;
+}
+
+// ==================== NAMES ====================
+
+static const char* const NAMES[] = {
+    "iPhone", "Galaxy S24 Ultra", "Pixel 8 Pro", "AirPods Pro", "Galaxy Buds2 Pro", "WH-1000XM4",
+    "JBL Flip 6", "LE-Bose Revolve+ II", "Apple Watch", "Mi Smart Band 7", "Tile", "Chipolo ONE",
+    "[TV] Samsung 7 Series", "Surface Keyboard", "TrackR bravo", "Nutfind", "AIRTAG", "Unknown",
+    "Forerunner 255", "MX Master 3", "Phonak Marvel", "HEADPHONES", "Headphone Watch", "bandit",
+    "Q30 Speaker", "ESP32-Flipper", "", "Versatile", "Chromecast", "LE_WF-1000XM5",
+};
+#define NAME_COUNT (sizeof(NAMES) / sizeof(NAMES[0]))
+
+// Random names stitched from keyword pieces, case flipped at random, so
+// near misses ("trackr" vs "tracker", "wh" without "-") come up often
+static std::string generatedName(uint32_t& seed) {
+    static const char* const PIECES[] = {
+        "pho", "ne", "i", "gal", "axy", "pix", "el", "air", "pod", "tag", "bu", "ds", "head",
+        "wh", "-", "spea", "ker", "jbl", "bo", "se", "wat", "ch", "ba", "nd", "ti", "le",
+        "trac", "kr", "r", "chip", "olo", "nut", "find", " ", "x", "7",
+    };
+    std::string s;
+    seed = seed * 1103515245 + 12345;
+    int pieces = 1 + (seed >> 16) % 6;
+    for (int i = 0; i < pieces; i++) {
+        seed = seed * 1103515245 + 12345;
+        s += PIECES[(seed >> 16) % (sizeof(PIECES) / sizeof(PIECES[0]))];
+    }
+    for (char& c : s) {
+        seed = seed * 1103515245 + 12345;
+        if ((seed >> 16) & 1) c = (char)toupper((unsigned char)c);
+    }
+    return s;
+}
+
+static bool agree(const char* name) {
+    NameClass dfa = classifyName(name);
+    NameClass loop = loopClassify(name);
+    bool ok = dfa.deviceType == stringType(name) && dfa.tracker == stringTracker(name) &&
+              dfa.deviceType == loop.deviceType && dfa.tracker == loop.tracker;
+    if (!ok) {
+        fprintf(stderr, "name_classifier_bench: \"%s\": classifyName %u/%d, String %u/%d, loop %u/%d\n",
+                name, dfa.deviceType, dfa.tracker, stringType(name), stringTracker(name),
+                loop.deviceType, loop.tracker);
+    }
+    return ok;
+}
+
+static void report(const char* name, double ns, double calls, double allocs, double baselineNs) {
+    printf("%-16s %7.1f ns/name %5.2f allocs/name", name, ns / calls, allocs / calls);
+    if (baselineNs > 0) printf("  (%.1fx)", baselineNs / ns);
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    long passes = 20000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--passes")) passes = atol(argv[i + 1]);
+    }
+    if (passes < 1) {
+        fprintf(stderr, "usage: name_classifier_bench [--passes N]\n");
+        return 2;
+    }
+
+    int mismatches = 0;
+    for (const char* name : NAMES) mismatches += !agree(name);
+    uint32_t seed = 1;
+    for (int i = 0; i < 300000 && mismatches < 10; i++) mismatches += !agree(generatedName(seed).c_str());
+    if (mismatches) return 1;
+
+    size_t before = allocations;
+    double stringNs = benchBestNs([&] {
+        for (long p = 0; p < passes; p++) {
+            for (const char* name : NAMES) benchSink = benchSink + stringType(name) + stringTracker(name);
+        }
+    });
+    double stringAllocs = (double)(allocations - before) / BENCH_ROUNDS;
+
+    before = allocations;
+    double loopNs = benchBestNs([&] {
+        for (long p = 0; p < passes; p++) {
+            for (const char* name : NAMES) {
+                NameClass c = loopClassify(name);
+                benchSink = benchSink + c.deviceType + c.tracker;
+            }
+        }
+    });
+    double loopAllocs = (double)(allocations - before) / BENCH_ROUNDS;
+
+    before = allocations;
+    double dfaNs = benchBestNs([&] {
+        for (long p = 0; p < passes; p++) {
+            for (const char* name : NAMES) {
+                NameClass c = classifyName(name);
+                benchSink = benchSink + c.deviceType + c.tracker;
+            }
+        }
+    });
+    double dfaAllocs = (double)(allocations - before) / BENCH_ROUNDS;
+
+    double calls = (double)NAME_COUNT * passes;
+    printf("%zu names x %ld passes, all three agree\n", NAME_COUNT, passes);
+    report("String/indexOf", stringNs, calls, stringAllocs, 0);
+    report("keyword loop", loopNs, calls, loopAllocs, stringNs);
+    report("classifyName", dfaNs, calls, dfaAllocs, stringNs);
+    if (dfaAllocs != 0) {
+        fprintf(stderr, "name_classifier_bench: classifyName allocated\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+// libFuzzer target for the RX parser: FrameView's accessors and
+// decodeRxFrame/deauthFromRecord on arbitrary bytes. The input is the
+// frame as the radio hands it over, length = sig_len, so every read past
+// the end is an ASan report. Fields a view hands out must lie inside the
+// frame, and a decoded record must agree with the view it came from.
+//
+// With clang: cmake -DCMAKE_CXX_COMPILER=clang++ enables -fsanitize=fuzzer.
+// Otherwise fuzz/standalone_main.cpp drives it (see CMakeLists.txt).
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "frame_decode.h"
+#include "ieee80211.h"
+
+#define FUZZ_CHECK(cond) do { \
+        if (!(cond)) { fprintf(stderr, "frame_view_fuzz: %s failed, line %d\n", #cond, __LINE__); abort(); } \
+    } while (0)
+
+static volatile uint32_t sink;
+
+// In bounds, and touched so ASan sees the read
+static void checkField(const uint8_t* field, uint32_t size, const uint8_t* data, size_t len) {
+    if (field == nullptr) return;
+    FUZZ_CHECK(field >= data && field + size <= data + len);
+    uint32_t h = 0;
+    for (uint32_t i = 0; i < size; i++) h = h * 31 + field[i];
+    sink = sink + h;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    uint16_t len = size > 0xFFFF ? 0xFFFF : (uint16_t)size;
+    FrameView view(data, len);
+
+    if (!view.valid()) {
+        FUZZ_CHECK(len < HDR_MIN_LEN);
+        RxFrame frame = {data, len, PKT_MGMT, -50, 1, 0};
+        WiFiEventData rec;
+        FUZZ_CHECK(!decodeRxFrame(frame, 0, rec, true));
+        return 0;
+    }
+
+    checkField(view.addr1(), 6, data, len);
+    checkField(view.addr2(), 6, data, len);
+    checkField(view.addr3(), 6, data, len);
+    checkField(view.addr4(), 6, data, len);
+
+    uint16_t seq;
+    if (view.seqCtrl(seq)) FUZZ_CHECK(len >= HDR_SEQ_OFFSET + 2);
+
+    uint16_t start = view.bodyOffset();
+    uint16_t bodyLen = view.bodyLength();
+    FUZZ_CHECK(bodyLen == 0 || start + bodyLen == len);
+    checkField(view.body(0, bodyLen), bodyLen, data, len);
+    checkField(view.body(0, BEACON_FIXED_LEN), BEACON_FIXED_LEN, data, len);
+
+    uint16_t reason = 0;
+    bool hasReason = view.reasonCode(reason);
+
+    // Both decode modes, the beacon IE walk included
+    for (int withBeacon = 0; withBeacon < 2; withBeacon++) {
+        RxFrame frame = {data, len, (PktType)(fcType(view.fc()) % 3), -50, 6, 1234};
+        WiFiEventData rec;
+        FUZZ_CHECK(decodeRxFrame(frame, 42, rec, withBeacon != 0));
+        FUZZ_CHECK(rec.frameControl == view.fc());
+        FUZZ_CHECK(memcmp(rec.receiver, view.addr1(), MAC_LEN) == 0);
+        FUZZ_CHECK(((rec.flags & RX_REC_TA) != 0) == (view.addr2() != nullptr));
+        FUZZ_CHECK(((rec.flags & RX_REC_REASON) != 0) == hasReason);
+        if (hasReason) FUZZ_CHECK(rec.reasonCode == reason);
+        FUZZ_CHECK(strlen(rec.ssid) < RX_SSID_LEN);
+        if (!withBeacon) FUZZ_CHECK(!(rec.flags & RX_REC_BEACON));
+
+        DeauthEvent ev;
+        if (deauthFromRecord(rec, ev)) FUZZ_CHECK(hasReason && ev.reasonCode == reason);
+    }
+    return 0;
+}
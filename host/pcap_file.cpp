@@ -0,0 +1,125 @@
+#include "pcap_file.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PCAP_MAGIC_US 0xA1B2C3D4
+#define PCAP_MAGIC_NS 0xA1B23C4D
+#define PCAP_LINKTYPE_RADIOTAP 127
+
+static uint32_t get32(const uint8_t* p, bool swap) {
+    uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    return swap ? __builtin_bswap32(v) : v;
+}
+
+static uint16_t le16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// Radiotap fields up to dBm antenna signal, in bit order: size, alignment
+static const uint8_t RADIOTAP_FIELDS[][2] = {
+    {8, 8},  // 0 TSFT
+    {1, 1},  // 1 Flags
+    {1, 1},  // 2 Rate
+    {4, 2},  // 3 Channel: frequency, flags
+    {2, 1},  // 4 FHSS
+    {1, 1},  // 5 dBm antenna signal
+};
+
+// Strips the radiotap header off one record. false if it's malformed.
+static bool parseRadiotap(const uint8_t* p, uint32_t len, PcapFrame& frame) {
+    if (len < 8 || p[0] != 0) return false;
+    uint16_t hdrLen = le16(p + 2);
+    if (hdrLen < 8 || hdrLen > len) return false;
+
+    // Present bitmaps chain through bit 31; fields start after the last one
+    uint32_t present = get32(p + 4, false);
+    uint32_t pos = 8;
+    for (uint32_t word = present; word & 0x80000000u; pos += 4) {
+        if (pos + 4 > hdrLen) return false;
+        word = get32(p + pos, false);
+    }
+
+    for (uint32_t bit = 0; bit < sizeof(RADIOTAP_FIELDS) / sizeof(RADIOTAP_FIELDS[0]); bit++) {
+        if (!(present & (1u << bit))) continue;
+        uint8_t size = RADIOTAP_FIELDS[bit][0];
+        uint8_t align = RADIOTAP_FIELDS[bit][1];
+        pos = (pos + align - 1) & ~(uint32_t)(align - 1);
+        if (pos + size > hdrLen) break;
+
+        if (bit == 3) {
+            uint16_t freq = le16(p + pos);
+            if (freq == 2484) frame.channel = 14;
+            else if (freq >= 2412 && freq < 2484) frame.channel = (uint8_t)((freq - 2407) / 5);
+        } else if (bit == 5) {
+            frame.rssi = (int8_t)p[pos];
+        }
+        pos += size;
+    }
+
+    frame.offset += hdrLen;
+    frame.len = (uint16_t)(len - hdrLen);
+    return true;
+}
+
+bool pcapLoad(const char* path, PcapCapture& out, std::string& err) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        err = std::string("can't open ") + path;
+        return false;
+    }
+
+    out.data.clear();
+    out.frames.clear();
+    uint8_t chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        out.data.insert(out.data.end(), chunk, chunk + n);
+    }
+    fclose(f);
+
+    const uint8_t* d = out.data.data();
+    size_t size = out.data.size();
+    if (size < 24) {
+        err = "too short for a pcap header";
+        return false;
+    }
+
+    uint32_t magic = get32(d, false);
+    bool swap = false;
+    bool nanos = false;
+    if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS) {
+        nanos = magic == PCAP_MAGIC_NS;
+    } else if (__builtin_bswap32(magic) == PCAP_MAGIC_US || __builtin_bswap32(magic) == PCAP_MAGIC_NS) {
+        swap = true;
+        nanos = __builtin_bswap32(magic) == PCAP_MAGIC_NS;
+    } else {
+        err = "not a pcap file (pcapng is not supported)";
+        return false;
+    }
+
+    out.linkType = get32(d + 20, swap) & 0x0FFFFFFF;
+    if (out.linkType != PCAP_LINKTYPE_IEEE802_11 && out.linkType != PCAP_LINKTYPE_RADIOTAP) {
+        err = "link type " + std::to_string(out.linkType) + " is not 802.11";
+        return false;
+    }
+
+    for (size_t pos = 24; pos + 16 <= size; ) {
+        uint32_t sec = get32(d + pos, swap);
+        uint32_t frac = get32(d + pos + 4, swap);
+        uint32_t capLen = get32(d + pos + 8, swap);
+        pos += 16;
+        if (capLen > size - pos) break;
+
+        PcapFrame frame;
+        frame.tsUs = (uint64_t)sec * 1000000 + (nanos ? frac / 1000 : frac);
+        frame.offset = (uint32_t)pos;
+        frame.len = (uint16_t)(capLen > 0xFFFF ? 0xFFFF : capLen);
+        frame.rssi = PCAP_DEFAULT_RSSI;
+        frame.channel = PCAP_DEFAULT_CHANNEL;
+        pos += capLen;
+
+        if (out.linkType == PCAP_LINKTYPE_RADIOTAP && !parseRadiotap(d + frame.offset, capLen, frame)) continue;
+        out.frames.push_back(frame);
+    }
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef PCAP_FILE_H
+#define PCAP_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// A .pcap capture loaded whole into memory, so replay loops time the
+// firmware and not the disk. Reads 802.11 captures with or without a
+// radiotap header (link types 105 and 127), microsecond or nanosecond
+// timestamps, either byte order: the PCAP Export stream after
+// tools/pcap_reader.py, or Wireshark/tcpdump monitor-mode captures.
+
+#define PCAP_LINKTYPE_IEEE802_11 105
+
+struct PcapFrame {
+    uint64_t tsUs;       // Capture time
+    uint32_t offset;     // 802.11 header onwards, into PcapCapture::data
+    uint16_t len;        // Captured bytes (FCS included when present)
+    int8_t rssi;         // From radiotap, else PCAP_DEFAULT_RSSI
+    uint8_t channel;     // From radiotap, else PCAP_DEFAULT_CHANNEL
+};
+
+#define PCAP_DEFAULT_RSSI -60
+#define PCAP_DEFAULT_CHANNEL 1
+
+struct PcapCapture {
+    uint32_t linkType;
+    std::vector<uint8_t> data;
+    std::vector<PcapFrame> frames;
+};
+
+// false with a message in err when the file can't be read or isn't an
+// 802.11 pcap. Records cut short by the end of the file are dropped.
+bool pcapLoad(const char* path, PcapCapture& out, std::string& err);
+
+#endif
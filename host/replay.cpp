@@ -0,0 +1,334 @@
+// Replays a .pcap through the firmware's capture path on a PC and reports
+// throughput, per-frame cost and the analyzers' view of it.
+//
+// By default the frames go through the real WiFiHandler: the sniffer and
+// the deauth detector are started as the UI would, rxTask runs on its own
+// thread, and every frame is handed to the registered promiscuous
+// callback as a wifi_promiscuous_pkt_t, behind the radio filter the
+// firmware programmed. millis() follows the capture's timestamps, so rate
+// windows see recorded time whatever the feed speed. --direct instead runs
+// decodeRxFrame and the same analyzers on one thread, without the queue:
+// the pipeline's own ceiling, and deterministic. Fed as fast as possible
+// the handler path outruns rxTask, which drains once per 1 ms tick as on
+// the device; the rx queue line shows what that drops.
+//
+// usage: wifi_replay [--realtime] [--direct] [--loops N] [--expect WHAT]... capture.pcap
+//   --realtime   feed at the recorded pace (default: as fast as possible)
+//   --direct     decode + analyzers inline, no WiFiHandler/rxTask
+//   --loops N    replay the capture N times back to back
+//   --expect     deauth, disassoc, beacon, twin or none; exit 1 unless seen
+//
+// The handler path also exits 1 if rxTask came within REPLAY_MIN_STACK_FREE
+// bytes of the end of its RX_TASK_STACK.
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include "host_platform.h"
+#include "pcap_file.h"
+#include "wifi_handler.h"
+#include "deauth_detector.h"
+
+#define REPLAY_START_MS 1000      // Virtual millis() of the first frame, clear of 0
+#define REPLAY_SETTLE_MS 300      // Virtual time added after the last frame so periodic publishes run
+#define REPLAY_MIN_STACK_FREE 2048 // WiFiRx stack left for the esp_wifi internals the shims don't run
+
+struct ReplayResult {
+    uint64_t fed;                 // Frames handed to the callback / decoder
+    uint64_t radioFiltered;       // Frames the programmed radio filter kept away
+    double feedSec;               // Wall time of the feed loop
+    uint64_t callbackNs;          // Spent inside the RX callback (handler path)
+    WiFiStats wifi;
+    DeauthStats deauth;
+    DeauthAnalytics analytics;
+    BeaconFloodStats beacons;
+    TwinStats twins;
+    PipelineStats pipeline;
+};
+
+static WiFiHandler wifi;
+
+static wifi_promiscuous_pkt_type_t frameClass(const uint8_t* p, uint16_t len) {
+    if (len == 0) return WIFI_PKT_MISC;
+    switch ((p[0] >> 2) & 0x03) {
+        case FC_TYPE_MGMT: return WIFI_PKT_MGMT;
+        case FC_TYPE_CTRL: return WIFI_PKT_CTRL;
+        case FC_TYPE_DATA: return WIFI_PKT_DATA;
+        default:           return WIFI_PKT_MISC;
+    }
+}
+
+static uint32_t virtualMs(const PcapCapture& cap, int loop, const PcapFrame& f) {
+    uint64_t span = cap.frames.back().tsUs - cap.frames.front().tsUs + 1000;
+    return REPLAY_START_MS + (uint32_t)((loop * span + f.tsUs - cap.frames.front().tsUs) / 1000);
+}
+
+static void settle(uint32_t nowMs) {
+    // rxTask drains every tick; give it a few, then let the clock run on
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    hostSetMillis(nowMs + REPLAY_SETTLE_MS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+// ==================== WiFiHandler PATH ====================
+
+static bool replayHandler(const PcapCapture& cap, int loops, bool realtime, ReplayResult& r) {
+    hostSetMillis(REPLAY_START_MS);
+    wifi.begin();
+    wifi.startSniffer();
+    wifi.startDeauthDetector();
+
+    // rxTask registers the callback once it runs
+    for (int i = 0; i < 1000 && hostPromiscuousCallback() == NULL; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (hostPromiscuousCallback() == NULL) {
+        fprintf(stderr, "wifi_replay: rxTask never enabled promiscuous mode\n");
+        return false;
+    }
+
+    alignas(wifi_promiscuous_pkt_t) static uint8_t buf[sizeof(wifi_promiscuous_pkt_t) + 4096];
+    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t nowMs = REPLAY_START_MS;
+    for (int loop = 0; loop < loops; loop++) {
+        for (const PcapFrame& f : cap.frames) {
+            nowMs = virtualMs(cap, loop, f);
+            if (realtime) {
+                std::this_thread::sleep_until(start + std::chrono::milliseconds(nowMs - REPLAY_START_MS));
+            }
+            hostSetMillis(nowMs);
+
+            uint16_t len = f.len > 4095 ? 4095 : f.len;
+            wifi_promiscuous_pkt_type_t type = frameClass(&cap.data[f.offset], len);
+            if (!hostRadioAccepts(type)) {
+                r.radioFiltered++;
+                continue;
+            }
+
+            memset(&pkt->rx_ctrl, 0, sizeof(pkt->rx_ctrl));
+            pkt->rx_ctrl.rssi = f.rssi;
+            pkt->rx_ctrl.channel = f.channel;
+            pkt->rx_ctrl.sig_len = len;
+            pkt->rx_ctrl.timestamp = (uint32_t)esp_timer_get_time();
+            memcpy(pkt->payload, &cap.data[f.offset], len);
+
+            wifi_promiscuous_cb_t cb = hostPromiscuousCallback();
+            int64_t t0 = esp_timer_get_time();
+            if (cb) cb(pkt, type);
+            r.callbackNs += (uint64_t)(esp_timer_get_time() - t0) * 1000;
+            r.fed++;
+        }
+    }
+    r.feedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    settle(nowMs);
+    r.wifi = wifi.getStats();
+    r.deauth = wifi.getDeauthStats();
+    r.analytics = wifi.getDeauthAnalytics();
+    r.beacons = wifi.getBeaconFloodStats();
+    r.twins = wifi.getTwinStats();
+    r.pipeline = wifi.getPipelineStats();
+
+    wifi.stop();
+    if (hostRunningTasks() != 0) {
+        fprintf(stderr, "wifi_replay: %d task(s) still running after stop()\n", hostRunningTasks());
+        return false;
+    }
+    return true;
+}
+
+// ==================== DIRECT PATH ====================
+
+static uint32_t clockUs() {
+    return (uint32_t)esp_timer_get_time();
+}
+
+static std::atomic<uint32_t> directChannelFrames[HOP_LAST_CHANNEL + 2];
+static RxPipeline directPipeline(clockUs);
+static TrafficAnalyzer directTraffic;
+static StationAnalyzer directStations;
+static SpectrogramAnalyzer directSpectro(directChannelFrames);
+static DeauthAnalyzer directDeauth;
+static BeaconFloodAnalyzer directBeacons;
+static TwinAnalyzer directTwins;
+
+static bool replayDirect(const PcapCapture& cap, int loops, ReplayResult& r) {
+    // Same registration as WiFiHandler::begin()
+    directPipeline.add(&directTraffic, RX_SLOTS_ALL);
+    directPipeline.add(&directStations, RX_SLOTS_ALL);
+    directPipeline.add(&directSpectro, 0);
+    directPipeline.add(&directDeauth, rxSlotBit(SLOT_DEAUTH) | rxSlotBit(SLOT_DISASSOC));
+    uint64_t beacons = rxSlotBit(SLOT_BEACON) | rxSlotBit(SLOT_PROBE_RESP);
+    directPipeline.add(&directBeacons, beacons);
+    directPipeline.add(&directTwins, beacons, beacons);
+    for (int i = 0; i < directPipeline.count(); i++) directPipeline.setEnabled(i, true);
+
+    static WiFiEventData batch[RX_BATCH_SIZE];
+    size_t n = 0;
+    uint32_t nowMs = REPLAY_START_MS;
+    uint32_t malformed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int loop = 0; loop < loops; loop++) {
+        for (const PcapFrame& f : cap.frames) {
+            nowMs = virtualMs(cap, loop, f);
+            RxFrame frame;
+            frame.payload = &cap.data[f.offset];
+            frame.len = f.len;
+            frame.type = (PktType)frameClass(frame.payload, f.len);
+            if (frame.type > PKT_CTRL) frame.type = PKT_CTRL;
+            frame.rssi = f.rssi;
+            frame.channel = f.channel;
+            frame.rxTimestamp = clockUs();
+            r.fed++;
+
+            FrameView view(frame.payload, frame.len);
+            if (!view.valid()) {
+                malformed++;
+                continue;
+            }
+            uint8_t slot = fcSlot(view.fc());
+            if (f.channel <= HOP_LAST_CHANNEL) {
+                directChannelFrames[f.channel].fetch_add(1, std::memory_order_relaxed);
+            }
+            if (!directPipeline.wants(slot)) continue;
+
+            decodeRxFrame(frame, nowMs, batch[n], directPipeline.wantsBody(slot));
+            if (++n == RX_BATCH_SIZE) {
+                directPipeline.dispatch(batch, n, nowMs);
+                directPipeline.idle(nowMs);
+                n = 0;
+            }
+        }
+    }
+    if (n > 0) directPipeline.dispatch(batch, n, nowMs);
+    directPipeline.idle(nowMs);
+    r.feedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    directPipeline.idle(nowMs + REPLAY_SETTLE_MS);
+    directTraffic.readStats(r.wifi);
+    directDeauth.readStats(r.deauth);
+    directDeauth.readAnalytics(r.analytics);
+    directBeacons.readStats(r.beacons);
+    directTwins.readStats(r.twins);
+    r.pipeline.rxMalformed = malformed;
+    r.pipeline.analyzerCount = directPipeline.count();
+    for (int i = 0; i < directPipeline.count(); i++) directPipeline.getStats(i, r.pipeline.analyzers[i]);
+    return true;
+}
+
+// ==================== REPORT ====================
+
+static void printMac(const char* label, const uint8_t* mac) {
+    printf("%s%02X:%02X:%02X:%02X:%02X:%02X\n", label, mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+}
+
+static void report(const ReplayResult& r, bool direct) {
+    printf("path              %s\n", direct ? "direct (decodeRxFrame + analyzers)" : "WiFiHandler (rxCallback -> rxTask)");
+    printf("frames fed        %llu (%llu kept out by the radio filter)\n",
+           (unsigned long long)r.fed, (unsigned long long)r.radioFiltered);
+    printf("feed time         %.3f s\n", r.feedSec);
+    if (r.feedSec > 0) printf("throughput        %.0f frames/s\n", r.fed / r.feedSec);
+    if (!direct && r.fed > 0) printf("callback          %llu ns/frame\n", (unsigned long long)(r.callbackNs / r.fed));
+    if (direct && r.fed > 0) printf("decode+analyze    %.0f ns/frame\n", r.feedSec * 1e9 / r.fed);
+
+    const PipelineStats& p = r.pipeline;
+    if (!direct) {
+        printf("rx queue          %u queued, %u dropped, high water %u/%u, latency avg %u us max %u us\n",
+               p.rx.enqueued, p.rx.dropped, p.rx.highWater, p.rx.capacity, p.rx.latencyAvgUs, p.rx.latencyMaxUs);
+        printf("rx task stack     %u of %u bytes never touched (x86-64 frames)\n", p.rxStackFree, RX_TASK_STACK);
+    }
+    printf("malformed         %u\n", p.rxMalformed);
+    for (int i = 0; i < p.analyzerCount; i++) {
+        const AnalyzerStats& a = p.analyzers[i];
+        printf("  %-10s %s %8u frames %6u ns/frame, longest pass %u us\n",
+               a.name, a.enabled ? "on " : "off", a.frames, a.nsPerFrame, a.maxPassUs);
+    }
+
+    printf("WiFiStats         %u packets: %u mgmt, %u data, %u ctrl, rssi %d dBm\n",
+           r.wifi.packetCount, r.wifi.mgmtCount, r.wifi.dataCount, r.wifi.ctrlCount, r.wifi.rssi);
+    printf("DeauthStats       %u deauths (%u broadcast), %u disassocs, peak %u/s, %u alerts, attack %s, disassoc flood %s\n",
+           r.deauth.totalDeauths, r.deauth.broadcastDeauths, r.deauth.disassocCount, r.deauth.peakRate,
+           r.deauth.suspiciousCount, r.deauth.attackDetected ? "yes" : "no", r.deauth.disassocFlood ? "yes" : "no");
+    if (r.deauth.attackDetected) printMac("  suspicious AP   ", r.deauth.suspiciousAP);
+    printf("  reasons        ");
+    for (int i = 0; i < DEAUTH_REASON_BUCKETS; i++) {
+        if (r.analytics.reasons[i]) printf(" %d(%s)x%u", i, reasonCodeName(i), r.analytics.reasons[i]);
+    }
+    printf("\n");
+    printf("BeaconFloodStats  %u frames, peak %u BSSIDs/s, flood %s\n",
+           r.beacons.frames, r.beacons.peakBssidsPerSec, r.beacons.lastDetectionTime ? "yes" : "no");
+    printf("TwinStats         %u SSIDs, %u conflicts\n", r.twins.ssidsTracked, r.twins.conflicts);
+    for (int i = 0; i < r.twins.recentCount; i++) {
+        printf("  twin            \"%s\" ch %u -> ch %u\n", r.twins.recent[i].ssid,
+               r.twins.recent[i].knownChannel, r.twins.recent[i].twinChannel);
+    }
+}
+
+static bool seen(const ReplayResult& r, const char* what) {
+    if (!strcmp(what, "deauth")) return r.deauth.suspiciousCount > 0;
+    if (!strcmp(what, "disassoc")) return r.deauth.lastDisassocTime != 0;
+    if (!strcmp(what, "beacon")) return r.beacons.lastDetectionTime != 0;
+    if (!strcmp(what, "twin")) return r.twins.conflicts > 0;
+    if (!strcmp(what, "none")) {
+        return !seen(r, "deauth") && !seen(r, "disassoc") && !seen(r, "beacon") && !seen(r, "twin");
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    bool realtime = false;
+    bool direct = false;
+    int loops = 1;
+    const char* path = NULL;
+    const char* expect[8];
+    int expectCount = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--realtime")) realtime = true;
+        else if (!strcmp(argv[i], "--direct")) direct = true;
+        else if (!strcmp(argv[i], "--loops") && i + 1 < argc) loops = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--expect") && i + 1 < argc && expectCount < 8) expect[expectCount++] = argv[++i];
+        else if (argv[i][0] != '-' && path == NULL) path = argv[i];
+        else path = NULL, i = argc;
+    }
+    if (path == NULL || loops < 1 || (realtime && direct)) {
+        fprintf(stderr, "usage: wifi_replay [--realtime] [--direct] [--loops N] [--expect WHAT]... capture.pcap\n");
+        return 2;
+    }
+
+    PcapCapture cap;
+    std::string err;
+    if (!pcapLoad(path, cap, err)) {
+        fprintf(stderr, "wifi_replay: %s: %s\n", path, err.c_str());
+        return 2;
+    }
+    if (cap.frames.empty()) {
+        fprintf(stderr, "wifi_replay: %s: no frames\n", path);
+        return 2;
+    }
+
+    static ReplayResult r;
+    bool ok = direct ? replayDirect(cap, loops, r) : replayHandler(cap, loops, realtime, r);
+    if (!ok) return 1;
+    report(r, direct);
+
+    int failed = 0;
+    for (int i = 0; i < expectCount; i++) {
+        if (!seen(r, expect[i])) {
+            fprintf(stderr, "wifi_replay: expected %s, not seen\n", expect[i]);
+            failed++;
+        }
+    }
+    if (!direct && r.pipeline.rxStackFree < REPLAY_MIN_STACK_FREE) {
+        fprintf(stderr, "wifi_replay: rxTask left only %u of %u stack bytes untouched, want %u\n",
+                r.pipeline.rxStackFree, RX_TASK_STACK, REPLAY_MIN_STACK_FREE);
+        failed++;
+    }
+    return failed ? 1 : 0;
+}
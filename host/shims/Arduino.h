@@ -0,0 +1,73 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Host stand-in for the subset of the ESP32 Arduino core the firmware's
+// capture path uses. Just enough to compile main/ unchanged on a PC; the
+// definitions live in host_platform.cpp.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+#include "freertos/FreeRTOS.h"
+
+using std::min;
+using std::max;
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+void* ps_malloc(size_t size);
+bool psramFound();
+
+// Arduino's heap string, backed by std::string
+class String {
+public:
+    String(const char* s = "") : s(s ? s : "") {}
+    String(const std::string& str) : s(str) {}
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned length() const { return (unsigned)s.size(); }
+
+    void toLowerCase() {
+        for (char& c : s) c = (char)tolower((unsigned char)c);
+    }
+    int indexOf(const char* needle) const {
+        size_t at = s.find(needle);
+        return at == std::string::npos ? -1 : (int)at;
+    }
+
+private:
+    std::string s;
+};
+
+// Console / PCAP export port. Bytes written are counted, not printed.
+class HardwareSerial {
+public:
+    HardwareSerial() : baud(115200), written(0) {}
+
+    void begin(unsigned long b) { baud = (uint32_t)b; }
+    size_t write(const uint8_t* data, size_t len) { (void)data; written += len; return len; }
+    size_t write(uint8_t c) { (void)c; written++; return 1; }
+    void flush() {}
+    void updateBaudRate(unsigned long b) { baud = (uint32_t)b; }
+    uint32_t baudRate() { return baud; }
+
+    uint64_t bytesWritten() const { return written; }
+
+private:
+    uint32_t baud;
+    uint64_t written;
+};
+
+extern HardwareSerial Serial;
+
+#endif
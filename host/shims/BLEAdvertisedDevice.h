@@ -0,0 +1,6 @@
+#ifndef HOST_BLE_ADVERTISED_DEVICE_H
+#define HOST_BLE_ADVERTISED_DEVICE_H
+
+#include "BLEDevice.h"
+
+#endif
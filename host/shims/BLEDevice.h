@@ -0,0 +1,117 @@
+#ifndef HOST_BLE_DEVICE_H
+#define HOST_BLE_DEVICE_H
+
+// The slice of the ESP32 Arduino BLE library bt_handler.cpp uses, with
+// the same signatures. There is no radio: a scan only registers its
+// callbacks, and drivers hand advertisements to them themselves (see
+// hostBleScanCallbacks). BLEAdvertisedDevice is copied by value as on the
+// device, std::string members included; its setters are public here so a
+// driver can fill one in, and setPayload keeps the caller's buffer rather
+// than a copy. BLEUtils.h, BLEScan.h and BLEAdvertisedDevice.h all land
+// here.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include "Arduino.h"
+
+typedef uint8_t esp_bd_addr_t[6];
+
+typedef enum {
+    BLE_ADDR_TYPE_PUBLIC = 0,
+    BLE_ADDR_TYPE_RANDOM,
+    BLE_ADDR_TYPE_RPA_PUBLIC,
+    BLE_ADDR_TYPE_RPA_RANDOM,
+} esp_ble_addr_type_t;
+
+class BLEAddress {
+public:
+    BLEAddress() { memset(address, 0, sizeof(address)); }
+    explicit BLEAddress(const esp_bd_addr_t addr) { memcpy(address, addr, sizeof(address)); }
+
+    esp_bd_addr_t* getNative() { return &address; }
+    bool equals(const BLEAddress& other) const { return !memcmp(address, other.address, sizeof(address)); }
+    std::string toString() const;   // "aa:bb:cc:dd:ee:ff", a fresh std::string per call
+
+private:
+    esp_bd_addr_t address;
+};
+
+class BLEAdvertisedDevice {
+public:
+    BLEAdvertisedDevice();
+
+    BLEAddress getAddress() { return address; }
+    esp_ble_addr_type_t getAddressType() { return addressType; }
+    int getRSSI() { return rssi; }
+    bool haveRSSI() { return hasRssi; }
+    std::string getName() { return name; }
+    bool haveName() { return hasName; }
+    std::string getManufacturerData() { return manufacturerData; }
+    bool haveManufacturerData() { return hasManufacturerData; }
+    bool haveServiceUUID() { return false; }
+    uint8_t* getPayload() { return payload; }
+    size_t getPayloadLength() { return payloadLength; }
+
+    void setAddress(BLEAddress addr) { address = addr; }
+    void setAddressType(esp_ble_addr_type_t type) { addressType = type; }
+    void setRSSI(int value) { rssi = value; hasRssi = true; }
+    void setName(const std::string& value) { name = value; hasName = true; }
+    void setManufacturerData(const std::string& value) { manufacturerData = value; hasManufacturerData = true; }
+    void setPayload(uint8_t* data, size_t len) { payload = data; payloadLength = len; }
+
+private:
+    BLEAddress address;
+    esp_ble_addr_type_t addressType;
+    int rssi;
+    bool hasRssi;
+    std::string name;
+    bool hasName;
+    std::string manufacturerData;
+    bool hasManufacturerData;
+    uint8_t* payload;
+    size_t payloadLength;
+};
+
+class BLEAdvertisedDeviceCallbacks {
+public:
+    virtual ~BLEAdvertisedDeviceCallbacks() {}
+    virtual void onResult(BLEAdvertisedDevice advertisedDevice) = 0;
+};
+
+class BLEScan {
+public:
+    void setAdvertisedDeviceCallbacks(BLEAdvertisedDeviceCallbacks* callbacks,
+                                      bool wantDuplicates = false, bool shouldParse = true);
+    void setActiveScan(bool active) { (void)active; }
+    void setInterval(uint16_t intervalMs) { (void)intervalMs; }
+    void setWindow(uint16_t windowMs) { (void)windowMs; }
+    bool start(uint32_t duration, bool isContinue = false);
+    void stop();
+    void clearResults() {}
+};
+
+class BLEAdvertisementData {
+public:
+    void setName(const std::string& name) { (void)name; }
+    void setAppearance(uint16_t appearance) { (void)appearance; }
+    void setFlags(uint8_t flags) { (void)flags; }
+};
+
+class BLEAdvertising {
+public:
+    void setAdvertisementData(BLEAdvertisementData& data) { (void)data; }
+    void setScanResponseData(BLEAdvertisementData& data) { (void)data; }
+    void start() {}
+    void stop() {}
+};
+
+class BLEDevice {
+public:
+    static void init(const std::string& deviceName) { (void)deviceName; }
+    static void deinit(bool releaseMemory = false) { (void)releaseMemory; }
+    static BLEScan* getScan();
+    static BLEAdvertising* getAdvertising();
+};
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef HOST_BLE_SCAN_H
+#define HOST_BLE_SCAN_H
+
+#include "BLEDevice.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef HOST_BLE_UTILS_H
+#define HOST_BLE_UTILS_H
+
+#include "BLEDevice.h"
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+// Station-mode WiFi object. There is no radio on the host: scans finish
+// at once with no networks.
+
+#include "Arduino.h"
+#include "esp_wifi.h"
+
+#define WIFI_STA 1
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+class WiFiClass {
+public:
+    void mode(int m) { (void)m; }
+    void disconnect() {}
+
+    int16_t scanNetworks(bool async = false, bool showHidden = false, bool passive = false,
+                         uint32_t maxMsPerChan = 300, uint8_t channel = 0,
+                         const char* ssid = nullptr, const uint8_t* bssid = nullptr);
+    void scanDelete() {}
+
+    String SSID(int i) { (void)i; return String(); }
+    int32_t RSSI(int i) { (void)i; return 0; }
+    int32_t channel(int i) { (void)i; return 0; }
+    wifi_auth_mode_t encryptionType(int i) { (void)i; return WIFI_AUTH_OPEN; }
+    uint8_t* BSSID(int i) { (void)i; return noBssid; }
+
+private:
+    uint8_t noBssid[6] = {};
+};
+
+extern WiFiClass WiFi;
+
+#endif
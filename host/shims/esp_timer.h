@@ -0,0 +1,10 @@
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+// Microseconds since start, always real (monotonic) time: the firmware
+// uses it to cost analyzers and to age queued frames
+int64_t esp_timer_get_time();
+
+#endif
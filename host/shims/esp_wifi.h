@@ -0,0 +1,105 @@
+#ifndef HOST_ESP_WIFI_H
+#define HOST_ESP_WIFI_H
+
+// esp_wifi promiscuous API as the firmware uses it. Nothing is received
+// on its own: host_platform.h hands the registered RX callback to a
+// driver, which feeds it frames (see host/replay.cpp).
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+typedef enum {
+    WIFI_PKT_MGMT,
+    WIFI_PKT_CTRL,
+    WIFI_PKT_DATA,
+    WIFI_PKT_MISC
+} wifi_promiscuous_pkt_type_t;
+
+// Same layout as ESP-IDF's rx_ctrl (ESP32)
+typedef struct {
+    signed rssi:8;
+    unsigned rate:5;
+    unsigned :1;
+    unsigned sig_mode:2;
+    unsigned :16;
+    unsigned mcs:7;
+    unsigned cwb:1;
+    unsigned :16;
+    unsigned smoothing:1;
+    unsigned not_sounding:1;
+    unsigned :1;
+    unsigned aggregation:1;
+    unsigned stbc:2;
+    unsigned fec_coding:1;
+    unsigned sgi:1;
+    signed noise_floor:8;
+    unsigned ampdu_cnt:8;
+    unsigned channel:4;
+    unsigned secondary_channel:4;
+    unsigned :8;
+    unsigned timestamp:32;
+    unsigned :32;
+    unsigned :31;
+    unsigned ant:1;
+    unsigned sig_len:12;
+    unsigned :12;
+    unsigned rx_state:8;
+} wifi_pkt_rx_ctrl_t;
+
+typedef struct {
+    wifi_pkt_rx_ctrl_t rx_ctrl;
+    uint8_t payload[0];
+} wifi_promiscuous_pkt_t;
+
+typedef struct {
+    uint32_t filter_mask;
+} wifi_promiscuous_filter_t;
+
+#define WIFI_PROMIS_FILTER_MASK_ALL         0xFFFFFFFF
+#define WIFI_PROMIS_FILTER_MASK_MGMT        (1)
+#define WIFI_PROMIS_FILTER_MASK_CTRL        (1 << 1)
+#define WIFI_PROMIS_FILTER_MASK_DATA        (1 << 2)
+#define WIFI_PROMIS_FILTER_MASK_MISC        (1 << 3)
+#define WIFI_PROMIS_FILTER_MASK_DATA_MPDU   (1 << 4)
+#define WIFI_PROMIS_FILTER_MASK_DATA_AMPDU  (1 << 5)
+#define WIFI_PROMIS_FILTER_MASK_FCSFAIL     (1 << 6)
+
+#define WIFI_PROMIS_CTRL_FILTER_MASK_ALL        0xFF800000
+#define WIFI_PROMIS_CTRL_FILTER_MASK_WRAPPER    (1 << 23)
+#define WIFI_PROMIS_CTRL_FILTER_MASK_BAR        (1 << 24)
+#define WIFI_PROMIS_CTRL_FILTER_MASK_BA         (1 << 25)
+#define WIFI_PROMIS_CTRL_FILTER_MASK_PSPOLL     (1 << 26)
+#define WIFI_PROMIS_CTRL_FILTER_MASK_RTS        (1 << 27)
+#define WIFI_PROMIS_CTRL_FILTER_MASK_CTS        (1 << 28)
+#define WIFI_PROMIS_CTRL_FILTER_MASK_ACK        (1 << 29)
+#define WIFI_PROMIS_CTRL_FILTER_MASK_CFEND      (1 << 30)
+#define WIFI_PROMIS_CTRL_FILTER_MASK_CFENDACK   (1u << 31)
+
+typedef enum { WIFI_SECOND_CHAN_NONE, WIFI_SECOND_CHAN_ABOVE, WIFI_SECOND_CHAN_BELOW } wifi_second_chan_t;
+typedef enum { WIFI_IF_STA, WIFI_IF_AP } wifi_interface_t;
+
+typedef enum {
+    WIFI_AUTH_OPEN,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+    WIFI_AUTH_WPA2_ENTERPRISE,
+    WIFI_AUTH_WPA3_PSK,
+    WIFI_AUTH_WPA2_WPA3_PSK,
+    WIFI_AUTH_WAPI_PSK,
+    WIFI_AUTH_MAX
+} wifi_auth_mode_t;
+
+typedef void (*wifi_promiscuous_cb_t)(void* buf, wifi_promiscuous_pkt_type_t type);
+
+esp_err_t esp_wifi_set_promiscuous(bool enable);
+esp_err_t esp_wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb);
+esp_err_t esp_wifi_set_promiscuous_filter(const wifi_promiscuous_filter_t* filter);
+esp_err_t esp_wifi_set_promiscuous_ctrl_filter(const wifi_promiscuous_filter_t* filter);
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second);
+esp_err_t esp_wifi_80211_tx(wifi_interface_t ifx, const void* buffer, int len, bool en_sys_seq);
+
+#endif
@@ -0,0 +1,268 @@
+#include "Arduino.h"
+#include "WiFi.h"
+#include "BLEDevice.h"
+#include "esp_wifi.h"
+#include "esp_timer.h"
+#include "host_platform.h"
+#include <alloca.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+HardwareSerial Serial;
+WiFiClass WiFi;
+
+// ==================== CLOCKS ====================
+
+static int64_t realUs() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+static std::atomic<int64_t> virtualMs(-1);
+
+void hostSetMillis(uint32_t ms) {
+    virtualMs.store(ms, std::memory_order_relaxed);
+}
+
+unsigned long millis() {
+    int64_t v = virtualMs.load(std::memory_order_relaxed);
+    return (uint32_t)(v >= 0 ? v : realUs() / 1000);
+}
+
+unsigned long micros() {
+    return (uint32_t)realUs();
+}
+
+int64_t esp_timer_get_time() {
+    return realUs();
+}
+
+void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void* ps_malloc(size_t size) {
+    return malloc(size);
+}
+
+bool psramFound() {
+    return false;
+}
+
+// ==================== TASKS ====================
+
+struct HostTask {
+    TaskFunction_t fn;
+    void* arg;
+    const char* name;
+    uint32_t stackDepth;
+    const volatile uint8_t* stackLow;   // Bottom of the painted stack budget
+};
+
+// Thrown by vTaskDelete(NULL) to unwind the calling task's thread
+struct HostTaskExit {};
+
+static std::mutex taskLock;
+static std::vector<std::unique_ptr<HostTask>> tasks; // Kept for the process lifetime
+static std::atomic<int> runningTasks(0);
+static thread_local HostTask* currentTask = nullptr;
+
+#define STACK_PAINT 0xA5   // FreeRTOS's tskSTACK_FILL_BYTE
+
+// Fill the stackDepth bytes the task's frames will grow into, as FreeRTOS
+// fills a new task's stack, so uxTaskGetStackHighWaterMark can measure
+__attribute__((noinline)) static void paintStack(HostTask* task) {
+    volatile uint8_t* area = (volatile uint8_t*)alloca(task->stackDepth);
+    for (uint32_t i = 0; i < task->stackDepth; i++) area[i] = STACK_PAINT;
+    task->stackLow = area;
+}
+
+static void runTask(HostTask* task) {
+    currentTask = task;
+    paintStack(task);
+    try {
+        task->fn(task->arg);
+    } catch (const HostTaskExit&) {
+    }
+    runningTasks.fetch_sub(1);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    (void)priority; (void)core;
+
+    HostTask* task = new HostTask{fn, arg, name, stackDepth, nullptr};
+    {
+        std::lock_guard<std::mutex> guard(taskLock);
+        tasks.emplace_back(task);
+    }
+
+    // Handle first: the task may clear it before this returns
+    if (handle) *handle = task;
+    runningTasks.fetch_add(1);
+    std::thread(runTask, task).detach();
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task == NULL || task == currentTask) throw HostTaskExit();
+
+    fprintf(stderr, "host: vTaskDelete(\"%s\") while it runs, the task is stuck\n",
+            ((HostTask*)task)->name);
+    abort();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t handle) {
+    HostTask* task = handle ? (HostTask*)handle : currentTask;
+    if (task == nullptr || task->stackLow == nullptr) return 0;
+
+    UBaseType_t untouched = 0;
+    while (untouched < task->stackDepth && task->stackLow[untouched] == STACK_PAINT) untouched++;
+    return untouched;
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)(realUs() / 1000);
+}
+
+int hostRunningTasks() {
+    return runningTasks.load();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new std::timed_mutex();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    std::timed_mutex* m = (std::timed_mutex*)sem;
+    if (ticks == portMAX_DELAY) {
+        m->lock();
+        return pdTRUE;
+    }
+    return m->try_lock_for(std::chrono::milliseconds(ticks)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    ((std::timed_mutex*)sem)->unlock();
+    return pdTRUE;
+}
+
+// ==================== RADIO ====================
+
+static std::atomic<bool> promiscuous(false);
+static std::atomic<wifi_promiscuous_cb_t> rxCallback(nullptr);
+static std::atomic<uint32_t> radioFilter(WIFI_PROMIS_FILTER_MASK_ALL);
+static std::atomic<uint8_t> radioChannel(1);
+
+esp_err_t esp_wifi_set_promiscuous(bool enable) {
+    promiscuous.store(enable);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb) {
+    rxCallback.store(cb);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous_filter(const wifi_promiscuous_filter_t* filter) {
+    radioFilter.store(filter->filter_mask);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous_ctrl_filter(const wifi_promiscuous_filter_t* filter) {
+    (void)filter;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second) {
+    (void)second;
+    radioChannel.store(primary);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_80211_tx(wifi_interface_t ifx, const void* buffer, int len, bool en_sys_seq) {
+    (void)ifx; (void)buffer; (void)len; (void)en_sys_seq;
+    return ESP_OK;
+}
+
+wifi_promiscuous_cb_t hostPromiscuousCallback() {
+    return promiscuous.load() ? rxCallback.load() : nullptr;
+}
+
+bool hostRadioAccepts(wifi_promiscuous_pkt_type_t type) {
+    uint32_t bit;
+    switch (type) {
+        case WIFI_PKT_MGMT: bit = WIFI_PROMIS_FILTER_MASK_MGMT; break;
+        case WIFI_PKT_CTRL: bit = WIFI_PROMIS_FILTER_MASK_CTRL; break;
+        case WIFI_PKT_DATA: bit = WIFI_PROMIS_FILTER_MASK_DATA; break;
+        default:            bit = WIFI_PROMIS_FILTER_MASK_MISC; break;
+    }
+    return (radioFilter.load() & bit) != 0;
+}
+
+uint8_t hostRadioChannel() {
+    return radioChannel.load();
+}
+
+int16_t WiFiClass::scanNetworks(bool async, bool showHidden, bool passive, uint32_t maxMsPerChan,
+                                uint8_t channel, const char* ssid, const uint8_t* bssid) {
+    (void)async; (void)showHidden; (void)passive; (void)maxMsPerChan;
+    (void)channel; (void)ssid; (void)bssid;
+    return 0;
+}
+
+// ==================== BLE ====================
+
+static BLEScan bleScan;
+static BLEAdvertising bleAdvertising;
+static std::atomic<BLEAdvertisedDeviceCallbacks*> scanCallbacks(nullptr);
+static std::atomic<bool> scanning(false);
+
+std::string BLEAddress::toString() const {
+    char text[18];
+    snprintf(text, sizeof(text), "%02x:%02x:%02x:%02x:%02x:%02x",
+             address[0], address[1], address[2], address[3], address[4], address[5]);
+    return std::string(text);
+}
+
+BLEAdvertisedDevice::BLEAdvertisedDevice()
+    : addressType(BLE_ADDR_TYPE_PUBLIC), rssi(0), hasRssi(false), hasName(false),
+      hasManufacturerData(false), payload(nullptr), payloadLength(0) {}
+
+void BLEScan::setAdvertisedDeviceCallbacks(BLEAdvertisedDeviceCallbacks* callbacks,
+                                           bool wantDuplicates, bool shouldParse) {
+    (void)wantDuplicates; (void)shouldParse;
+    scanCallbacks.store(callbacks);
+}
+
+bool BLEScan::start(uint32_t duration, bool isContinue) {
+    (void)duration; (void)isContinue;
+    scanning.store(true);
+    return true;
+}
+
+void BLEScan::stop() {
+    scanning.store(false);
+}
+
+BLEScan* BLEDevice::getScan() {
+    return &bleScan;
+}
+
+BLEAdvertising* BLEDevice::getAdvertising() {
+    return &bleAdvertising;
+}
+
+BLEAdvertisedDeviceCallbacks* hostBleScanCallbacks() {
+    return scanning.load() ? scanCallbacks.load() : nullptr;
+}
@@ -0,0 +1,33 @@
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+
+#include <stdint.h>
+#include "esp_wifi.h"
+
+// Controls for the host shims, used by drivers and tests (never by main/).
+
+// Pins millis() to ms from now on, e.g. to a capture's timestamps so the
+// detectors' time windows see recorded time even when frames are fed
+// faster. Until the first call millis() runs on the real clock.
+void hostSetMillis(uint32_t ms);
+
+// The RX callback esp_wifi_set_promiscuous_rx_cb registered, NULL while
+// promiscuous mode is off
+wifi_promiscuous_cb_t hostPromiscuousCallback();
+
+// Would the radio, with the filter the firmware programmed, hand a frame
+// of this class to the callback at all
+bool hostRadioAccepts(wifi_promiscuous_pkt_type_t type);
+
+// Channel last set with esp_wifi_set_channel
+uint8_t hostRadioChannel();
+
+// Tasks started and not yet ended
+int hostRunningTasks();
+
+// Callbacks of the running BLE scan, NULL while none runs. Drivers call
+// onResult() on them as the BLE host task would.
+class BLEAdvertisedDeviceCallbacks;
+BLEAdvertisedDeviceCallbacks* hostBleScanCallbacks();
+
+#endif
@@ -0,0 +1,234 @@
+// Writes a synthetic monitor-mode capture for the replay tests and
+// benchmarks, through the firmware's own pcap encoder (pcap_stream.h), so
+// it reads back exactly like a PCAP Export from the device.
+//
+// Three APs beacon on channels 1/6/11 while their stations exchange data
+// and ACKs; every 500 ms a truncated frame goes by. Unless --clean, the
+// attacks follow, one after the other: a deauth burst (broadcast and
+// aimed at one client), a disassociation flood, a beacon flood from
+// random BSSIDs and an open evil twin of the first AP.
+//
+// usage: synth_pcap [--clean] [--seconds S] [--rate FPS] out.pcap
+
+#include "pcap_stream.h"
+#include "ieee80211.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+struct SynthFrame {
+    uint64_t tsUs;
+    uint8_t channel;
+    int8_t rssi;
+    std::vector<uint8_t> bytes;
+};
+
+struct Ap {
+    uint8_t bssid[6];
+    const char* ssid;
+    uint8_t channel;
+    bool rsn;
+};
+
+static const Ap APS[] = {
+    {{0x10, 0x20, 0x30, 0x00, 0x00, 0x01}, "HomeNet", 1, true},
+    {{0x24, 0x0A, 0xC4, 0x00, 0x00, 0x02}, "Cafe", 6, false},
+    {{0xB8, 0x27, 0xEB, 0x00, 0x00, 0x03}, "Office", 11, true},
+};
+#define AP_COUNT (sizeof(APS) / sizeof(APS[0]))
+
+static const uint8_t BROADCAST[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static const uint8_t VICTIM[6] = {0x3C, 0x5A, 0xB4, 0x11, 0x22, 0x33};
+static const uint8_t TWIN_BSSID[6] = {0x40, 0xB4, 0xCD, 0x66, 0x66, 0x66};
+
+static uint32_t rngState = 0x9E3779B9;
+
+static uint32_t rng() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint32_t crc32(const uint8_t* p, size_t len) {
+    uint32_t c = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        c ^= p[i];
+        for (int k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320 & (0 - (c & 1)));
+    }
+    return ~c;
+}
+
+static std::vector<SynthFrame> frames;
+static uint16_t seq;
+
+static void header(std::vector<uint8_t>& f, uint8_t fc0, uint8_t fc1,
+                   const uint8_t* a1, const uint8_t* a2, const uint8_t* a3) {
+    f.push_back(fc0);
+    f.push_back(fc1);
+    f.push_back(0x3A);
+    f.push_back(0x01);
+    f.insert(f.end(), a1, a1 + 6);
+    f.insert(f.end(), a2, a2 + 6);
+    f.insert(f.end(), a3, a3 + 6);
+    seq += 16;
+    f.push_back(seq & 0xFF);
+    f.push_back(seq >> 8);
+}
+
+static void emit(uint64_t tsUs, uint8_t channel, int8_t rssi, std::vector<uint8_t>& f, bool fcs = true) {
+    if (fcs) {
+        uint32_t c = crc32(f.data(), f.size());
+        for (int i = 0; i < 4; i++) f.push_back((c >> (8 * i)) & 0xFF);
+    }
+    frames.push_back({tsUs, channel, rssi, f});
+}
+
+static void ie(std::vector<uint8_t>& f, uint8_t id, const void* v, uint8_t len) {
+    f.push_back(id);
+    f.push_back(len);
+    f.insert(f.end(), (const uint8_t*)v, (const uint8_t*)v + len);
+}
+
+static void beacon(uint64_t tsUs, const uint8_t* bssid, const char* ssid, uint8_t channel, bool rsn, int8_t rssi) {
+    std::vector<uint8_t> f;
+    header(f, (FC_MGMT_BEACON << 4), 0, BROADCAST, bssid, bssid);
+    for (int i = 0; i < 8; i++) f.push_back((tsUs >> (8 * i)) & 0xFF);
+    f.push_back(0x64);                    // Interval, 100 TU
+    f.push_back(0x00);
+    f.push_back(rsn ? 0x01 | CAP_PRIVACY : 0x01); // ESS, privacy
+    f.push_back(0x04);
+
+    static const uint8_t rates[] = {0x82, 0x84, 0x8B, 0x96, 0x0C, 0x12, 0x18, 0x24};
+    static const uint8_t rsnIe[] = {0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04, 0x01, 0x00, 0x00, 0x0F, 0xAC,
+                                    0x04, 0x01, 0x00, 0x00, 0x0F, 0xAC, 0x02, 0x00, 0x00};
+    ie(f, IE_SSID, ssid, (uint8_t)strlen(ssid));
+    ie(f, 1, rates, sizeof(rates));
+    ie(f, IE_DS_PARAMS, &channel, 1);
+    if (rsn) ie(f, IE_RSN, rsnIe, sizeof(rsnIe));
+    emit(tsUs, channel, rssi, f);
+}
+
+static void teardown(uint64_t tsUs, uint8_t subtype, const uint8_t* from, const uint8_t* to, uint16_t reason, uint8_t channel) {
+    std::vector<uint8_t> f;
+    header(f, (uint8_t)(subtype << 4), 0, to, from, from);
+    f.push_back(reason & 0xFF);
+    f.push_back(reason >> 8);
+    emit(tsUs, channel, -45, f);
+}
+
+// QoS data from a station to its AP, then the AP's ACK
+static void dataExchange(uint64_t tsUs, const Ap& ap, uint8_t station) {
+    uint8_t sta[6] = {0x3C, 0x5A, 0xB4, 0x00, (uint8_t)(ap.channel), station};
+    std::vector<uint8_t> f;
+    header(f, (FC_TYPE_DATA << 2) | (FC_DATA_QOS_DATA << 4), FC_FLAG_TO_DS >> 8, ap.bssid, sta, BROADCAST);
+    f.push_back(0x00);                    // QoS control
+    f.push_back(0x00);
+    uint16_t body = 40 + rng() % 120;
+    for (uint16_t i = 0; i < body; i++) f.push_back((uint8_t)rng());
+    emit(tsUs, ap.channel, (int8_t)(-50 - (int)(rng() % 30)), f);
+
+    std::vector<uint8_t> ack;
+    ack.push_back((FC_TYPE_CTRL << 2) | (FC_CTRL_ACK << 4));
+    ack.push_back(0);
+    ack.push_back(0);
+    ack.push_back(0);
+    ack.insert(ack.end(), sta, sta + 6);
+    emit(tsUs + 40, ap.channel, -40, ack);
+}
+
+static bool writeCapture(const char* path) {
+    FILE* out = fopen(path, "wb");
+    if (out == NULL) return false;
+
+    // The firmware encoder frames every piece for the serial link; a file
+    // wants just the pcap bytes in between
+    static uint8_t buf[PCAP_FRAME_MAX];
+    size_t n = pcapEncodeGlobalHeader(buf, PCAP_MAX_SNAPLEN);
+    fwrite(buf + 5, 1, n - PCAP_FRAME_OVERHEAD, out);
+
+    static PcapSlot slot;
+    for (const SynthFrame& f : frames) {
+        slot.tsSec = (uint32_t)(f.tsUs / 1000000);
+        slot.tsUsec = (uint32_t)(f.tsUs % 1000000);
+        slot.origLen = (uint16_t)f.bytes.size();
+        slot.capLen = (uint16_t)std::min<size_t>(f.bytes.size(), PCAP_MAX_SNAPLEN);
+        slot.rssi = f.rssi;
+        slot.channel = f.channel;
+        memcpy(slot.data, f.bytes.data(), slot.capLen);
+        n = pcapEncodeRecord(slot, buf);
+        fwrite(buf + 5, 1, n - PCAP_FRAME_OVERHEAD, out);
+    }
+    return fclose(out) == 0;
+}
+
+int main(int argc, char** argv) {
+    bool clean = false;
+    double seconds = 4.0;
+    uint32_t rate = 300;
+    const char* path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--clean")) clean = true;
+        else if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--rate") && i + 1 < argc) rate = (uint32_t)atoi(argv[++i]);
+        else if (argv[i][0] != '-' && path == NULL) path = argv[i];
+        else path = NULL, i = argc;
+    }
+    if (path == NULL || seconds <= 0 || rate == 0) {
+        fprintf(stderr, "usage: synth_pcap [--clean] [--seconds S] [--rate FPS] out.pcap\n");
+        return 2;
+    }
+
+    const uint64_t start = 1700000000ULL * 1000000;
+    const uint64_t end = start + (uint64_t)(seconds * 1e6);
+
+    // Background: beacons every 102.4 ms, data at rate exchanges/s
+    for (size_t a = 0; a < AP_COUNT; a++) {
+        for (uint64_t t = start + a * 7000; t < end; t += 102400) {
+            beacon(t, APS[a].bssid, APS[a].ssid, APS[a].channel, APS[a].rsn, (int8_t)(-55 - 8 * (int)a));
+        }
+    }
+    for (uint64_t t = start; t < end; t += 1000000 / rate) {
+        dataExchange(t + rng() % 500, APS[rng() % AP_COUNT], (uint8_t)(rng() % 8));
+    }
+    for (uint64_t t = start + 250000; t < end; t += 500000) {
+        std::vector<uint8_t> runt(1, 0x08);
+        emit(t, 1, -80, runt, false);
+    }
+
+    if (!clean) {
+        // Deauth burst: 40/s broadcast plus 20/s at one client, for 600 ms
+        for (uint64_t t = start + 1000000; t < start + 1600000 && t < end; t += 25000) {
+            teardown(t, FC_MGMT_DEAUTH, APS[0].bssid, BROADCAST, 7, 1);
+            if ((t / 25000) % 2 == 0) teardown(t + 500, FC_MGMT_DEAUTH, APS[0].bssid, VICTIM, 3, 1);
+        }
+        // Disassociation flood, 30/s
+        for (uint64_t t = start + 1800000; t < start + 2400000 && t < end; t += 33000) {
+            teardown(t, FC_MGMT_DISASSOC, APS[1].bssid, VICTIM, 8, 6);
+        }
+        // Beacon flood: a fresh random BSSID every 8 ms
+        for (uint64_t t = start + 2500000; t < start + 3200000 && t < end; t += 8000) {
+            uint8_t bssid[6] = {0x02, (uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng()};
+            char ssid[12];
+            snprintf(ssid, sizeof(ssid), "FREE-%04X", (unsigned)(rng() & 0xFFFF));
+            beacon(t, bssid, ssid, 6, false, -70);
+        }
+        // Open twin of HomeNet from another vendor
+        for (uint64_t t = start + 3000000; t < end; t += 102400) {
+            beacon(t, TWIN_BSSID, APS[0].ssid, 6, false, -48);
+        }
+    }
+
+    std::stable_sort(frames.begin(), frames.end(),
+                     [](const SynthFrame& a, const SynthFrame& b) { return a.tsUs < b.tsUs; });
+
+    if (!writeCapture(path)) {
+        fprintf(stderr, "synth_pcap: can't write %s\n", path);
+        return 2;
+    }
+    printf("%s: %zu frames over %.1f s\n", path, frames.size(), seconds);
+    return 0;
+}
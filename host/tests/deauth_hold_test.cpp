@@ -0,0 +1,66 @@
+// The deauth detector's alerts against their hold time: a disassoc flood
+// followed by a long deauth flood must drop the disassoc flag holdMs after
+// the last disassoc breach, while the attack alert stays up for as long
+// as the deauths keep coming. Then both must clear, and a new disassoc
+// burst must raise the flag again.
+//
+// usage: deauth_hold_test
+
+#include <stdio.h>
+#include <string.h>
+#include "deauth_detector.h"
+#include "ieee80211.h"
+
+static DeauthDetector detector;
+static int failed = 0;
+
+static void burst(uint8_t subtype, uint32_t now, int count) {
+    DeauthEvent e;
+    memset(&e, 0, sizeof(e));
+    static const uint8_t ap[MAC_LEN] = {0x02, 0x11, 0x22, 0x33, 0x44, 0x55};
+    memcpy(e.apMac, ap, MAC_LEN);
+    memset(e.clientMac, 0xFF, MAC_LEN);
+    e.reasonCode = 7;
+    e.subtype = subtype;
+    e.timestamp = now;
+    for (int i = 0; i < count; i++) detector.onDeauth(e);
+}
+
+static void expect(uint32_t now, bool attack, bool disassoc) {
+    const DeauthStats& s = detector.getStats();
+    if (s.attackDetected != attack || s.disassocFlood != disassoc) {
+        fprintf(stderr, "deauth_hold_test: at %u ms attack %d disassoc %d, expected %d %d\n",
+                now, s.attackDetected, s.disassocFlood, attack, disassoc);
+        failed = 1;
+    }
+}
+
+int main() {
+    DeauthThresholds t = DEAUTH_DEFAULT_THRESHOLDS;
+    detector.setThresholds(t);
+    uint32_t hold = t.holdMs;
+    uint32_t now = 1000;
+
+    burst(FC_MGMT_DISASSOC, now, t.disassocPerSec + 5);
+    expect(now, true, true);
+    uint32_t disassocAt = now;
+
+    // Deauths well over every threshold, every half second, for twice the hold
+    for (now = 1500; now < disassocAt + 2 * hold; now += 500) {
+        burst(FC_MGMT_DEAUTH, now, t.totalPerSec + 5);
+        detector.tick(now);
+        expect(now, true, now - disassocAt <= hold);
+    }
+
+    uint32_t lastDeauth = now - 500;
+    now = lastDeauth + hold + 1;
+    detector.tick(now);
+    expect(now, false, false);
+
+    now += 1000;
+    burst(FC_MGMT_DISASSOC, now, t.disassocPerSec + 5);
+    expect(now, true, true);
+
+    if (!failed) printf("deauth_hold_test: disassoc flag held %u ms past its last breach, attack alert held by deauths\n", hold);
+    return failed;
+}
@@ -0,0 +1,116 @@
+// Starting the channel hopper under a running sniffer must not disturb the
+// spectrogram. Both read WiFiHandler's per-channel frame counters as
+// deltas; if a hop start reset those counters, the spectrogram's next
+// delta would wrap to ~4e9 and draw a full-saturation row.
+//
+// Feeds a steady ~40 frames per spectrogram tick through the real RX
+// callback, starts hopping halfway, and fails on any saturated cell or if
+// rows stop coming.
+//
+// usage: hop_spectrogram_test
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include "host_platform.h"
+#include "wifi_handler.h"
+#include "rx_analyzers.h"
+#include "spectrogram.h"
+
+#define START_MS 1000
+#define TICKS 16
+#define HOP_AT_TICK 6
+#define FRAMES_PER_TICK 40
+
+static WiFiHandler wifi;
+
+static void sleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// QoS data frame, STA -> AP
+static void feedFrames(wifi_promiscuous_cb_t cb, uint8_t channel, int count) {
+    alignas(wifi_promiscuous_pkt_t) static uint8_t buf[sizeof(wifi_promiscuous_pkt_t) + 64];
+    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
+    static const uint8_t frame[] = {
+        0x88, 0x01, 0x00, 0x00,
+        0x02, 0x11, 0x22, 0x33, 0x44, 0x55,
+        0x02, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE,
+        0x02, 0x11, 0x22, 0x33, 0x44, 0x55,
+        0x10, 0x00, 0x00, 0x00,
+    };
+    memset(&pkt->rx_ctrl, 0, sizeof(pkt->rx_ctrl));
+    pkt->rx_ctrl.rssi = -50;
+    pkt->rx_ctrl.channel = channel;
+    pkt->rx_ctrl.sig_len = sizeof(frame);
+    memcpy(pkt->payload, frame, sizeof(frame));
+    for (int i = 0; i < count; i++) cb(pkt, WIFI_PKT_DATA);
+}
+
+int main() {
+    hostSetMillis(START_MS);
+    wifi.begin();
+    wifi.startSniffer();
+    for (int i = 0; i < 1000 && hostPromiscuousCallback() == NULL; i++) sleepMs(1);
+    if (hostPromiscuousCallback() == NULL) {
+        fprintf(stderr, "hop_spectrogram_test: rxTask never enabled promiscuous mode\n");
+        return 1;
+    }
+
+    uint32_t hopRow = 0;
+    for (int t = 0; t < TICKS; t++) {
+        if (t == HOP_AT_TICK) {
+            hopRow = wifi.getSpectrogramRows();
+            wifi.startHopping();
+        }
+        feedFrames(hostPromiscuousCallback(), 6, FRAMES_PER_TICK);
+        sleepMs(5);
+        hostSetMillis(START_MS + (t + 1) * SPECTRO_TICK_MS);
+        sleepMs(10);   // rxTask closes the row on its next pass
+    }
+    // getHopStats keeps its last copy when the hopper is mid-write, so
+    // give it a few tries
+    HopStats hop;
+    wifi.getHopStats(hop);
+    for (int i = 0; i < 100 && !hop.active; i++) {
+        sleepMs(1);
+        wifi.getHopStats(hop);
+    }
+
+    uint32_t rows = wifi.getSpectrogramRows();
+    uint8_t row[HOP_CHANNEL_COUNT];
+    int failed = 0;
+    int saturated = 0;
+    for (uint32_t n = rows > SPECTRO_ROWS - 1 ? rows - (SPECTRO_ROWS - 1) : 0; n < rows; n++) {
+        if (!wifi.getSpectrogramRow(n, row)) continue;
+        printf("row %2u%s", n, n == hopRow ? " (hop start)" : "            ");
+        for (int c = 0; c < HOP_CHANNEL_COUNT; c++) {
+            printf(" %3u", row[c]);
+            if (row[c] == 255) saturated++;
+        }
+        printf("\n");
+    }
+
+    if (!hop.active) {
+        fprintf(stderr, "hop_spectrogram_test: the hopper never started\n");
+        failed = 1;
+    }
+    if (saturated) {
+        fprintf(stderr, "hop_spectrogram_test: %d saturated cells\n", saturated);
+        failed = 1;
+    }
+    if (rows < TICKS - 2 || rows <= hopRow + 2) {
+        fprintf(stderr, "hop_spectrogram_test: only %u rows for %d ticks\n", rows, TICKS);
+        failed = 1;
+    }
+
+    wifi.stopHopping();
+    wifi.stop();
+    if (hostRunningTasks() != 0) {
+        fprintf(stderr, "hop_spectrogram_test: %d task(s) still running after stop()\n", hostRunningTasks());
+        failed = 1;
+    }
+    return failed;
+}
@@ -0,0 +1,176 @@
+// MacIndex against a plain model: a vector for the pool and a list for
+// the LRU order. Random finds, touches, inserts (evicting when full) and
+// removes on a small key universe, so probe runs collide, wrap around the
+// slot array and get backward-shifted constantly. After every step each
+// pooled key must be found at the model's index and a sample of absent
+// keys must not be found.
+//
+// usage: mac_index_test [steps]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <list>
+#include <vector>
+#include "mac_index.h"
+
+struct Model {
+    std::vector<uint64_t> pool;
+    std::list<uint16_t> lru;   // Front = most recent
+    uint16_t capacity;
+    uint32_t evictions;
+
+    int find(uint64_t key) const {
+        for (size_t i = 0; i < pool.size(); i++) {
+            if (pool[i] == key) return (int)i;
+        }
+        return -1;
+    }
+
+    void touch(uint16_t idx) {
+        lru.remove(idx);
+        lru.push_front(idx);
+    }
+
+    uint16_t insert(uint64_t key) {
+        uint16_t idx;
+        if (pool.size() < capacity) {
+            idx = (uint16_t)pool.size();
+            pool.push_back(key);
+        } else {
+            idx = lru.back();
+            lru.pop_back();
+            pool[idx] = key;
+            evictions++;
+        }
+        lru.push_front(idx);
+        return idx;
+    }
+
+    uint16_t remove(uint16_t idx) {
+        uint16_t last = (uint16_t)(pool.size() - 1);
+        lru.remove(idx);
+        if (idx != last) {
+            pool[idx] = pool[last];
+            std::replace(lru.begin(), lru.end(), last, idx);
+        }
+        pool.pop_back();
+        return last;
+    }
+};
+
+static uint32_t rng = 1;
+
+static uint32_t nextRandom() {
+    rng = rng * 1103515245 + 12345;
+    return rng >> 8;
+}
+
+// Keys from a universe a few times the capacity; some differ only in the
+// high bytes, which the hash folds down
+static uint64_t randomKey(uint16_t capacity) {
+    uint64_t n = nextRandom() % (capacity * 4u);
+    return (n & 1) ? (n << 40) | 0x0200 : 0x02AABB000000ULL + n;
+}
+
+static bool check(const char* name, const MacIndex& index, const Model& model, long step) {
+    if (index.size() != model.pool.size() || index.getEvictions() != model.evictions) {
+        fprintf(stderr, "mac_index_test: %s step %ld: size %u/%zu, evictions %u/%u\n", name, step,
+                index.size(), model.pool.size(), index.getEvictions(), model.evictions);
+        return false;
+    }
+    for (size_t i = 0; i < model.pool.size(); i++) {
+        if (index.find(model.pool[i]) != (int)i || index.key((uint16_t)i) != model.pool[i]) {
+            fprintf(stderr, "mac_index_test: %s step %ld: key %012llx should be at %zu, found at %d\n",
+                    name, step, (unsigned long long)model.pool[i], i, index.find(model.pool[i]));
+            return false;
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        uint64_t key = randomKey(model.capacity);
+        if (model.find(key) < 0 && index.find(key) >= 0) {
+            fprintf(stderr, "mac_index_test: %s step %ld: absent key %012llx found\n",
+                    name, step, (unsigned long long)key);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool run(const char* name, MacIndex& index, long steps) {
+    Model model;
+    model.capacity = index.getCapacity();
+    model.evictions = 0;
+    uint32_t evictions = 0;
+
+    for (long step = 0; step < steps; step++) {
+        uint32_t op = nextRandom() % 10;
+        uint64_t key = randomKey(model.capacity);
+        int at = model.find(key);
+
+        if (op < 5) {
+            // Sighting: touch if known, insert otherwise
+            if (at >= 0) {
+                index.touch((uint16_t)at);
+                model.touch((uint16_t)at);
+            } else {
+                uint16_t got = index.insert(key);
+                uint16_t want = model.insert(key);
+                if (got != want) {
+                    fprintf(stderr, "mac_index_test: %s step %ld: insert used entry %u, LRU says %u\n",
+                            name, step, got, want);
+                    return false;
+                }
+            }
+        } else if (op < 9 || model.pool.empty()) {
+            if (index.find(key) != at) {
+                fprintf(stderr, "mac_index_test: %s step %ld: find %d, expected %d\n",
+                        name, step, index.find(key), at);
+                return false;
+            }
+        } else {
+            uint16_t idx = (uint16_t)(nextRandom() % model.pool.size());
+            uint16_t got = index.remove(idx);
+            uint16_t want = model.remove(idx);
+            if (got != want) {
+                fprintf(stderr, "mac_index_test: %s step %ld: remove moved entry %u, expected %u\n",
+                        name, step, got, want);
+                return false;
+            }
+        }
+
+        if (!check(name, index, model, step)) return false;
+        if (step % 5000 == 4999) {
+            evictions += index.getEvictions();
+            index.clear();
+            model.pool.clear();
+            model.lru.clear();
+            model.evictions = 0;
+        }
+    }
+
+    evictions += index.getEvictions();
+    printf("%s: %ld steps, %u evictions\n", name, steps, evictions);
+    return true;
+}
+
+static FixedMacIndex<16, 32> fixedIndex;
+
+int main(int argc, char** argv) {
+    long steps = argc > 1 ? atol(argv[1]) : 100000;
+    if (steps < 1) {
+        fprintf(stderr, "usage: mac_index_test [steps]\n");
+        return 2;
+    }
+
+    // Runtime-attached, as NetworkTable uses it, at the full load factor
+    const uint16_t capacity = 64;
+    const uint8_t bits = 7;
+    std::vector<uint64_t> storage((MacIndex::storageSize(capacity, bits) + 7) / 8);
+    MacIndex attached;
+    attached.attach(storage.data(), capacity, bits);
+
+    bool ok = run("fixed 16/32", fixedIndex, steps);
+    ok = run("attached 64/128", attached, steps) && ok;
+    return ok ? 0 : 1;
+}
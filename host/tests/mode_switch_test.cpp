@@ -0,0 +1,57 @@
+// Switching straight from a running PCAP capture (with the hopper on) to
+// a network scan must tear the capture down first: no capture or hopper
+// task left behind, the promiscuous callback removed and the console baud
+// rate restored. Once the scan finishes, nothing may still be running.
+//
+// usage: mode_switch_test
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include "host_platform.h"
+#include "wifi_handler.h"
+
+static WiFiHandler wifi;
+static int failed = 0;
+
+static void sleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        fprintf(stderr, "mode_switch_test: %s\n", what);
+        failed = 1;
+    }
+}
+
+int main() {
+    hostSetMillis(1000);
+    uint32_t consoleBaud = Serial.baudRate();
+    wifi.begin();
+
+    wifi.startCapture();
+    wifi.startHopping();
+    check(wifi.isCapturing() && wifi.isHopping(), "capture with hopping did not start");
+    check(Serial.baudRate() != consoleBaud, "capture did not switch the serial baud rate");
+    sleepMs(20);
+
+    wifi.startScan();
+    check(!wifi.isCapturing(), "still capturing after startScan()");
+    check(!wifi.isHopping(), "hopper still running after startScan()");
+    check(hostPromiscuousCallback() == NULL, "capture callback still installed during the scan");
+    check(Serial.baudRate() == consoleBaud, "serial baud rate not restored for the scan");
+
+    for (int i = 0; i < 1000 && wifi.isScanning(); i++) sleepMs(1);
+    check(!wifi.isScanning(), "scan never finished");
+    check(hostRunningTasks() == 0, "tasks left running after the scan");
+
+    wifi.stop();
+    if (hostRunningTasks() != 0) {
+        fprintf(stderr, "mode_switch_test: %d task(s) still running after stop()\n", hostRunningTasks());
+        failed = 1;
+    }
+    if (!failed) printf("mode_switch_test: capture -> scan left nothing behind\n");
+    return failed;
+}
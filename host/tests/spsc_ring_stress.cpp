@@ -0,0 +1,136 @@
+// SpscRing under two real threads: a producer pushing sequence-numbered
+// records as fast as it can, a consumer draining them, every combination
+// of the copy and zero-copy APIs on each side. The consumer checks that
+// every record arrives exactly once, in order, and whole (the body is
+// derived from the sequence number, so a torn slot shows). A tiny ring
+// keeps both sides wrapping and colliding; an RX_RING_SIZE one of
+// WiFiEventData-sized records matches the capture path.
+//
+// usage: spsc_ring_stress [records per case]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "spsc_ring.h"
+
+struct Record {
+    uint32_t seq;
+    uint8_t body[52];   // 56 bytes in all, sizeof(WiFiEventData)
+};
+
+static void fill(Record& r, uint32_t seq) {
+    r.seq = seq;
+    for (size_t i = 0; i < sizeof(r.body); i++) r.body[i] = (uint8_t)(seq * 31 + i);
+}
+
+static bool intact(const Record& r) {
+    for (size_t i = 0; i < sizeof(r.body); i++) {
+        if (r.body[i] != (uint8_t)(r.seq * 31 + i)) return false;
+    }
+    return true;
+}
+
+enum ProducerApi { PUSH, CLAIM };
+enum ConsumerApi { POP, POP_BATCH, FRONT };
+
+static const char* PRODUCER_NAMES[] = {"push", "claim/commit"};
+static const char* CONSUMER_NAMES[] = {"pop", "popBatch", "front/release"};
+
+struct Failures {
+    uint32_t lost;        // Sequence numbers skipped
+    uint32_t duplicated;  // Sequence numbers seen again
+    uint32_t torn;        // Body doesn't match its sequence number
+    uint32_t oversize;    // size() above capacity
+};
+
+template <size_t N>
+static bool runCase(ProducerApi prod, ConsumerApi cons, uint32_t count) {
+    static SpscRing<Record, N> ring;
+    ring.reset();
+
+    uint64_t fullRetries = 0;
+    std::atomic<bool> abandon(false);   // Consumer gave up, stop producing
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&] {
+        for (uint32_t seq = 0; seq < count && !abandon.load(std::memory_order_relaxed); ) {
+            bool ok;
+            if (prod == PUSH || (seq & 1)) {
+                Record r;
+                fill(r, seq);
+                ok = ring.push(r);
+            } else {
+                Record* slot = ring.claim();
+                ok = slot != nullptr;
+                if (ok) {
+                    fill(*slot, seq);
+                    ring.commit();
+                }
+            }
+            if (ok) {
+                seq++;
+            } else {
+                fullRetries++;
+                std::this_thread::yield();   // Lets a single-core host run the consumer
+            }
+        }
+    });
+
+    Failures f = {};
+    uint32_t expected = 0;
+    Record batch[16];
+    while (expected < count) {
+        size_t n = 0;
+        const Record* inPlace = nullptr;
+        if (cons == POP) n = ring.pop(batch[0]) ? 1 : 0;
+        else if (cons == POP_BATCH) n = ring.popBatch(batch, 1 + expected % 16);
+        else if ((inPlace = ring.front()) != nullptr) n = 1;
+
+        if (ring.size() > N) f.oversize++;
+
+        for (size_t i = 0; i < n; i++) {
+            const Record& r = inPlace ? *inPlace : batch[i];
+            if (!intact(r)) f.torn++;
+            if (r.seq < expected) {
+                f.duplicated++;
+            } else {
+                f.lost += r.seq - expected;
+                expected = r.seq + 1;
+            }
+        }
+        if (inPlace) ring.release();
+        if (n == 0) std::this_thread::yield();
+        if (f.lost + f.duplicated + f.torn > 0) {
+            abandon.store(true, std::memory_order_relaxed);
+            break;
+        }
+    }
+    producer.join();
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    bool ok = f.lost + f.duplicated + f.torn + f.oversize == 0 && ring.size() == 0;
+    printf("N=%-4zu %-12s -> %-13s %9u records %6.1f M/s, producer found it full %llu times%s\n",
+           N, PRODUCER_NAMES[prod], CONSUMER_NAMES[cons], expected, expected / sec / 1e6,
+           (unsigned long long)fullRetries, ok ? "" : "  FAILED");
+    if (!ok) {
+        printf("  lost %u, duplicated %u, torn %u, size() over capacity %u, left in ring %zu\n",
+               f.lost, f.duplicated, f.torn, f.oversize, ring.size());
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    uint32_t count = argc > 1 ? (uint32_t)atol(argv[1]) : 1000000;
+
+    int failed = 0;
+    for (int p = PUSH; p <= CLAIM; p++) {
+        for (int c = POP; c <= FRONT; c++) {
+            failed += !runCase<4>((ProducerApi)p, (ConsumerApi)c, count);
+            failed += !runCase<256>((ProducerApi)p, (ConsumerApi)c, count);
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+#include "beacon_flood.h"
+#include <math.h>
+#include <string.h>
+
+BeaconFloodDetector::BeaconFloodDetector() : threshold(50), holdMs(5000) {
+    reset(0);
+}
+
+void BeaconFloodDetector::setThresholds(uint16_t bssidsPerSec, uint16_t hold) {
+    threshold = bssidsPerSec;
+    holdMs = hold;
+}
+
+void BeaconFloodDetector::reset(uint32_t now) {
+    memset(&stats, 0, sizeof(stats));
+    memset(bitmap, 0, sizeof(bitmap));
+    bitsSet = 0;
+    windowStart = now;
+    windowFrames = 0;
+}
+
+void BeaconFloodDetector::flag(uint32_t now) {
+    stats.floodDetected = true;
+    stats.lastDetectionTime = now;
+}
+
+void BeaconFloodDetector::onBeacon(uint64_t bssid, uint32_t now) {
+    if (now - windowStart >= BEACON_WINDOW_MS) closeWindow(now);
+
+    stats.frames++;
+    windowFrames++;
+
+    // Top bits of the Fibonacci hash are the well mixed ones
+    uint32_t bit = macKeyHash(bssid) >> (32 - 10);
+    static_assert(BEACON_BITMAP_BITS == 1 << 10, "Bitmap index width must match BEACON_BITMAP_BITS");
+    uint32_t mask = 1u << (bit & 31);
+    if (!(bitmap[bit >> 5] & mask)) {
+        bitmap[bit >> 5] |= mask;
+        bitsSet++;
+
+        // Set bits never exceed distinct BSSIDs, so this can alert early
+        if (bitsSet > threshold) flag(now);
+    }
+}
+
+void BeaconFloodDetector::closeWindow(uint32_t now) {
+    uint32_t elapsed = now - windowStart;
+    if (elapsed < BEACON_WINDOW_MS) elapsed = BEACON_WINDOW_MS;
+
+    // n ~= m * ln(m / zeroBits); a full bitmap reads as m * ln(m)
+    float m = BEACON_BITMAP_BITS;
+    uint32_t zero = BEACON_BITMAP_BITS - bitsSet;
+    float distinct = bitsSet == 0 ? 0.0f : m * logf(m / (zero ? zero : 1));
+
+    uint32_t perSec = (uint32_t)(distinct * 1000 / elapsed + 0.5f);
+    stats.bssidsPerSec = perSec > 0xFFFF ? 0xFFFF : perSec;
+    if (stats.bssidsPerSec > stats.peakBssidsPerSec) stats.peakBssidsPerSec = stats.bssidsPerSec;
+    uint32_t frames = windowFrames * 1000 / elapsed;
+    stats.framesPerSec = frames > 0xFFFF ? 0xFFFF : frames;
+    if (stats.bssidsPerSec > threshold) flag(now);
+
+    memset(bitmap, 0, sizeof(bitmap));
+    bitsSet = 0;
+    windowFrames = 0;
+    windowStart = now;
+}
+
+bool BeaconFloodDetector::tick(uint32_t now) {
+    bool changed = false;
+
+    if (now - windowStart >= BEACON_WINDOW_MS) {
+        closeWindow(now);
+        changed = true;
+    }
+
+    if (stats.floodDetected && now - stats.lastDetectionTime > holdMs) {
+        stats.floodDetected = false;
+        changed = true;
+    }
+
+    return changed;
+}
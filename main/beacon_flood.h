@@ -0,0 +1,45 @@
+#ifndef BEACON_FLOOD_H
+#define BEACON_FLOOD_H
+
+#include <stdint.h>
+#include "shared_types.h"
+
+// Beacon/probe response flood detection (fake AP floods), pure
+// bookkeeping like DeauthDetector. Distinct BSSIDs are counted per
+// one-second window by linear counting: each BSSID sets one bit of a
+// fixed bitmap and the share of bits still clear gives the estimate. A
+// flood of thousands of made-up BSSIDs costs one hash and one bit per
+// frame and never more than the bitmap.
+
+#define BEACON_BITMAP_BITS 1024  // Stays accurate well past 1000 BSSIDs/s
+#define BEACON_WINDOW_MS 1000
+
+class BeaconFloodDetector {
+public:
+    BeaconFloodDetector();
+
+    void setThresholds(uint16_t bssidsPerSec, uint16_t holdMs);
+    void reset(uint32_t now);
+
+    // Fold in one beacon or probe response from bssid
+    void onBeacon(uint64_t bssid, uint32_t now);
+
+    // Close the window on time and age the alert; true if the stats changed
+    bool tick(uint32_t now);
+
+    const BeaconFloodStats& getStats() const { return stats; }
+
+private:
+    BeaconFloodStats stats;
+    uint16_t threshold;
+    uint16_t holdMs;
+    uint32_t bitmap[BEACON_BITMAP_BITS / 32];
+    uint16_t bitsSet;
+    uint32_t windowStart;
+    uint32_t windowFrames;
+
+    void closeWindow(uint32_t now);
+    void flag(uint32_t now);
+};
+
+#endif
@@ -1,4 +1,34 @@
 #include "bt_handler.h"
+#include "oui_lookup.h"
+#include "ieee80211.h"
+#include "name_classifier.h"
+
+static int byRssi(const BTDevice& a, const BTDevice& b) {
+    return b.rssi - a.rssi;
+}
+
+static int byName(const BTDevice& a, const BTDevice& b) {
+    // Unnamed devices sink to the bottom
+    if (!a.hasName || !b.hasName) return (int)!a.hasName - (int)!b.hasName;
+    return strcasecmp(a.name, b.name);
+}
+
+static int byType(const BTDevice& a, const BTDevice& b) {
+    // Known types first, unknown last
+    uint8_t ta = a.deviceType ? a.deviceType : 0xFF;
+    uint8_t tb = b.deviceType ? b.deviceType : 0xFF;
+    if (ta != tb) return ta - tb;
+    return byRssi(a, b);
+}
+
+static int byLastSeen(const BTDevice& a, const BTDevice& b) {
+    int32_t d = (int32_t)(b.lastSeen - a.lastSeen);
+    return (d > 0) - (d < 0);
+}
+
+static const SortedIndex<BTDevice>::Compare sortCompare[BT_SORT_COUNT] = {
+    byRssi, byName, byType, byLastSeen
+};
 
 // Spam device names and appearances
 const BTSpamData BTHandler::spamData[BT_SPAM_COUNT] = {
@@ -20,6 +50,11 @@ BTDevice BTHandler::devices[MAX_BT_DEVICES];
 int BTHandler::deviceCount = 0;
 BTStats BTHandler::stats = {0, 0, 0, false};
 SemaphoreHandle_t BTHandler::deviceMutex = NULL;
+SortedIndex<BTDevice> BTHandler::sortedDevices;
+uint16_t BTHandler::deviceOrder[MAX_BT_DEVICES];
+uint16_t BTHandler::deviceRanks[MAX_BT_DEVICES];
+BTSort BTHandler::sortMode = BT_SORT_RSSI;
+FixedMacIndex<MAX_BT_DEVICES, BT_INDEX_SLOTS> BTHandler::addressIndex;
 
 BTDevice BTHandler::trackers[10];
 int BTHandler::trackerCount = 0;
@@ -45,6 +80,9 @@ void BTHandler::begin() {
     if (deviceMutex == NULL) deviceMutex = xSemaphoreCreateMutex();
     if (trackerMutex == NULL) trackerMutex = xSemaphoreCreateMutex();
     
+    sortedDevices.attach(devices, deviceOrder, deviceRanks);
+    sortedDevices.setCompare(sortCompare[sortMode]);
+    
     // Initialize BLE
     BLEDevice::init("ESP32-Flipper");
     
@@ -75,74 +113,83 @@ void BTHandler::cleanupTasks() {
 
 // ==================== BLE SCANNER ====================
 
-void BTHandler::AdvertisedDeviceCallbacks::onResult(BLEAdvertisedDevice advertisedDevice) {
-    if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(10))) {
+// Local name straight from the raw AD structures (advertisement plus scan
+// response), so no std::string per result. A complete name beats a
+// shortened one. Returns false if neither is present.
+static bool advertName(const uint8_t* p, size_t len, char* out, size_t outSize) {
+    bool found = false;
+    size_t i = 0;
+    
+    while (i + 1 < len) {
+        uint8_t fieldLen = p[i];
+        if (fieldLen == 0 || i + 1 + fieldLen > len) break;
         
-        // Check if device already exists
-        bool found = false;
-        for (int i = 0; i < deviceCount; i++) {
-            if (strcmp(devices[i].address, advertisedDevice.getAddress().toString().c_str()) == 0) {
-                // Update existing device
-                devices[i].rssi = advertisedDevice.getRSSI();
-                devices[i].lastSeen = millis();
-                found = true;
-                break;
-            }
+        uint8_t type = p[i + 1];
+        if (fieldLen > 1 && (type == 0x09 || (type == 0x08 && !found))) {
+            size_t n = fieldLen - 1;
+            if (n > outSize - 1) n = outSize - 1;
+            memcpy(out, p + i + 2, n);
+            out[n] = '\0';
+            found = true;
+            if (type == 0x09) break;
         }
+        i += 1 + fieldLen;
+    }
+    
+    return found;
+}
+
+void BTHandler::AdvertisedDeviceCallbacks::onResult(BLEAdvertisedDevice advertisedDevice) {
+    // Runs on the BLE host task for every advertisement: pull out what we
+    // need once, with no heap allocation, before taking the lock
+    BLEAddress address = advertisedDevice.getAddress();
+    const uint8_t* mac = *address.getNative();
+    uint64_t key = macToKey(mac);
+    int8_t rssi = advertisedDevice.getRSSI();
+    uint32_t now = millis();
+    
+    if (xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(10))) {
         
-        // Add new device
-        if (!found && deviceCount < MAX_BT_DEVICES) {
-            strncpy(devices[deviceCount].address, 
-                    advertisedDevice.getAddress().toString().c_str(), 17);
-            devices[deviceCount].address[17] = '\0';
+        int i = addressIndex.find(key);
+        if (i >= 0) {
+            // Update existing device
+            devices[i].rssi = rssi;
+            devices[i].lastSeen = now;
+            sortedDevices.update(i);
+        } else if (deviceCount < MAX_BT_DEVICES) {
+            // New device: the only time the name and vendor are looked at
+            BTDevice& d = devices[deviceCount];
+            snprintf(d.address, sizeof(d.address), "%02x:%02x:%02x:%02x:%02x:%02x",
+                     mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
             
-            if (advertisedDevice.haveName()) {
-                strncpy(devices[deviceCount].name, 
-                        advertisedDevice.getName().c_str(), 32);
-                devices[deviceCount].name[32] = '\0';
-                devices[deviceCount].hasName = true;
-            } else {
-                strcpy(devices[deviceCount].name, "Unknown");
-                devices[deviceCount].hasName = false;
-            }
+            d.hasName = advertName(advertisedDevice.getPayload(), advertisedDevice.getPayloadLength(),
+                                   d.name, sizeof(d.name));
+            if (!d.hasName) strcpy(d.name, "Unknown");
             
-            devices[deviceCount].rssi = advertisedDevice.getRSSI();
-            devices[deviceCount].isBLE = true;
-            devices[deviceCount].lastSeen = millis();
+            d.rssi = rssi;
+            d.isBLE = true;
+            d.lastSeen = now;
             
-            // Detect device type
-            String deviceName = String(devices[deviceCount].name);
-            deviceName.toLowerCase();
+            // Random/private BLE addresses carry no OUI
+            d.vendor = (advertisedDevice.getAddressType() == BLE_ADDR_TYPE_PUBLIC)
+                ? macVendor(mac)
+                : OUI_VENDOR_RANDOM;
             
-            if (deviceName.indexOf("phone") >= 0 || deviceName.indexOf("iphone") >= 0 || 
-                deviceName.indexOf("galaxy") >= 0 || deviceName.indexOf("pixel") >= 0) {
-                devices[deviceCount].deviceType = 1; // Phone
-            } else if (deviceName.indexOf("airpod") >= 0 || deviceName.indexOf("buds") >= 0 || 
-                       deviceName.indexOf("headphone") >= 0 || deviceName.indexOf("wh-") >= 0) {
-                devices[deviceCount].deviceType = 2; // Headset
-            } else if (deviceName.indexOf("speaker") >= 0 || deviceName.indexOf("jbl") >= 0 || 
-                       deviceName.indexOf("bose") >= 0) {
-                devices[deviceCount].deviceType = 3; // Speaker
-            } else if (deviceName.indexOf("watch") >= 0 || deviceName.indexOf("band") >= 0) {
-                devices[deviceCount].deviceType = 4; // Watch
-            } else if (deviceName.indexOf("tile") >= 0 || deviceName.indexOf("airtag") >= 0 || 
-                       deviceName.indexOf("tracker") >= 0) {
-                devices[deviceCount].deviceType = 5; // Tracker
-            } else {
-                devices[deviceCount].deviceType = 0; // Unknown
-            }
+            d.deviceType = d.hasName ? classifyName(d.name).deviceType : 0;
             
+            addressIndex.insert(key);
+            sortedDevices.insert(deviceCount);
             deviceCount++;
             stats.devicesFound++;
             stats.bleDevices++;
         }
         
         // Update RSSI tracking
-        if (advertisedDevice.getRSSI() > strongestRSSI) {
-            strongestRSSI = advertisedDevice.getRSSI();
+        if (rssi > strongestRSSI) {
+            strongestRSSI = rssi;
         }
         
-        rssiHistory[rssiIndex] = advertisedDevice.getRSSI();
+        rssiHistory[rssiIndex] = rssi;
         rssiIndex = (rssiIndex + 1) % 50;
         
         xSemaphoreGive(deviceMutex);
@@ -158,6 +205,8 @@ void BTHandler::startScan() {
     // Reset device list
     if (xSemaphoreTake(deviceMutex, portMAX_DELAY)) {
         deviceCount = 0;
+        addressIndex.clear();
+        sortedDevices.clear();
         stats.devicesFound = 0;
         stats.bleDevices = 0;
         stats.classicDevices = 0;
@@ -191,6 +240,43 @@ void BTHandler::stopScan() {
     moduleState = BT_STATE_IDLE;
 }
 
+int BTHandler::copyDevices(BTDevice* out, int maxCount, const BTFilter& filter, int* matched) {
+    if (!xSemaphoreTake(deviceMutex, pdMS_TO_TICKS(10))) return -1;
+    
+    int n = 0;
+    int total = 0;
+    for (uint16_t r = 0; r < sortedDevices.size(); r++) {
+        const BTDevice& d = devices[sortedDevices.at(r)];
+        if (!filter.matches(d)) continue;
+        total++;
+        if (n < maxCount) out[n++] = d;
+    }
+    
+    xSemaphoreGive(deviceMutex);
+    if (matched != NULL) *matched = total;
+    return n;
+}
+
+void BTHandler::setSortMode(BTSort sort) {
+    if (sort >= BT_SORT_COUNT) return;
+    
+    if (xSemaphoreTake(deviceMutex, portMAX_DELAY)) {
+        sortMode = sort;
+        sortedDevices.setCompare(sortCompare[sort]);
+        xSemaphoreGive(deviceMutex);
+    }
+}
+
+const char* BTHandler::getSortName(BTSort sort) {
+    switch(sort) {
+        case BT_SORT_RSSI: return "RSSI";
+        case BT_SORT_NAME: return "NAME";
+        case BT_SORT_TYPE: return "TYPE";
+        case BT_SORT_LAST_SEEN: return "SEEN";
+        default: return "?";
+    }
+}
+
 BTStats BTHandler::getStats() {
     BTStats localStats;
     
@@ -205,26 +291,7 @@ BTStats BTHandler::getStats() {
 }
 
 uint8_t BTHandler::detectDeviceType(const char* name) {
-    String deviceName = String(name);
-    deviceName.toLowerCase();
-    
-    if (deviceName.indexOf("phone") >= 0 || deviceName.indexOf("iphone") >= 0 || 
-        deviceName.indexOf("galaxy") >= 0 || deviceName.indexOf("pixel") >= 0) {
-        return 1; // Phone
-    } else if (deviceName.indexOf("airpod") >= 0 || deviceName.indexOf("buds") >= 0 || 
-               deviceName.indexOf("headphone") >= 0 || deviceName.indexOf("wh-") >= 0) {
-        return 2; // Headset
-    } else if (deviceName.indexOf("speaker") >= 0 || deviceName.indexOf("jbl") >= 0 || 
-               deviceName.indexOf("bose") >= 0) {
-        return 3; // Speaker
-    } else if (deviceName.indexOf("watch") >= 0 || deviceName.indexOf("band") >= 0) {
-        return 4; // Watch
-    } else if (deviceName.indexOf("tile") >= 0 || deviceName.indexOf("airtag") >= 0 || 
-               deviceName.indexOf("tracker") >= 0) {
-        return 5; // Tracker
-    }
-    
-    return 0; // Unknown
+    return classifyName(name).deviceType;
 }
 
 const char* BTHandler::getDeviceTypeName(uint8_t type) {
@@ -302,28 +369,11 @@ void BTHandler::spammerTask(void* pvParameters) {
 
 // ==================== TRACKER DETECTOR (SKIMMER) ====================
 
-bool BTHandler::isTracker(BLEAdvertisedDevice device) {
-    String name = device.haveName() ? String(device.getName().c_str()) : "";
-    name.toLowerCase();
-    
-    // Check for known tracker keywords
-    if (name.indexOf("tile") >= 0 || name.indexOf("airtag") >= 0 || 
-        name.indexOf("chipolo") >= 0 || name.indexOf("trackr") >= 0 ||
-        name.indexOf("nutfind") >= 0) {
-        return true;
-    }
-    
-    // Check for Apple Find My network (AirTag) by UUID
-    if (device.haveServiceUUID()) {
-        // Apple Find My network service UUID
-        BLEUUID findMyUUID("0000XXXX-0000-1000-8000-00805F9B34FB");
-        // This is a simplified check - real AirTag detection is more complex
-    }
-    
-    // Check for suspicious behavior (very low transmit interval)
-    // Trackers often advertise frequently
-    
-    return false;
+bool BTHandler::isTracker(BLEAdvertisedDevice& device) {
+    // Known tracker keywords in the advertised name
+    char name[33];
+    return advertName(device.getPayload(), device.getPayloadLength(), name, sizeof(name)) &&
+           classifyName(name).tracker;
 }
 
 void BTHandler::startSkimmer() {
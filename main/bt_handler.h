@@ -6,9 +6,13 @@
 #include <BLEUtils.h>
 #include <BLEScan.h>
 #include <BLEAdvertisedDevice.h>
+#include "mac_index.h"
+#include "sorted_index.h"
 
 #define MAX_BT_DEVICES 20
 #define BT_SPAM_COUNT 10
+#define BT_INDEX_BITS 6          // 64 address slots, load factor <= 0.32
+#define BT_INDEX_SLOTS (1 << BT_INDEX_BITS)
 
 // Bluetooth device info
 struct BTDevice {
@@ -18,9 +22,35 @@ struct BTDevice {
     bool isBLE;
     bool hasName;
     uint32_t lastSeen;
+    const char* vendor; // From the OUI table (flash), never NULL
     uint8_t deviceType; // 0=Unknown, 1=Phone, 2=Headset, 3=Speaker, 4=Watch, 5=Tracker
 };
 
+// Scanner list ordering
+enum BTSort {
+    BT_SORT_RSSI,
+    BT_SORT_NAME,
+    BT_SORT_TYPE,
+    BT_SORT_LAST_SEEN,
+    BT_SORT_COUNT
+};
+
+// Scanner list filter
+struct BTFilter {
+    uint8_t typeMask;   // Bit per deviceType, 0 = any
+    int8_t minRssi;     // -128 = any
+    bool namedOnly;
+
+    bool matches(const BTDevice& d) const {
+        if (d.rssi < minRssi) return false;
+        if (namedOnly && !d.hasName) return false;
+        if (typeMask != 0 && !(typeMask & (1u << d.deviceType))) return false;
+        return true;
+    }
+};
+
+static const BTFilter BT_FILTER_ALL = {0, -128, false};
+
 // Bluetooth statistics
 struct BTStats {
     uint32_t devicesFound;
@@ -59,6 +89,13 @@ public:
     void stopScan();
     int getDeviceCount() const { return deviceCount; }
     BTDevice* getDevices() { return devices; }
+    // Copies up to maxCount matching devices in the current sort order;
+    // matched gets the total number of matches. -1 if the list is busy.
+    int copyDevices(BTDevice* out, int maxCount,
+                    const BTFilter& filter = BT_FILTER_ALL, int* matched = NULL);
+    void setSortMode(BTSort sort);
+    BTSort getSortMode() const { return sortMode; }
+    const char* getSortName(BTSort sort);
     BTStats getStats();
     const char* getDeviceTypeName(uint8_t type);
     
@@ -85,6 +122,15 @@ private:
     static int deviceCount;
     static BTStats stats;
     static SemaphoreHandle_t deviceMutex;
+    static SortedIndex<BTDevice> sortedDevices;
+    static uint16_t deviceOrder[MAX_BT_DEVICES];
+    static uint16_t deviceRanks[MAX_BT_DEVICES];
+    static BTSort sortMode;
+    
+    // Address -> device lookup. Devices are only ever appended and the
+    // list stops growing when full, so the index never evicts and its
+    // entry numbers match devices[].
+    static FixedMacIndex<MAX_BT_DEVICES, BT_INDEX_SLOTS> addressIndex;
     
     // BLE Spamming
     static const BTSpamData spamData[BT_SPAM_COUNT];
@@ -114,7 +160,7 @@ private:
     // Helper functions
     void cleanupTasks();
     uint8_t detectDeviceType(const char* name);
-    bool isTracker(BLEAdvertisedDevice device);
+    bool isTracker(BLEAdvertisedDevice& device);
 };
 
 #endif
\ No newline at end of file
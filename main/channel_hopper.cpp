@@ -0,0 +1,63 @@
+#include "channel_hopper.h"
+#include <string.h>
+
+ChannelHopper::ChannelHopper() {
+    config.baseDwellMs = 200;
+    config.maxDwellMs = 1000;
+    config.busyFramesPerSec = 200;
+    reset();
+}
+
+void ChannelHopper::reset() {
+    memset(&stats, 0, sizeof(stats));
+    memset(lastVisitDeauths, 0, sizeof(lastVisitDeauths));
+    stats.currentChannel = HOP_FIRST_CHANNEL;
+}
+
+void ChannelHopper::endDwell(uint8_t channel, uint32_t frames, uint32_t deauths, uint32_t dwellMs) {
+    if (channel < HOP_FIRST_CHANNEL || channel > HOP_LAST_CHANNEL) return;
+
+    ChannelHopStats& ch = stats.channels[channel - HOP_FIRST_CHANNEL];
+    ch.frames += frames;
+    ch.deauths += deauths;
+    ch.dwellMs += dwellMs;
+    ch.visits++;
+
+    // 3:1 smoothing so one quiet visit doesn't immediately drop a busy channel
+    uint32_t rate = dwellMs ? (frames * 1000) / dwellMs : 0;
+    if (rate > 0xFFFF) rate = 0xFFFF;
+    ch.frameRate = (ch.visits == 1) ? rate : (ch.frameRate * 3 + rate) / 4;
+
+    lastVisitDeauths[channel - HOP_FIRST_CHANNEL] = deauths > 0xFFFF ? 0xFFFF : deauths;
+}
+
+void ChannelHopper::recordSwitch(uint8_t channel, uint32_t latencyUs) {
+    stats.switches++;
+    stats.switchAvgUs = (stats.switches == 1)
+        ? latencyUs
+        : stats.switchAvgUs - (stats.switchAvgUs >> 3) + (latencyUs >> 3);
+    if (latencyUs > stats.switchMaxUs) stats.switchMaxUs = latencyUs;
+
+    stats.currentChannel = channel;
+    stats.nextDwellMs = dwellFor(channel);
+}
+
+uint8_t ChannelHopper::nextChannel(uint8_t current) const {
+    return (current >= HOP_LAST_CHANNEL) ? HOP_FIRST_CHANNEL : current + 1;
+}
+
+uint16_t ChannelHopper::dwellFor(uint8_t channel) const {
+    if (channel < HOP_FIRST_CHANNEL || channel > HOP_LAST_CHANNEL) return config.baseDwellMs;
+    if (config.maxDwellMs <= config.baseDwellMs) return config.baseDwellMs;
+
+    // Deauths seen last time round: stay as long as allowed
+    if (lastVisitDeauths[channel - HOP_FIRST_CHANNEL] > 0) return config.maxDwellMs;
+
+    uint32_t rate = stats.channels[channel - HOP_FIRST_CHANNEL].frameRate;
+    if (rate > config.busyFramesPerSec) rate = config.busyFramesPerSec;
+
+    uint32_t extra = config.busyFramesPerSec
+        ? (uint32_t)(config.maxDwellMs - config.baseDwellMs) * rate / config.busyFramesPerSec
+        : 0;
+    return config.baseDwellMs + extra;
+}
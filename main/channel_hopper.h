@@ -0,0 +1,62 @@
+#ifndef CHANNEL_HOPPER_H
+#define CHANNEL_HOPPER_H
+
+#include <stdint.h>
+
+// Adaptive dwell scheduler for 2.4 GHz channels 1-13. Pure bookkeeping:
+// the caller does the actual radio switch and feeds back per-dwell frame
+// and deauth counts plus the measured switch time. Channels with recent
+// traffic get longer dwell, channels with recent deauths get the maximum.
+
+#define HOP_FIRST_CHANNEL 1
+#define HOP_LAST_CHANNEL 13
+#define HOP_CHANNEL_COUNT 13
+
+struct HopConfig {
+    uint16_t baseDwellMs;      // Dwell on an idle channel
+    uint16_t maxDwellMs;       // Upper bound for busy/attacked channels
+    uint16_t busyFramesPerSec; // Rate at which a channel earns maxDwellMs
+};
+
+struct ChannelHopStats {
+    uint32_t frames;     // Frames seen on this channel while parked on it
+    uint32_t deauths;
+    uint32_t dwellMs;    // Total time spent on this channel
+    uint16_t visits;
+    uint16_t frameRate;  // Smoothed frames/sec over recent visits
+};
+
+struct HopStats {
+    ChannelHopStats channels[HOP_CHANNEL_COUNT]; // index = channel - 1
+    uint32_t switches;
+    uint32_t switchAvgUs;  // esp_wifi_set_channel cost, smoothed
+    uint32_t switchMaxUs;
+    uint16_t nextDwellMs;
+    uint8_t currentChannel;
+    bool active;
+};
+
+class ChannelHopper {
+public:
+    ChannelHopper();
+
+    void setConfig(const HopConfig& cfg) { config = cfg; }
+    const HopConfig& getConfig() const { return config; }
+    void reset();
+
+    // Fold in the dwell that just ended on channel
+    void endDwell(uint8_t channel, uint32_t frames, uint32_t deauths, uint32_t dwellMs);
+    void recordSwitch(uint8_t channel, uint32_t latencyUs);
+
+    uint8_t nextChannel(uint8_t current) const;
+    uint16_t dwellFor(uint8_t channel) const;
+
+    const HopStats& getStats() const { return stats; }
+
+private:
+    HopConfig config;
+    HopStats stats;
+    uint16_t lastVisitDeauths[HOP_CHANNEL_COUNT];
+};
+
+#endif
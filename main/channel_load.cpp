@@ -0,0 +1,52 @@
+#include "channel_load.h"
+#include <string.h>
+
+// Overlap weight by channel distance, in 1/16ths
+static const uint8_t overlapWeight[CHAN_LOAD_SPREAD + 1] = { 16, 10, 4 };
+
+// Received power relative to the -100 dBm floor, doubling every 3 dB.
+// Capped at -55 dBm (anything louder is next to us anyway) so 1024
+// entries on one channel still fit 32 bits after the overlap taps.
+static inline uint32_t powerWeight(int8_t rssi) {
+    int r = rssi < -100 ? -100 : (rssi > -55 ? -55 : rssi);
+    return 1u << ((r + 100) / 3);
+}
+
+void computeChannelLoad(const NetworkTable& table, ChannelLoad& out) {
+    // Padded so the convolution below needs no edge checks
+    uint32_t padded[CHAN_LOAD_COUNT + 2 * CHAN_LOAD_SPREAD];
+    memset(padded, 0, sizeof(padded));
+    memset(out.apCount, 0, sizeof(out.apCount));
+
+    for (uint16_t i = 0; i < table.size(); i++) {
+        const NetworkEntry& e = table.at(i);
+        if (e.channel < CHAN_LOAD_FIRST || e.channel > CHAN_LOAD_LAST) continue;
+        padded[e.channel - CHAN_LOAD_FIRST + CHAN_LOAD_SPREAD] += powerWeight(e.rssi);
+        if (out.apCount[e.channel - CHAN_LOAD_FIRST] < 0xFF) out.apCount[e.channel - CHAN_LOAD_FIRST]++;
+    }
+
+    // Fixed-size 5-tap spread, no branches
+    for (int c = 0; c < CHAN_LOAD_COUNT; c++) {
+        const uint32_t* p = padded + c + CHAN_LOAD_SPREAD;
+        out.direct[c] = p[0];
+        out.load[c] = (p[0] * overlapWeight[0] +
+                       (p[-1] + p[1]) * overlapWeight[1] +
+                       (p[-2] + p[2]) * overlapWeight[2]) >> 4;
+    }
+
+    // Least loaded channel; ties go to the non-overlapping 1/6/11
+    out.maxLoad = 0;
+    out.best = 0;
+    if (table.size() == 0) return;
+
+    uint32_t bestLoad = 0xFFFFFFFF;
+    for (int c = 0; c < CHAN_LOAD_COUNT; c++) {
+        uint8_t ch = c + CHAN_LOAD_FIRST;
+        bool preferred = (ch == 1 || ch == 6 || ch == 11);
+        if (out.load[c] > out.maxLoad) out.maxLoad = out.load[c];
+        if (out.load[c] < bestLoad || (out.load[c] == bestLoad && preferred)) {
+            bestLoad = out.load[c];
+            out.best = ch;
+        }
+    }
+}
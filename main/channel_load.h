@@ -0,0 +1,30 @@
+#ifndef CHANNEL_LOAD_H
+#define CHANNEL_LOAD_H
+
+#include <stdint.h>
+#include "network_table.h"
+
+// Per-channel congestion for 2.4 GHz channels 1-13, computed from the
+// scanned network table. A 20 MHz transmission spans about four 5 MHz
+// channel steps, so each AP also loads the two channels on either side,
+// at reduced weight. APs are weighted by received power (x2 per 3 dB)
+// so a strong neighbour counts for more than a dozen faint ones.
+
+#define CHAN_LOAD_FIRST 1
+#define CHAN_LOAD_LAST 13
+#define CHAN_LOAD_COUNT 13
+#define CHAN_LOAD_SPREAD 2     // Overlap reaches +-2 channels
+
+struct ChannelLoad {
+    uint32_t direct[CHAN_LOAD_COUNT];  // Power-weighted APs on the channel itself
+    uint32_t load[CHAN_LOAD_COUNT];    // Including overlap from neighbours
+    uint32_t maxLoad;
+    uint8_t apCount[CHAN_LOAD_COUNT];
+    uint8_t best;                      // Least congested channel, 0 = no data
+};
+
+// Rebuild out from every entry in the table. Cost is one pass over the
+// table plus a fixed 13 x 5 convolution, cheap enough for every merge.
+void computeChannelLoad(const NetworkTable& table, ChannelLoad& out);
+
+#endif
@@ -0,0 +1,162 @@
+#include "deauth_detector.h"
+#include <string.h>
+
+DeauthDetector::DeauthDetector() : thresholds(DEAUTH_DEFAULT_THRESHOLDS) {
+    reset();
+}
+
+void DeauthDetector::reset() {
+    memset(&stats, 0, sizeof(stats));
+    memset(&analytics, 0, sizeof(analytics));
+    total.reset(0);
+    disassoc.reset(0);
+    broadcast.reset(0);
+    aps.clear();
+    clients.clear();
+}
+
+void DeauthDetector::flag(uint32_t now) {
+    stats.attackDetected = true;
+    stats.lastDetectionTime = now;
+}
+
+// Move the pair to the front of the list, adding it if new
+void DeauthDetector::recordPair(const DeauthEvent& event, uint32_t rate) {
+    int i = 0;
+    while (i < stats.pairCount &&
+           !(memcmp(stats.pairs[i].apMac, event.apMac, MAC_LEN) == 0 &&
+             memcmp(stats.pairs[i].clientMac, event.clientMac, MAC_LEN) == 0)) {
+        i++;
+    }
+    if (i == stats.pairCount && stats.pairCount < DEAUTH_PAIR_COUNT) stats.pairCount++;
+    if (i == DEAUTH_PAIR_COUNT) i--;
+
+    for (; i > 0; i--) stats.pairs[i] = stats.pairs[i - 1];
+
+    DeauthPair& p = stats.pairs[0];
+    memcpy(p.apMac, event.apMac, MAC_LEN);
+    memcpy(p.clientMac, event.clientMac, MAC_LEN);
+    p.rate = rate > 0xFFFF ? 0xFFFF : rate;
+    p.lastSeen = event.timestamp;
+}
+
+static bool samePair(const DeauthPair& p, const DeauthEvent& event) {
+    return memcmp(p.apMac, event.apMac, MAC_LEN) == 0 &&
+           memcmp(p.clientMac, event.clientMac, MAC_LEN) == 0;
+}
+
+// Keep the pairs with the highest peak rate, fastest first
+void DeauthDetector::rankPair(const DeauthEvent& event, uint32_t rate) {
+    DeauthPair* pairs = analytics.topPairs;
+    uint16_t r = rate > 0xFFFF ? 0xFFFF : rate;
+    int n = analytics.topPairCount;
+
+    int i = 0;
+    while (i < n && !samePair(pairs[i], event)) i++;
+
+    if (i < n) {
+        pairs[i].lastSeen = event.timestamp;
+        if (r <= pairs[i].rate) return;
+    } else {
+        if (n == DEAUTH_TOP_COUNT && r <= pairs[n - 1].rate) return;
+        if (n < DEAUTH_TOP_COUNT) analytics.topPairCount = ++n;
+        i = n - 1;
+        memcpy(pairs[i].apMac, event.apMac, MAC_LEN);
+        memcpy(pairs[i].clientMac, event.clientMac, MAC_LEN);
+        pairs[i].lastSeen = event.timestamp;
+    }
+
+    pairs[i].rate = r;
+    for (; i > 0 && pairs[i - 1].rate < pairs[i].rate; i--) {
+        DeauthPair t = pairs[i - 1];
+        pairs[i - 1] = pairs[i];
+        pairs[i] = t;
+    }
+}
+
+void DeauthDetector::onDeauth(const DeauthEvent& event) {
+    uint32_t now = event.timestamp;
+
+    // Counted and thresholded apart; both feed the per-address trackers
+    if (event.subtype == FC_MGMT_DISASSOC) {
+        stats.disassocCount++;
+        uint32_t d = disassoc.add(now);
+        stats.disassocRate = d > 0xFFFF ? 0xFFFF : d;
+        if (d > thresholds.disassocPerSec) {
+            stats.disassocFlood = true;
+            stats.lastDisassocTime = now;
+            flag(now);
+        }
+    } else {
+        stats.totalDeauths++;
+        uint32_t rate = total.add(now);
+        stats.totalRate = rate > 0xFFFF ? 0xFFFF : rate;
+        if (stats.totalRate > stats.peakRate) stats.peakRate = stats.totalRate;
+        if (rate > thresholds.totalPerSec) flag(now);
+    }
+
+    analytics.events++;
+    analytics.reasons[deauthReasonBucket(event.reasonCode)]++;
+
+    uint64_t client = macToKey(event.clientMac);
+    if (client == MAC_BROADCAST_KEY) {
+        analytics.broadcast++;
+        stats.broadcastDeauths++;
+        uint32_t b = broadcast.add(now);
+        if (b == (uint32_t)thresholds.broadcastPerSec + 1) stats.suspiciousCount++;
+        if (b > thresholds.broadcastPerSec) flag(now);
+    } else {
+        analytics.unicast++;
+        uint32_t c = clients.hit(client, now);
+        rankPair(event, c);
+        if (c == (uint32_t)thresholds.clientPerSec + 1) stats.suspiciousCount++;
+        if (c > thresholds.clientPerSec) {
+            recordPair(event, c);
+            flag(now);
+        }
+    }
+
+    uint32_t a = aps.hit(macToKey(event.apMac), now);
+    if (a == (uint32_t)thresholds.apPerSec + 1) stats.suspiciousCount++;
+    if (a > thresholds.apPerSec) {
+        memcpy(stats.suspiciousAP, event.apMac, MAC_LEN);
+        flag(now);
+    }
+
+    stats.trackedSources = aps.size();
+    stats.trackerEvictions = aps.getEvictions();
+}
+
+void DeauthDetector::getAnalytics(DeauthAnalytics& out) const {
+    out = analytics;
+    out.targetCount = clients.top(out.targets, DEAUTH_TOP_COUNT);
+}
+
+bool DeauthDetector::tick(uint32_t now) {
+    bool changed = false;
+
+    uint32_t rate = total.count(now);
+    if (rate != stats.totalRate) {
+        stats.totalRate = rate;
+        changed = true;
+    }
+
+    rate = disassoc.count(now);
+    if (rate != stats.disassocRate) {
+        stats.disassocRate = rate;
+        changed = true;
+    }
+
+    // Clear once nothing has breached a threshold for the hold time. The
+    // disassoc flag has its own hold: deauth breaches must not keep it up
+    if (stats.disassocFlood && now - stats.lastDisassocTime > thresholds.holdMs) {
+        stats.disassocFlood = false;
+        changed = true;
+    }
+    if (stats.attackDetected && now - stats.lastDetectionTime > thresholds.holdMs) {
+        stats.attackDetected = false;
+        changed = true;
+    }
+
+    return changed;
+}
@@ -0,0 +1,55 @@
+#ifndef DEAUTH_DETECTOR_H
+#define DEAUTH_DETECTOR_H
+
+#include <stdint.h>
+#include "shared_types.h"
+#include "deauth_tracker.h"
+#include "rate_window.h"
+
+// Deauth attack detection, pure bookkeeping like ChannelHopper: the task
+// feeds decoded events in and publishes getStats(). Rates are sliding
+// one-second windows for deauths and disassociations (kept apart), for
+// broadcast frames, per AP and per targeted client, so an alert follows the current rate instead of
+// latching on an old burst. Every event costs two hash lookups plus
+// amortised O(1) window upkeep. Alongside, fixed-size triage aggregates:
+// reason codes, broadcast vs unicast, most targeted clients and the
+// fastest AP/client pairs.
+
+static const DeauthThresholds DEAUTH_DEFAULT_THRESHOLDS = {10, 5, 3, 3, 5000, 5, 50};
+
+class DeauthDetector {
+public:
+    DeauthDetector();
+
+    void setThresholds(const DeauthThresholds& t) { thresholds = t; }
+    const DeauthThresholds& getThresholds() const { return thresholds; }
+    void reset();
+
+    // Fold in one deauth or disassoc event
+    void onDeauth(const DeauthEvent& event);
+
+    // Age the alert with no traffic; returns true if the stats changed
+    bool tick(uint32_t now);
+
+    const DeauthStats& getStats() const { return stats; }
+
+    // Ranks the targeted clients, so call it at UI rate
+    void getAnalytics(DeauthAnalytics& out) const;
+    uint32_t eventCount() const { return analytics.events; }
+
+private:
+    DeauthThresholds thresholds;
+    DeauthStats stats;
+    DeauthAnalytics analytics;
+    RateWindow total;
+    RateWindow disassoc;
+    RateWindow broadcast;
+    DeauthTracker aps;
+    DeauthTracker clients;
+
+    void flag(uint32_t now);
+    void recordPair(const DeauthEvent& event, uint32_t rate);
+    void rankPair(const DeauthEvent& event, uint32_t rate);
+};
+
+#endif
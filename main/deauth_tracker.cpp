@@ -0,0 +1,57 @@
+#include "deauth_tracker.h"
+
+void DeauthTracker::clear() {
+    index.clear();
+}
+
+uint32_t DeauthTracker::hit(uint64_t key, uint32_t now) {
+    int found = index.find(key);
+
+    if (found >= 0) {
+        index.touch(found);
+
+        Entry& e = entries[found];
+        uint32_t rate = e.rate.add(now);
+        e.frames++;
+        if (rate > e.peak) e.peak = rate > 0xFFFF ? 0xFFFF : rate;
+        return rate;
+    }
+
+    // New address; recycles the least recently seen when full
+    Entry& e = entries[index.insert(key)];
+    e.rate.reset(now);
+    e.rate.add(now);
+    e.frames = 1;
+    e.peak = 1;
+
+    return 1;
+}
+
+int DeauthTracker::top(DeauthTarget* out, int max) const {
+    // Insertion into a short sorted list, as StationTable::topTalkers
+    uint16_t best[DEAUTH_TOP_COUNT];
+    if (max > DEAUTH_TOP_COUNT) max = DEAUTH_TOP_COUNT;
+    if (max <= 0) return 0;
+    int n = 0;
+
+    for (uint16_t idx = 0; idx < index.size(); idx++) {
+        uint32_t frames = entries[idx].frames;
+        if (n == max && frames <= entries[best[n - 1]].frames) continue;
+
+        int pos = (n < max) ? n++ : n - 1;
+        while (pos > 0 && entries[best[pos - 1]].frames < frames) {
+            best[pos] = best[pos - 1];
+            pos--;
+        }
+        best[pos] = idx;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const Entry& e = entries[best[i]];
+        keyToMac(index.key(best[i]), out[i].mac);
+        out[i].frames = e.frames;
+        out[i].peakRate = e.peak;
+    }
+
+    return n;
+}
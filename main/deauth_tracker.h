@@ -0,0 +1,52 @@
+#ifndef DEAUTH_TRACKER_H
+#define DEAUTH_TRACKER_H
+
+#include <stdint.h>
+#include "ieee80211.h"
+#include "mac_index.h"
+#include "rate_window.h"
+#include "shared_types.h"
+
+// Per-address deauth rate for the detector (one table keyed by AP, one by
+// targeted client). Same layout as StationTable: a FixedMacIndex over a
+// static pool, so a flood from hundreds of spoofed addresses costs one
+// hash probe per frame and simply recycles the stalest entries. Each entry
+// carries a sliding one-second RateWindow. Owned by one task; not thread
+// safe.
+
+#ifndef DEAUTH_TRACKER_CAPACITY
+#define DEAUTH_TRACKER_CAPACITY 64      // Tracked deauth sources
+#endif
+#ifndef DEAUTH_TRACKER_HASH_BITS
+#define DEAUTH_TRACKER_HASH_BITS 7      // 128 slots, load factor <= 0.5
+#endif
+#define DEAUTH_TRACKER_SLOTS (1 << DEAUTH_TRACKER_HASH_BITS)
+
+static_assert(DEAUTH_TRACKER_CAPACITY * 2 <= DEAUTH_TRACKER_SLOTS, "Deauth tracker hash must be at least twice the pool");
+
+class DeauthTracker {
+public:
+    void clear();
+
+    // Count one deauth for key, returns its deauths in the last second
+    uint32_t hit(uint64_t key, uint32_t now);
+
+    // Up to max entries with the most deauths, most first. Walks the
+    // whole table, so call it at UI rate. Returns how many were filled.
+    int top(DeauthTarget* out, int max) const;
+
+    int size() const { return index.size(); }
+    uint32_t getEvictions() const { return index.getEvictions(); }
+
+private:
+    struct Entry {
+        RateWindow rate;
+        uint32_t frames;
+        uint16_t peak;   // Highest rate returned by hit()
+    };
+
+    FixedMacIndex<DEAUTH_TRACKER_CAPACITY, DEAUTH_TRACKER_SLOTS> index;
+    Entry entries[DEAUTH_TRACKER_CAPACITY];
+};
+
+#endif
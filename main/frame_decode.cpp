@@ -0,0 +1,103 @@
+#include "frame_decode.h"
+#include <string.h>
+
+// SSID, DS channel and security class out of a beacon/probe response
+static void decodeBeaconBody(const FrameView& view, WiFiEventData& out) {
+    const uint8_t* body = view.body(0, BEACON_FIXED_LEN);
+    if (body == nullptr) return;
+
+    uint16_t len = view.bodyLength();
+    uint16_t cap = (uint16_t)(body[BEACON_CAP_OFFSET] | (body[BEACON_CAP_OFFSET + 1] << 8));
+    bool rsn = false;
+    bool wpa = false;
+    bool haveSsid = false;
+
+    // Every IE is checked against the body before its value is touched
+    for (uint16_t pos = BEACON_FIXED_LEN; pos + 2 <= len; ) {
+        uint8_t id = body[pos];
+        uint8_t ieLen = body[pos + 1];
+        if (pos + 2 + ieLen > len) break;
+        const uint8_t* v = body + pos + 2;
+
+        if (id == IE_SSID && !haveSsid) {
+            haveSsid = true;
+            if (ieLen > 0 && v[0] != 0) {
+                uint32_t h = 2166136261u;
+                for (int i = 0; i < ieLen; i++) h = (h ^ v[i]) * 16777619u;
+                out.ssidHash = h ? h : 1;
+
+                int n = ieLen < RX_SSID_LEN - 1 ? ieLen : RX_SSID_LEN - 1;
+                for (int i = 0; i < n; i++) out.ssid[i] = (v[i] >= 0x20 && v[i] < 0x7F) ? v[i] : '?';
+                out.ssid[n] = '\0';
+            }
+        } else if (id == IE_DS_PARAMS && ieLen >= 1) {
+            out.apChannel = v[0];
+        } else if (id == IE_RSN) {
+            rsn = true;
+        } else if (id == IE_VENDOR && ieLen >= 4 &&
+                   v[0] == 0x00 && v[1] == 0x50 && v[2] == 0xF2 && v[3] == 0x01) {
+            wpa = true;
+        }
+        pos += 2 + ieLen;
+    }
+
+    if (!(cap & CAP_PRIVACY)) out.security = SEC_OPEN;
+    else if (rsn) out.security = SEC_RSN;
+    else if (wpa) out.security = SEC_WPA;
+    else out.security = SEC_WEP;
+    out.flags |= RX_REC_BEACON;
+}
+
+bool decodeRxFrame(const RxFrame& frame, uint32_t nowMs, WiFiEventData& out, bool withBeacon) {
+    FrameView view(frame.payload, frame.len);
+    if (!view.valid()) return false;
+
+    out.rssi = frame.rssi;
+    out.channel = frame.channel;
+    out.timestamp = nowMs;
+    out.rxTimestamp = frame.rxTimestamp;
+    out.type = frame.type;
+    out.flags = 0;
+
+    // Only grab the frame control here; subtype decoding happens in the analyzers
+    out.frameControl = view.fc();
+
+    // Addresses kept raw - formatted only if the UI shows them
+    memcpy(out.receiver, view.addr1(), MAC_LEN);
+
+    const uint8_t* ta = view.addr2();
+    if (ta != nullptr) {
+        memcpy(out.bssid, ta, MAC_LEN);
+        out.flags |= RX_REC_TA;
+    } else {
+        memset(out.bssid, 0, MAC_LEN);
+    }
+
+    out.reasonCode = 0;
+    if (view.reasonCode(out.reasonCode)) out.flags |= RX_REC_REASON;
+
+    out.apChannel = 0;
+    out.security = SEC_UNKNOWN;
+    out.ssidHash = 0;
+    out.ssid[0] = '\0';
+    if (withBeacon) {
+        uint8_t slot = fcSlot(out.frameControl);
+        if (slot == SLOT_BEACON || slot == SLOT_PROBE_RESP) decodeBeaconBody(view, out);
+    }
+    return true;
+}
+
+bool deauthFromRecord(const WiFiEventData& rec, DeauthEvent& out) {
+    if (!(rec.flags & RX_REC_REASON) || !(rec.flags & RX_REC_TA)) return false;
+
+    out.timestamp = rec.timestamp;
+    out.rxTimestamp = rec.rxTimestamp;
+    out.rssi = rec.rssi;
+    out.reasonCode = rec.reasonCode;
+    out.subtype = fcSubtype(rec.frameControl);
+
+    // AP is the transmitter (address 2), client the receiver (address 1)
+    memcpy(out.apMac, rec.bssid, MAC_LEN);
+    memcpy(out.clientMac, rec.receiver, MAC_LEN);
+    return true;
+}
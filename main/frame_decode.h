@@ -0,0 +1,43 @@
+#ifndef FRAME_DECODE_H
+#define FRAME_DECODE_H
+
+#include <stdint.h>
+#include "shared_types.h"
+
+// Turns one received 802.11 frame into the record the RX analyzers
+// consume. Kept free of esp_wifi types: the RX callbacks fill an RxFrame
+// from wifi_promiscuous_pkt_t, but a frame read from a .pcap file works
+// just as well, so parsing can be exercised off-target.
+
+struct RxFrame {
+    const uint8_t* payload; // 802.11 header onwards
+    uint16_t len;           // Bytes valid at payload (rx_ctrl.sig_len)
+    PktType type;
+    int8_t rssi;
+    uint8_t channel;
+    uint32_t rxTimestamp;   // us
+};
+
+// Histogram slots of the frames that tear a client off its AP
+#define SLOT_DISASSOC ((FC_TYPE_MGMT << 4) | FC_MGMT_DISASSOC)
+#define SLOT_DEAUTH   ((FC_TYPE_MGMT << 4) | FC_MGMT_DEAUTH)
+
+// and of the frames that advertise one
+#define SLOT_BEACON     ((FC_TYPE_MGMT << 4) | FC_MGMT_BEACON)
+#define SLOT_PROBE_RESP ((FC_TYPE_MGMT << 4) | FC_MGMT_PROBE_RESP)
+
+inline bool slotIsDeauth(uint8_t slot) { return slot == SLOT_DEAUTH || slot == SLOT_DISASSOC; }
+
+// Shared record: frame control, both addresses, reason code for
+// deauth/disassoc, radio metadata. Done once per frame in the callback,
+// through FrameView so nothing past frame.len is read. withBeacon also
+// walks the IEs of a beacon/probe response for SSID, channel and
+// security; only asked for when an analyzer needs them. False (and out
+// untouched) when the frame is too short to carry even addr1.
+bool decodeRxFrame(const RxFrame& frame, uint32_t nowMs, WiFiEventData& out, bool withBeacon = false);
+
+// True for deauth/disassoc records that carried a reason code, in which
+// case out is filled
+bool deauthFromRecord(const WiFiEventData& rec, DeauthEvent& out);
+
+#endif
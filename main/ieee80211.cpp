@@ -0,0 +1,46 @@
+#include "ieee80211.h"
+
+// Indexed by histogram slot (type << 4 | subtype)
+static const char* const FRAME_SLOT_NAMES[FRAME_SLOT_COUNT] = {
+    // Management
+    "AssocReq", "AssocResp", "ReassocReq", "ReassocResp",
+    "ProbeReq", "ProbeResp", "Timing", "Mgmt-7",
+    "Beacon", "ATIM", "Disassoc", "Auth",
+    "Deauth", "Action", "ActionNoAck", "Mgmt-15",
+    // Control
+    "Ctrl-0", "Ctrl-1", "Trigger", "TACK",
+    "BeamRpt", "NDPA", "CtrlExt", "Wrapper",
+    "BlockAckReq", "BlockAck", "PS-Poll", "RTS",
+    "CTS", "ACK", "CF-End", "CF-End+Ack",
+    // Data
+    "Data", "Data+CF-Ack", "Data+CF-Poll", "Data+CF-A+P",
+    "Null", "CF-Ack", "CF-Poll", "CF-Ack+Poll",
+    "QoS Data", "QoS D+CF-Ack", "QoS D+CF-Poll", "QoS D+CF-A+P",
+    "QoS Null", "Data-13", "QoS CF-Poll", "QoS CF-A+P",
+    // Extension
+    "DMG Beacon", "S1G Beacon", "Ext-2", "Ext-3",
+    "Ext-4", "Ext-5", "Ext-6", "Ext-7",
+    "Ext-8", "Ext-9", "Ext-10", "Ext-11",
+    "Ext-12", "Ext-13", "Ext-14", "Ext-15"
+};
+
+const char* frameSlotName(uint8_t slot) {
+    if (slot >= FRAME_SLOT_COUNT) return "?";
+    return FRAME_SLOT_NAMES[slot];
+}
+
+// 802.11 reason codes 0-24, the ones deauth tools and broken clients send
+static const char* const REASON_NAMES[] = {
+    "Reserved", "Unspecified", "Auth expired", "Leaving IBSS",
+    "Inactivity", "AP full", "Class2 unauth", "Class3 unassoc",
+    "Leaving BSS", "Not authed", "Bad power cap", "Bad channels",
+    "BSS transition", "Invalid IE", "MIC failure", "4-way timeout",
+    "GK timeout", "IE mismatch", "Bad group ciph", "Bad pair ciph",
+    "Bad AKMP", "Bad RSNE ver", "Bad RSNE cap", "802.1X failed",
+    "Cipher policy"
+};
+
+const char* reasonCodeName(uint16_t reason) {
+    if (reason >= sizeof(REASON_NAMES) / sizeof(REASON_NAMES[0])) return "Other";
+    return REASON_NAMES[reason];
+}
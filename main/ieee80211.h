@@ -0,0 +1,202 @@
+#ifndef IEEE80211_H
+#define IEEE80211_H
+
+#include <stdint.h>
+
+// 802.11 frame control helpers. Everything here is inline bit twiddling on
+// the 16-bit frame control field (payload[0] | payload[1] << 8), so the RX
+// callbacks can decode a frame in O(1) without touching the heap.
+
+// Frame types (bits 2-3 of byte 0)
+#define FC_TYPE_MGMT 0
+#define FC_TYPE_CTRL 1
+#define FC_TYPE_DATA 2
+#define FC_TYPE_EXT  3
+
+// Management subtypes
+#define FC_MGMT_ASSOC_REQ    0
+#define FC_MGMT_ASSOC_RESP   1
+#define FC_MGMT_REASSOC_REQ  2
+#define FC_MGMT_REASSOC_RESP 3
+#define FC_MGMT_PROBE_REQ    4
+#define FC_MGMT_PROBE_RESP   5
+#define FC_MGMT_BEACON       8
+#define FC_MGMT_DISASSOC     10
+#define FC_MGMT_AUTH         11
+#define FC_MGMT_DEAUTH       12
+#define FC_MGMT_ACTION       13
+
+// Control subtypes
+#define FC_CTRL_BAR    8
+#define FC_CTRL_BA     9
+#define FC_CTRL_PSPOLL 10
+#define FC_CTRL_RTS    11
+#define FC_CTRL_CTS    12
+#define FC_CTRL_ACK    13
+
+// Data subtypes
+#define FC_DATA_DATA     0
+#define FC_DATA_NULL     4
+#define FC_DATA_QOS_DATA 8
+#define FC_DATA_QOS_NULL 12
+
+// Flag bits (byte 1)
+#define FC_FLAG_TO_DS   0x0100
+#define FC_FLAG_FROM_DS 0x0200
+#define FC_FLAG_RETRY   0x0800
+
+// One histogram slot per (type, subtype) pair
+#define FRAME_SLOT_COUNT 64
+
+inline uint16_t fcFromPayload(const uint8_t* payload) {
+    return (uint16_t)(payload[0] | (payload[1] << 8));
+}
+
+inline uint8_t fcType(uint16_t fc)    { return (fc >> 2) & 0x03; }
+inline uint8_t fcSubtype(uint16_t fc) { return (fc >> 4) & 0x0F; }
+inline bool fcIsRetry(uint16_t fc)    { return (fc & FC_FLAG_RETRY) != 0; }
+
+// 0 = STA<->STA/IBSS, 1 = to AP, 2 = from AP, 3 = WDS
+inline uint8_t fcDsBits(uint16_t fc)  { return (fc >> 8) & 0x03; }
+
+// Histogram slot: type << 4 | subtype
+inline uint8_t fcSlot(uint16_t fc)    { return (uint8_t)((fcType(fc) << 4) | fcSubtype(fc)); }
+inline uint8_t slotType(uint8_t slot)    { return slot >> 4; }
+inline uint8_t slotSubtype(uint8_t slot) { return slot & 0x0F; }
+
+// Short human readable name for a histogram slot ("Beacon", "QoS Data", ...)
+const char* frameSlotName(uint8_t slot);
+
+// Short name for a deauth/disassoc reason code ("Inactivity", ...)
+const char* reasonCodeName(uint16_t reason);
+
+// Header layout
+#define FC_FLAG_ORDER   0x8000
+#define HDR_ADDR1_OFFSET 4
+#define HDR_ADDR2_OFFSET 10
+#define HDR_ADDR3_OFFSET 16
+#define HDR_SEQ_OFFSET   22
+#define HDR_ADDR4_OFFSET 24
+#define HDR_MIN_LEN      10   // FC + duration + addr1 (CTS/ACK)
+#define HDR_MGMT_LEN     24
+
+// Beacon/probe response body: timestamp, interval, capability, then IEs
+#define BEACON_FIXED_LEN 12
+#define BEACON_CAP_OFFSET 10
+#define CAP_PRIVACY      0x0010
+
+// Information element IDs
+#define IE_SSID       0
+#define IE_DS_PARAMS  3
+#define IE_RSN        48
+#define IE_VENDOR     221
+
+// Zero-copy view of one received frame. Every accessor checks the field
+// against the frame type and the bytes actually received, so short or
+// control frames yield NULL/false instead of whatever follows them in the
+// RX buffer. All checks are compares against len, no copies.
+class FrameView {
+public:
+    FrameView(const uint8_t* payload, uint16_t len) : p(payload), n(len) {}
+
+    // Long enough to carry frame control, duration and addr1
+    bool valid() const { return n >= HDR_MIN_LEN; }
+    uint16_t length() const { return n; }
+
+    uint16_t fc() const { return n >= 2 ? fcFromPayload(p) : 0; }
+
+    // Address 1-4, NULL if this frame type has no such field or it was cut off
+    const uint8_t* addr1() const { return field(HDR_ADDR1_OFFSET, 6); }
+    const uint8_t* addr2() const { return hasAddr2() ? field(HDR_ADDR2_OFFSET, 6) : nullptr; }
+    const uint8_t* addr3() const { return hasSeq() ? field(HDR_ADDR3_OFFSET, 6) : nullptr; }
+    const uint8_t* addr4() const { return hasAddr4() ? field(HDR_ADDR4_OFFSET, 6) : nullptr; }
+
+    // Sequence control (fragment in the low 4 bits), mgmt and data only
+    bool seqCtrl(uint16_t& out) const {
+        const uint8_t* f = hasSeq() ? field(HDR_SEQ_OFFSET, 2) : nullptr;
+        if (f == nullptr) return false;
+        out = (uint16_t)(f[0] | (f[1] << 8));
+        return true;
+    }
+
+    // MAC header length, i.e. where the frame body starts. 0 for control
+    // frames, which have no body.
+    uint16_t bodyOffset() const {
+        uint16_t f = fc();
+        uint8_t type = fcType(f);
+        if (type == FC_TYPE_MGMT) return HDR_MGMT_LEN;
+        if (type != FC_TYPE_DATA) return 0;
+
+        uint16_t off = HDR_MGMT_LEN;
+        if (hasAddr4()) off += 6;
+        if (fcSubtype(f) & 0x08) {               // QoS control
+            off += 2;
+            if (f & FC_FLAG_ORDER) off += 4;     // HT control
+        }
+        return off;
+    }
+
+    uint16_t bodyLength() const {
+        uint16_t start = bodyOffset();
+        return (start != 0 && n > start) ? n - start : 0;
+    }
+
+    // Body bytes from offset onwards, NULL unless need bytes are there
+    const uint8_t* body(uint16_t offset, uint16_t need) const {
+        uint16_t start = bodyOffset();
+        if (start == 0) return nullptr;
+        return field(start + offset, need);
+    }
+
+    // Deauth/disassoc reason code
+    bool reasonCode(uint16_t& out) const {
+        uint16_t f = fc();
+        if (fcType(f) != FC_TYPE_MGMT ||
+            (fcSubtype(f) != FC_MGMT_DEAUTH && fcSubtype(f) != FC_MGMT_DISASSOC)) return false;
+        const uint8_t* b = body(0, 2);
+        if (b == nullptr) return false;
+        out = (uint16_t)(b[0] | (b[1] << 8));
+        return true;
+    }
+
+private:
+    const uint8_t* p;
+    uint16_t n;
+
+    const uint8_t* field(uint32_t offset, uint32_t size) const {
+        return offset + size <= n ? p + offset : nullptr;
+    }
+
+    // CTS and ACK carry only the receiver
+    bool hasAddr2() const {
+        uint16_t f = fc();
+        return !(fcType(f) == FC_TYPE_CTRL &&
+                 (fcSubtype(f) == FC_CTRL_CTS || fcSubtype(f) == FC_CTRL_ACK));
+    }
+    bool hasSeq() const { return fcType(fc()) == FC_TYPE_MGMT || fcType(fc()) == FC_TYPE_DATA; }
+    bool hasAddr4() const { return fcType(fc()) == FC_TYPE_DATA && fcDsBits(fc()) == 3; }
+};
+
+// Pack a 6-byte MAC into a 48-bit integer key (first octet most significant)
+inline uint64_t macToKey(const uint8_t* mac) {
+    return ((uint64_t)mac[0] << 40) | ((uint64_t)mac[1] << 32) |
+           ((uint32_t)mac[2] << 24) | ((uint32_t)mac[3] << 16) |
+           ((uint32_t)mac[4] << 8) | mac[5];
+}
+
+inline void keyToMac(uint64_t key, uint8_t* mac) {
+    for (int i = 5; i >= 0; i--) {
+        mac[i] = (uint8_t)key;
+        key >>= 8;
+    }
+}
+
+// macToKey(FF:FF:FF:FF:FF:FF)
+#define MAC_BROADCAST_KEY 0xFFFFFFFFFFFFULL
+
+// Fold 48 bits down to a well mixed 32-bit hash (Fibonacci hashing)
+inline uint32_t macKeyHash(uint64_t key) {
+    return ((uint32_t)key ^ (uint32_t)(key >> 24)) * 2654435761u;
+}
+
+#endif
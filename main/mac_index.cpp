@@ -0,0 +1,126 @@
+#include "mac_index.h"
+#include <string.h>
+
+MacIndex::MacIndex()
+    : keys(nullptr), prev(nullptr), next(nullptr), slots(nullptr), capacity(0), slotMask(0), slotBits(0),
+      count(0), lruHead(NIL), lruTail(NIL), evictions(0) {}
+
+size_t MacIndex::storageSize(uint16_t cap, uint8_t bits) {
+    // keys | LRU prev | LRU next | slots
+    return cap * sizeof(uint64_t) + 2 * cap * sizeof(uint16_t) + (sizeof(uint16_t) << bits);
+}
+
+void MacIndex::attach(void* storage, uint16_t cap, uint8_t bits) {
+    keys = (uint64_t*)storage;
+    prev = (uint16_t*)(keys + cap);
+    next = prev + cap;
+    slots = next + cap;
+
+    capacity = cap;
+    slotBits = bits;
+    slotMask = (uint16_t)((1u << bits) - 1);
+    clear();
+}
+
+void MacIndex::clear() {
+    if (slots) memset(slots, 0, sizeof(uint16_t) << slotBits);
+    count = 0;
+    lruHead = NIL;
+    lruTail = NIL;
+    evictions = 0;
+}
+
+int MacIndex::findSlot(uint64_t key) const {
+    uint16_t i = homeSlot(key);
+
+    while (slots[i] != 0) {
+        if (keys[slots[i] - 1] == key) return i;
+        i = (i + 1) & slotMask;
+    }
+
+    return -1;
+}
+
+void MacIndex::removeSlot(int slot) {
+    // Backward-shift delete: pull later members of the probe run into the
+    // hole so lookups never need tombstones
+    uint16_t hole = slot;
+    uint16_t j = slot;
+
+    for (;;) {
+        j = (j + 1) & slotMask;
+        if (slots[j] == 0) break;
+
+        uint16_t home = homeSlot(keys[slots[j] - 1]);
+        bool stays = (hole <= j) ? (hole < home && home <= j)
+                                 : (hole < home || home <= j);
+        if (stays) continue;
+
+        slots[hole] = slots[j];
+        hole = j;
+    }
+
+    slots[hole] = 0;
+}
+
+void MacIndex::lruUnlink(uint16_t idx) {
+    if (prev[idx] != NIL) next[prev[idx]] = next[idx];
+    else lruHead = next[idx];
+
+    if (next[idx] != NIL) prev[next[idx]] = prev[idx];
+    else lruTail = prev[idx];
+}
+
+void MacIndex::lruPushFront(uint16_t idx) {
+    prev[idx] = NIL;
+    next[idx] = lruHead;
+
+    if (lruHead != NIL) prev[lruHead] = idx;
+    lruHead = idx;
+    if (lruTail == NIL) lruTail = idx;
+}
+
+uint16_t MacIndex::insert(uint64_t key) {
+    // Take a free entry or recycle the least recently used
+    uint16_t idx;
+    if (count < capacity) {
+        idx = count++;
+    } else {
+        idx = lruTail;
+        removeSlot(findSlot(keys[idx]));
+        lruUnlink(idx);
+        evictions++;
+    }
+
+    keys[idx] = key;
+    lruPushFront(idx);
+
+    uint16_t i = homeSlot(key);
+    while (slots[i] != 0) {
+        i = (i + 1) & slotMask;
+    }
+    slots[i] = idx + 1;
+
+    return idx;
+}
+
+uint16_t MacIndex::remove(uint16_t idx) {
+    removeSlot(findSlot(keys[idx]));
+    lruUnlink(idx);
+
+    uint16_t last = --count;
+    if (idx == last) return idx;
+
+    // Move the last entry into the hole, slot and LRU links included
+    keys[idx] = keys[last];
+    slots[findSlot(keys[idx])] = idx + 1;
+
+    prev[idx] = prev[last];
+    next[idx] = next[last];
+    if (prev[idx] != NIL) next[prev[idx]] = idx;
+    else lruHead = idx;
+    if (next[idx] != NIL) prev[next[idx]] = idx;
+    else lruTail = idx;
+
+    return last;
+}
@@ -0,0 +1,103 @@
+#ifndef MAC_INDEX_H
+#define MAC_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ieee80211.h"
+
+// Hash index from packed 48-bit MAC (macToKey) to a slot in the owner's
+// densely packed entry pool. Open addressing with linear probing and
+// backward-shift delete, so lookups never meet tombstones, plus an
+// intrusive LRU list over the pool so the stalest entry can be recycled
+// in O(1) when it is full. The index holds only keys and links; the owner
+// keeps its payload in a parallel array addressed by the same index.
+// Storage is supplied by the owner (FixedMacIndex below carries its own).
+// Not thread safe; same locking rules as the table that owns it.
+class MacIndex {
+public:
+    static const uint16_t NIL = 0xFFFF;
+
+    MacIndex();
+    MacIndex(const MacIndex&) = delete;   // Holds pointers into its storage
+    MacIndex& operator=(const MacIndex&) = delete;
+
+    // Bytes of storage needed for capacity entries and 1 << slotBits
+    // slots; slots must be at least twice the capacity. The storage must
+    // be aligned for uint64_t.
+    static size_t storageSize(uint16_t capacity, uint8_t slotBits);
+    void attach(void* storage, uint16_t capacity, uint8_t slotBits);
+    void clear();
+
+    // Pool index of key, -1 if absent
+    int find(uint64_t key) const {
+        int slot = findSlot(key);
+        return slot < 0 ? -1 : slots[slot] - 1;
+    }
+
+    // Add a key that is not present and make it the most recent. When
+    // the pool is full the least recently used entry is evicted and its
+    // index reused, so the caller must reinitialise that entry.
+    uint16_t insert(uint64_t key);
+
+    // Mark idx as the most recently used
+    void touch(uint16_t idx) {
+        if (idx == lruHead) return;
+        lruUnlink(idx);
+        lruPushFront(idx);
+    }
+
+    // Drop idx and move the last entry into its place to keep the pool
+    // dense. Returns the moved entry's old index (idx when nothing moved);
+    // the caller moves its payload the same way.
+    uint16_t remove(uint16_t idx);
+
+    uint64_t key(uint16_t idx) const { return keys[idx]; }
+    uint16_t size() const { return count; }
+    uint16_t getCapacity() const { return capacity; }
+    uint32_t getEvictions() const { return evictions; }
+    bool full() const { return count == capacity; }
+
+private:
+    uint64_t* keys;
+    uint16_t* prev;      // LRU list, head = most recent
+    uint16_t* next;
+    uint16_t* slots;     // entry index + 1, 0 = empty
+    uint16_t capacity;
+    uint16_t slotMask;
+    uint8_t slotBits;
+    uint16_t count;
+    uint16_t lruHead;
+    uint16_t lruTail;
+    uint32_t evictions;
+
+    uint16_t homeSlot(uint64_t key) const {
+        return (uint16_t)(macKeyHash(key) >> (32 - slotBits));
+    }
+
+    int findSlot(uint64_t key) const;
+    void removeSlot(int slot);
+    void lruUnlink(uint16_t idx);
+    void lruPushFront(uint16_t idx);
+};
+
+constexpr uint8_t macIndexBits(uint32_t slots) {
+    return slots <= 1 ? 0 : 1 + macIndexBits(slots >> 1);
+}
+
+// MacIndex with its storage inline, for tables whose size is fixed at
+// build time. Load factor is capped at 0.5 so probe runs stay short.
+template <uint16_t CAPACITY, uint16_t SLOTS>
+class FixedMacIndex : public MacIndex {
+    static_assert(CAPACITY > 0 && CAPACITY < NIL, "MAC index capacity out of range");
+    static_assert((SLOTS & (SLOTS - 1)) == 0, "MAC index slot count must be a power of two");
+    static_assert(CAPACITY * 2 <= SLOTS, "MAC index must have at least twice as many slots as entries");
+
+public:
+    FixedMacIndex() { attach(storage, CAPACITY, macIndexBits(SLOTS)); }
+
+private:
+    // keys | LRU prev | LRU next | slots
+    uint64_t storage[CAPACITY + (2 * CAPACITY + SLOTS + 3) / 4];
+};
+
+#endif
@@ -0,0 +1,22 @@
+#include "name_classifier.h"
+#include "name_keywords.h"
+
+static_assert(NAME_KW_STATES <= 256, "DFA states must fit uint8_t, regenerate name_keywords.h");
+
+NameClass classifyName(const char* name) {
+    uint8_t state = 0;
+    uint8_t hits = 0;
+
+    for (const uint8_t* p = (const uint8_t*)name; *p; p++) {
+        uint8_t cls = *p < 128 ? NAME_KW_CLASS[*p] : 0;
+        state = NAME_KW_NEXT[state][cls];
+        hits |= NAME_KW_OUT[state];
+    }
+
+    // Lowest type bit wins, matching the keyword file's order
+    uint8_t types = hits & ~NAME_KW_TRACKER;
+    NameClass out;
+    out.deviceType = types ? __builtin_ctz(types) + 1 : 0;
+    out.tracker = (hits & NAME_KW_TRACKER) != 0;
+    return out;
+}
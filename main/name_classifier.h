@@ -0,0 +1,19 @@
+#ifndef NAME_CLASSIFIER_H
+#define NAME_CLASSIFIER_H
+
+#include <stdint.h>
+
+// BLE device classification from the advertised name. Every keyword in
+// tools/bt_keywords.txt is compiled by tools/gen_keywords.py into one
+// Aho-Corasick DFA (name_keywords.h, constexpr, in flash), so a name is
+// matched against all of them case-insensitively in a single pass with
+// one table lookup per character and no allocation.
+
+struct NameClass {
+    uint8_t deviceType;  // BTDevice.deviceType, 0 = unknown
+    bool tracker;        // Name of a known tracker (AirTag, Tile, ...)
+};
+
+NameClass classifyName(const char* name);
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef NAME_KEYWORDS_H
+#define NAME_KEYWORDS_H
+
+// Generated by tools/gen_keywords.py from tools/bt_keywords.txt, do not edit.
+// 21 keywords, 5 types (Phone, Headset, Speaker, Watch, Tracker), 92 states, 24 input classes.
+
+#include <stdint.h>
+
+#define NAME_KW_STATES 92
+#define NAME_KW_CLASSES 24
+#define NAME_KW_TRACKER 0x80
+
+// ASCII -> input class, case folded; 0 = not in any keyword
+static constexpr uint8_t NAME_KW_CLASS[128] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13,  0, 14, 15,
+    16,  0, 17, 18, 19, 20,  0, 21, 22, 23,  0,  0,  0,  0,  0,  0,
+     0,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13,  0, 14, 15,
+    16,  0, 17, 18, 19, 20,  0, 21, 22, 23,  0,  0,  0,  0,  0,  0,
+};
+
+// [state][class] -> next state, failure links already folded in
+static constexpr uint8_t NAME_KW_NEXT[NAME_KW_STATES][NAME_KW_CLASSES] = {
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,2,18,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,33,0,12,32,6,51,0,0,85,3,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,4,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,5,0,12,32,6,51,0,0,85,0,1,0,44,64,86,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,7,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,8,18,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,33,0,12,32,6,51,0,0,85,9,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,10,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,11,0,12,32,6,51,0,0,85,0,1,0,44,64,86,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,13,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,23,51,0,14,85,0,1,0,44,64,0,41,0,0},
+    {0,0,15,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,23,51,0,0,85,0,1,0,44,64,0,41,16,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,17},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,7,0,44,64,0,41,19,0},
+    {0,0,22,28,77,0,20,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,21,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,23,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,7,24,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,25,0,44,68,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,2,18,51,0,0,85,26,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,27,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,61,28,77,0,0,0,12,32,6,51,0,0,85,54,1,0,44,64,29,41,0,0},
+    {0,0,22,28,77,30,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,31,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,45,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,33,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,34,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,35,0,0,12,32,23,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,36,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,37,18,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,33,0,12,32,6,51,0,0,85,38,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,39,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,40,0,12,32,6,51,0,0,85,0,1,0,44,64,86,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,57,28,77,0,0,0,12,42,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,43,22,28,77,0,33,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,45,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,46,0,12,2,18,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,47,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,23,51,48,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,49,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,50,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,52,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,61,28,77,0,0,0,12,32,6,51,0,53,85,54,1,0,44,64,29,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,55,64,0,41,0,0},
+    {0,0,22,28,77,0,56,0,12,32,6,51,0,0,85,0,45,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,23,51,0,0,85,0,1,0,44,58,0,41,0,0},
+    {0,0,22,28,59,0,0,0,12,32,65,51,0,0,85,0,1,71,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,60,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,33,0,12,32,79,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,23,51,0,0,62,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,63,0,0,12,32,6,51,0,0,85,0,1,0,44,64,86,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,65,51,0,0,85,0,1,71,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,66,85,0,7,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,67,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,69,28,77,0,0,0,12,32,65,51,0,0,85,0,1,71,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,70,32,23,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,13,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,72,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,73,0,0,0,12,32,23,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,78,6,51,74,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,75,0,12,32,6,51,0,0,85,0,1,84,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,76,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,78,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,33,0,12,32,79,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,80,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,8,18,51,0,0,85,81,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,82,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,83,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,86,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,87,0,41,0,0},
+    {0,0,22,28,77,0,0,88,12,32,65,51,0,0,85,0,1,71,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,89,51,0,0,85,0,1,0,44,64,0,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,90,0,7,0,44,64,0,41,0,0},
+    {0,0,22,28,77,91,0,0,12,32,6,51,0,0,85,0,1,0,44,64,86,41,0,0},
+    {0,0,22,28,77,0,0,0,12,32,6,51,0,0,85,0,1,0,44,64,0,41,0,0},
+};
+
+// Keywords ending in each state: bit (type - 1), or NAME_KW_TRACKER
+static constexpr uint8_t NAME_KW_OUT[NAME_KW_STATES] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x08,
+    0x00, 0x00, 0x00, 0x90, 0x00, 0x00, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+};
+
+#endif
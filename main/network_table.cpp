@@ -0,0 +1,128 @@
+#include "network_table.h"
+#include <string.h>
+#include <ctype.h>
+
+static int byRssi(const NetworkEntry& a, const NetworkEntry& b) {
+    return b.rssi - a.rssi;
+}
+
+static int byName(const NetworkEntry& a, const NetworkEntry& b) {
+    // Hidden networks sink to the bottom
+    if (a.ssid[0] == '\0' || b.ssid[0] == '\0') return (a.ssid[0] == '\0') - (b.ssid[0] == '\0');
+    for (int i = 0; ; i++) {
+        int ca = tolower((unsigned char)a.ssid[i]);
+        int cb = tolower((unsigned char)b.ssid[i]);
+        if (ca != cb || ca == 0) return ca - cb;
+    }
+}
+
+static int byChannel(const NetworkEntry& a, const NetworkEntry& b) {
+    if (a.channel != b.channel) return a.channel - b.channel;
+    return byRssi(a, b);
+}
+
+static int byLastSeen(const NetworkEntry& a, const NetworkEntry& b) {
+    int32_t d = (int32_t)(b.lastSeen - a.lastSeen);
+    return (d > 0) - (d < 0);
+}
+
+static const SortedIndex<NetworkEntry>::Compare sortCompare[NET_SORT_COUNT] = {
+    byRssi, byName, byChannel, byLastSeen
+};
+
+const char* networkSortName(NetworkSort sort) {
+    static const char* names[NET_SORT_COUNT] = { "RSSI", "NAME", "CH", "SEEN" };
+    return (sort < NET_SORT_COUNT) ? names[sort] : "?";
+}
+
+NetworkTable::NetworkTable() : entries(nullptr), sortKey(NET_SORT_RSSI) {}
+
+size_t NetworkTable::arenaSize(uint16_t cap, uint8_t bits) {
+    // entries | BSSID index | rank order | item ranks
+    return cap * sizeof(NetworkEntry) + MacIndex::storageSize(cap, bits) + 2 * cap * sizeof(uint16_t);
+}
+
+void NetworkTable::attach(void* arena, uint16_t cap, uint8_t bits) {
+    // NetworkEntry holds a uint64_t, so the index storage stays aligned
+    uint8_t* p = (uint8_t*)arena;
+    entries = (NetworkEntry*)p;
+    p += cap * sizeof(NetworkEntry);
+    bssids.attach(p, cap, bits);
+    p += MacIndex::storageSize(cap, bits);
+    uint16_t* orderBuf = (uint16_t*)p;
+    uint16_t* rankBuf = orderBuf + cap;
+
+    index.attach(entries, orderBuf, rankBuf);
+    index.setCompare(sortCompare[sortKey]);
+    clear();
+}
+
+void NetworkTable::clear() {
+    bssids.clear();
+    index.clear();
+}
+
+void NetworkTable::setSort(NetworkSort sort) {
+    if (sort >= NET_SORT_COUNT) return;
+    sortKey = sort;
+    index.setCompare(sortCompare[sort]);
+}
+
+void NetworkTable::removeEntry(uint16_t idx) {
+    // Keep the pool dense: the index moves the last entry into the hole
+    uint16_t moved = bssids.remove(idx);
+    if (moved != idx) entries[idx] = entries[moved];
+    index.remove(idx, moved);
+}
+
+NetworkEntry* NetworkTable::observe(uint64_t key, int8_t rssi, uint32_t now) {
+    if (bssids.getCapacity() == 0) return nullptr;
+
+    NetworkEntry* e;
+    int found = bssids.find(key);
+
+    if (found >= 0) {
+        bssids.touch(found);
+        e = &entries[found];
+    } else {
+        // Full: the BSSID unseen longest is recycled in place
+        bool recycled = bssids.full();
+        uint16_t idx = bssids.insert(key);
+        e = &entries[idx];
+        memset(e, 0, sizeof(*e));
+        e->key = key;
+        e->firstSeen = now;
+        if (!recycled) index.insert(idx);
+    }
+
+    e->rssi = rssi;
+    e->rssiHistory[e->historyHead] = rssi;
+    e->historyHead = (e->historyHead + 1) % NETWORK_RSSI_HISTORY;
+    if (e->historyLen < NETWORK_RSSI_HISTORY) e->historyLen++;
+    if (e->seenCount < 0xFFFF) e->seenCount++;
+    e->lastSeen = now;
+    index.update((uint16_t)(e - entries));
+    return e;
+}
+
+uint16_t NetworkTable::expire(uint32_t now, uint32_t ttlMs) {
+    uint16_t removed = 0;
+
+    // Walk backwards so the entry swapped into a hole was already checked
+    for (int i = (int)bssids.size() - 1; i >= 0; i--) {
+        if (now - entries[i].lastSeen > ttlMs) {
+            removeEntry(i);
+            removed++;
+        }
+    }
+
+    return removed;
+}
+
+int8_t NetworkTable::averageRssi(const NetworkEntry& e) {
+    if (e.historyLen == 0) return e.rssi;
+
+    int sum = 0;
+    for (uint8_t i = 0; i < e.historyLen; i++) sum += e.rssiHistory[i];
+    return (int8_t)(sum / e.historyLen);
+}
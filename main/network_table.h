@@ -0,0 +1,109 @@
+#ifndef NETWORK_TABLE_H
+#define NETWORK_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ieee80211.h"
+#include "mac_index.h"
+#include "sorted_index.h"
+
+// Persistent scan results keyed by packed BSSID. Successive scans merge
+// into the same entry; entries not seen for the TTL are aged out. Looked
+// up through a MacIndex like StationTable, but the storage is handed in
+// once at startup so it can live in PSRAM when the board has it. Entries
+// stay densely packed (swap-with-last on removal) so copies and sorts
+// walk one contiguous block. A SortedIndex keeps the entries ranked by
+// the selected key as they change. Not thread safe.
+
+#define NETWORK_TABLE_CAPACITY 128          // Internal RAM
+#define NETWORK_HASH_BITS 8
+#define NETWORK_TABLE_CAPACITY_PSRAM 1024   // Boards with PSRAM
+#define NETWORK_HASH_BITS_PSRAM 11
+#define NETWORK_RSSI_HISTORY 8              // Sightings kept per BSSID
+#define NETWORK_DEFAULT_TTL_MS 300000       // Forget APs unseen for 5 min
+
+static_assert(NETWORK_TABLE_CAPACITY * 2 <= (1 << NETWORK_HASH_BITS), "Network hash must be at least twice the pool");
+static_assert(NETWORK_TABLE_CAPACITY_PSRAM * 2 <= (1 << NETWORK_HASH_BITS_PSRAM), "Network hash must be at least twice the pool");
+
+struct NetworkEntry {
+    uint64_t key;                // macToKey(bssid)
+    char ssid[33];
+    uint8_t channel;
+    uint8_t encryptionType;
+    int8_t rssi;                 // Latest sighting
+    int8_t rssiHistory[NETWORK_RSSI_HISTORY]; // Ring, newest at historyHead - 1
+    uint8_t historyHead;
+    uint8_t historyLen;
+    uint16_t seenCount;          // Scans that reported this BSSID
+    uint32_t firstSeen;
+    uint32_t lastSeen;
+};
+
+enum NetworkSort {
+    NET_SORT_RSSI,        // Strongest first
+    NET_SORT_NAME,        // SSID, case-insensitive, hidden last
+    NET_SORT_CHANNEL,
+    NET_SORT_LAST_SEEN,   // Most recent first
+    NET_SORT_COUNT
+};
+
+// List filter, cheap enough to run over the whole table every UI tick
+struct NetworkFilter {
+    uint8_t channel;      // 0 = any
+    int8_t minRssi;       // -128 = any
+    uint16_t authMask;    // Bit per encryptionType value, 0 = any
+
+    bool matches(const NetworkEntry& e) const {
+        if (channel != 0 && e.channel != channel) return false;
+        if (e.rssi < minRssi) return false;
+        if (authMask != 0 && !(authMask & (1u << e.encryptionType))) return false;
+        return true;
+    }
+};
+
+static const NetworkFilter NETWORK_FILTER_ALL = {0, -128, 0};
+
+const char* networkSortName(NetworkSort sort);
+
+class NetworkTable {
+public:
+    NetworkTable();
+
+    // Bytes of arena needed for capacity entries and 1 << slotBits hash
+    // slots; slots must be at least twice the capacity
+    static size_t arenaSize(uint16_t capacity, uint8_t slotBits);
+    void attach(void* arena, uint16_t capacity, uint8_t slotBits);
+    void clear();
+
+    // Record one sighting and return the entry for the caller to fill in
+    // SSID/channel/auth, then call reindex(). Recycles the stalest entry
+    // when full; NULL only when no storage is attached.
+    NetworkEntry* observe(uint64_t key, int8_t rssi, uint32_t now);
+    void reindex(const NetworkEntry* e) { index.update((uint16_t)(e - entries)); }
+
+    // Ranked access, order set by setSort()
+    void setSort(NetworkSort sort);
+    NetworkSort getSort() const { return sortKey; }
+    const NetworkEntry& ranked(uint16_t rank) const { return entries[index.at(rank)]; }
+
+    // Drop entries unseen for longer than ttlMs, returns how many
+    uint16_t expire(uint32_t now, uint32_t ttlMs);
+
+    uint16_t size() const { return bssids.size(); }
+    uint16_t getCapacity() const { return bssids.getCapacity(); }
+    uint32_t getEvictions() const { return bssids.getEvictions(); }
+    const NetworkEntry& at(uint16_t idx) const { return entries[idx]; }
+
+    // Mean of the recorded RSSI history
+    static int8_t averageRssi(const NetworkEntry& e);
+
+private:
+    NetworkEntry* entries;
+    MacIndex bssids;
+    SortedIndex<NetworkEntry> index;
+    NetworkSort sortKey;
+
+    void removeEntry(uint16_t idx);
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef OUI_DATA_H
+#define OUI_DATA_H
+
+// Hand-maintained seed, not yet generated from the registry: a subset of
+// the IEEE MA-L assignments for the vendors in tools/oui_vendors.txt, in
+// the layout tools/gen_oui.py writes. Newer blocks (recent Apple and
+// Samsung ranges, for example) are missing. Replace it by running
+// gen_oui.py on a current oui.csv.
+// 278 assignments, 25 vendors.
+
+#include <stdint.h>
+
+static constexpr const char* OUI_VENDOR_NAMES[] = {
+    "Apple",
+    "Samsung",
+    "Google",
+    "Amazon",
+    "Microsoft",
+    "Intel",
+    "Espressif",
+    "Raspberry Pi",
+    "Cisco",
+    "Linksys",
+    "TP-Link",
+    "Netgear",
+    "D-Link",
+    "Ubiquiti",
+    "ASUS",
+    "AVM",
+    "Huawei",
+    "Xiaomi",
+    "Sonos",
+    "Bose",
+    "Nintendo",
+    "Dell",
+    "Realtek",
+    "Broadcom",
+    "Texas Instr",
+};
+
+// (prefix << 8) | index into OUI_VENDOR_NAMES, sorted by prefix
+static constexpr uint32_t OUI_TABLE[] = {
+    0x00000C08, 0x0000F001, 0x00027801, 0x0002B305, 0x00034705, 0x00039300,
+    0x00040E0F, 0x00042305, 0x00050200, 0x00055D0C, 0x00062509, 0x0007AB01,
+    0x0007E905, 0x00091801, 0x00095B0B, 0x0009BF14, 0x000A2700, 0x000A9500,
+    0x000AF717, 0x000C4109, 0x000CF105, 0x000D880C, 0x000D9300, 0x000DAE01,
+    0x000E0C05, 0x000E3505, 0x000E5812, 0x000F3D0C, 0x00101817, 0x0010FA00,
+    0x00111105, 0x00112400, 0x0011950C, 0x00121709, 0x00124701, 0x00124B18,
+    0x0012F005, 0x0012FB01, 0x00130205, 0x00131009, 0x00132005, 0x0013460C,
+    0x00137701, 0x0013CE05, 0x0013E805, 0x00142215, 0x00145100, 0x00146C0B,
+    0x0014BF09, 0x00150005, 0x00151705, 0x00155D04, 0x00159901, 0x0015B901,
+    0x0015E90C, 0x00163201, 0x00166B01, 0x00166C01, 0x00166F05, 0x00167605,
+    0x0016B609, 0x0016CB00, 0x0016DB01, 0x0016EA05, 0x0016EB05, 0x00179A0C,
+    0x0017AB14, 0x0017C901, 0x0017D501, 0x0017F200, 0x00183909, 0x00188210,
+    0x0018AF01, 0x0018DE05, 0x0018F809, 0x00191D14, 0x00195B0C, 0x0019D105,
+    0x0019D205, 0x0019E300, 0x001A7009, 0x001A8A01, 0x001A920E, 0x001B110C,
+    0x001B2105, 0x001B2F0B, 0x001B6300, 0x001B7705, 0x001B9801, 0x001C1009,
+    0x001C4301, 0x001CB300, 0x001CBF05, 0x001CF00C, 0x001D2501, 0x001D4F00,
+    0x001D600E, 0x001D7E09, 0x001DE005, 0x001DE105, 0x001DF601, 0x001E1010,
+    0x001E2A0B, 0x001E4F15, 0x001E5200, 0x001E580C, 0x001E6405, 0x001E6505,
+    0x001E6705, 0x001E7D01, 0x001E8C0E, 0x001EC200, 0x001EE101, 0x001EE201,
+    0x001EE509, 0x001F3214, 0x001F3B05, 0x001F3C05, 0x001F5B00, 0x001FCC01,
+    0x001FCD01, 0x001FF300, 0x00211901, 0x00212909, 0x00214C01, 0x0021910C,
+    0x0021D101, 0x0021D201, 0x0021E900, 0x0022150E, 0x00223F0B, 0x00224100,
+    0x00224C14, 0x00226B09, 0x0022B00C, 0x00231200, 0x00233200, 0x00233901,
+    0x00233A01, 0x00236909, 0x00236C00, 0x00239901, 0x0023D601, 0x0023D701,
+    0x0023DF00, 0x0024010C, 0x00241E14, 0x00243600, 0x00245401, 0x00249001,
+    0x00249101, 0x0024B20B, 0x0024E901, 0x00250000, 0x00254B00, 0x00256601,
+    0x00256701, 0x00259C09, 0x0025BC00, 0x00260800, 0x0026180E, 0x00263701,
+    0x00264A00, 0x00265A0C, 0x00265D01, 0x00265F01, 0x0026B000, 0x0026BB00,
+    0x0027220D, 0x0050F204, 0x00E04C16, 0x00E0FC10, 0x0418D60D, 0x0452C713,
+    0x08606E0E, 0x08DF1F13, 0x10BF480E, 0x14CC200A, 0x14D64D0C, 0x14DAE90E,
+    0x18037315, 0x18FE3406, 0x1C7EE50C, 0x204E7F0B, 0x240AC406, 0x2465110F,
+    0x246F2806, 0x24A43C0D, 0x28107B0C, 0x28187804, 0x286C0711, 0x286ED410,
+    0x28C68E0B, 0x28CDC107, 0x2C41A113, 0x2C56DC0E, 0x2CCF6707, 0x30AEA406,
+    0x34CE0011, 0x3810D50F, 0x3C5AB402, 0x3C71BF06, 0x3CA62F0F, 0x40B4CD03,
+    0x40F40714, 0x444E6D0F, 0x44650D03, 0x44D9E70D, 0x4846FB10, 0x4C875D13,
+    0x50465D0E, 0x508F4C11, 0x50C7BF0A, 0x54600902, 0x58BDA314, 0x5C49790F,
+    0x5CAAFD12, 0x5CCF7F06, 0x60019406, 0x60ABD213, 0x60E3270A, 0x64098011,
+    0x6837E903, 0x6872510D, 0x74C24603, 0x7828CA12, 0x788A200D, 0x7C1E5204,
+    0x7C9EBD06, 0x7CFF4D0F, 0x802AA80D, 0x840D8E06, 0x84C9B20C, 0x84D6D003,
+    0x84F3EB06, 0x8CAAB506, 0x9094E40C, 0x949F3E12, 0x98B6E914, 0x98DAC40A,
+    0x9CC7A60F, 0xA040A00B, 0xA4773302, 0xA4CF1206, 0xAC220B0E, 0xAC67B206,
+    0xB827EB07, 0xB8AC6F15, 0xB8E93712, 0xBC05430F, 0xBCDDC206, 0xBCEE7B0E,
+    0xC025060F, 0xC03F0E0B, 0xC04A000A, 0xC80E140F, 0xC82B9606, 0xC8BE190C,
+    0xCC50E306, 0xD4BED915, 0xD83ADD07, 0xDC9FDB0D, 0xDCA63207, 0xE0286D0F,
+    0xE45F0107, 0xEC086B0A, 0xECFABC06, 0xF0272D03, 0xF07D680C, 0xF09FC20D,
+    0xF46D040E, 0xF4F26D0A, 0xF4F5D802, 0xF4F5E802, 0xF8A45F11, 0xF8B15615,
+    0xFC65DE03, 0xFCECDA0D,
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "oui_lookup.h"
+#include "oui_data.h"
+#include <stddef.h>
+
+#define OUI_COUNT (sizeof(OUI_TABLE) / sizeof(OUI_TABLE[0]))
+#define OUI_VENDOR_COUNT (sizeof(OUI_VENDOR_NAMES) / sizeof(OUI_VENDOR_NAMES[0]))
+
+// The search relies on the generator's ordering; check it at compile time
+// (split in halves so the recursion depth stays at log2 of the table size)
+static constexpr bool ouiSorted(size_t lo, size_t hi) {
+    return hi - lo < 2 ||
+           (ouiSorted(lo, lo + (hi - lo) / 2) &&
+            (OUI_TABLE[lo + (hi - lo) / 2 - 1] >> 8) < (OUI_TABLE[lo + (hi - lo) / 2] >> 8) &&
+            ouiSorted(lo + (hi - lo) / 2, hi));
+}
+static_assert(ouiSorted(0, OUI_COUNT), "OUI_TABLE must be sorted by prefix, regenerate oui_data.h");
+
+const char* ouiLookup(uint32_t prefix) {
+    size_t lo = 0;
+    size_t hi = OUI_COUNT;
+    
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        uint32_t p = OUI_TABLE[mid] >> 8;
+        if (p == prefix) {
+            uint8_t vendor = OUI_TABLE[mid] & 0xFF;
+            return vendor < OUI_VENDOR_COUNT ? OUI_VENDOR_NAMES[vendor] : NULL;
+        }
+        if (p < prefix) lo = mid + 1;
+        else hi = mid;
+    }
+    
+    return NULL;
+}
+
+const char* macVendor(const uint8_t* mac) {
+    if (macIsLocal(mac)) return OUI_VENDOR_RANDOM;
+    
+    const char* name = ouiLookup(((uint32_t)mac[0] << 16) | (mac[1] << 8) | mac[2]);
+    return name ? name : OUI_VENDOR_UNKNOWN;
+}
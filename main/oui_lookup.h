@@ -0,0 +1,27 @@
+#ifndef OUI_LOOKUP_H
+#define OUI_LOOKUP_H
+
+#include <stdint.h>
+
+// Vendor lookup by OUI (first three address bytes). oui_data.h holds the
+// table as constexpr arrays in the layout tools/gen_oui.py writes from the
+// IEEE registry (its header says where the current copy came from), so it
+// lives in flash and is read in place; a lookup is a binary search, no
+// allocation.
+
+#define OUI_VENDOR_UNKNOWN ""
+#define OUI_VENDOR_RANDOM "Random"   // Locally administered / private address
+
+// Bit 1 of the first byte: the address was not assigned from an OUI
+// (BLE random addresses, per-SSID virtual BSSIDs, MAC randomisation)
+inline bool macIsLocal(const uint8_t* mac) { return (mac[0] & 0x02) != 0; }
+inline bool macIsMulticast(const uint8_t* mac) { return (mac[0] & 0x01) != 0; }
+
+// Registered vendor for a 24-bit prefix, NULL if not in the table
+const char* ouiLookup(uint32_t prefix);
+
+// Display vendor for an address: registered name, OUI_VENDOR_RANDOM for
+// locally administered addresses, OUI_VENDOR_UNKNOWN otherwise. Never NULL.
+const char* macVendor(const uint8_t* mac);
+
+#endif
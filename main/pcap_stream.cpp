@@ -0,0 +1,76 @@
+#include "pcap_stream.h"
+#include <string.h>
+
+static inline void put16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static inline void put32(uint8_t* p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = v >> 24;
+}
+
+static uint16_t fletcher16(const uint8_t* data, size_t len) {
+    uint16_t a = 0, b = 0;
+    for (size_t i = 0; i < len; i++) {
+        a = (a + data[i]) % 255;
+        b = (b + a) % 255;
+    }
+    return (b << 8) | a;
+}
+
+// Wrap payloadLen bytes already written at out + 5 with sync, type, length
+// and checksum. Returns total frame size.
+static size_t finishFrame(uint8_t* out, uint8_t type, size_t payloadLen) {
+    out[0] = PCAP_SYNC0;
+    out[1] = PCAP_SYNC1;
+    out[2] = type;
+    put16(out + 3, (uint16_t)payloadLen);
+    put16(out + 5 + payloadLen, fletcher16(out + 2, payloadLen + 3));
+    return payloadLen + PCAP_FRAME_OVERHEAD;
+}
+
+size_t pcapEncodeGlobalHeader(uint8_t* out, uint16_t snapLen) {
+    uint8_t* p = out + 5;
+    put32(p, 0xA1B2C3D4);         // Magic, microsecond timestamps
+    put16(p + 4, 2);              // Version 2.4
+    put16(p + 6, 4);
+    put32(p + 8, 0);              // GMT offset
+    put32(p + 12, 0);             // Accuracy
+    put32(p + 16, snapLen + PCAP_RADIOTAP_LEN);
+    put32(p + 20, PCAP_LINKTYPE_RADIOTAP);
+    return finishFrame(out, PCAP_FRAME_HEADER, PCAP_GLOBAL_HEADER_LEN);
+}
+
+size_t pcapEncodeRecord(const PcapSlot& slot, uint8_t* out) {
+    uint8_t* p = out + 5;
+    uint16_t capLen = slot.capLen > PCAP_MAX_SNAPLEN ? PCAP_MAX_SNAPLEN : slot.capLen;
+
+    // pcap record header
+    put32(p, slot.tsSec);
+    put32(p + 4, slot.tsUsec);
+    put32(p + 8, capLen + PCAP_RADIOTAP_LEN);
+    put32(p + 12, slot.origLen + PCAP_RADIOTAP_LEN);
+    p += PCAP_RECORD_HEADER_LEN;
+
+    // Radiotap: Flags, Channel, dBm antenna signal
+    uint16_t freq = (slot.channel == 14) ? 2484 : 2407 + 5 * slot.channel;
+    p[0] = 0;                                   // Version
+    p[1] = 0;                                   // Pad
+    put16(p + 2, PCAP_RADIOTAP_LEN);
+    put32(p + 4, (1 << 1) | (1 << 3) | (1 << 5));
+    p[8] = capLen < slot.origLen ? 0 : 0x10;    // FCS present, unless snapped off
+    p[9] = 0;                                   // Align channel to 2 bytes
+    put16(p + 10, freq);
+    put16(p + 12, 0x0080);                      // 2 GHz spectrum
+    p[14] = (uint8_t)slot.rssi;
+    p += PCAP_RADIOTAP_LEN;
+
+    memcpy(p, slot.data, capLen);
+
+    return finishFrame(out, PCAP_FRAME_PACKET,
+                       PCAP_RECORD_HEADER_LEN + PCAP_RADIOTAP_LEN + capLen);
+}
@@ -0,0 +1,53 @@
+#ifndef PCAP_STREAM_H
+#define PCAP_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// PCAP export over a byte stream (Serial). Frames are copied by the RX
+// callback into fixed PcapSlot records; the TX task encodes each one as a
+// pcap record with a small radiotap header and wraps it in a sync frame so
+// the host can resync after any plain-text Serial output:
+//
+//   0xA5 0x5A | type (1) | length (2, LE) | payload | fletcher16 (2, LE)
+//
+// PCAP_FRAME_HEADER carries the pcap global header (re-sent periodically),
+// PCAP_FRAME_PACKET carries one pcap record. tools/pcap_reader.py strips
+// the framing and writes a regular .pcap file.
+
+#define PCAP_MAX_SNAPLEN 256     // Upper bound for the configurable snap length
+#define PCAP_DEFAULT_SNAPLEN 128
+#define PCAP_RING_SIZE 32        // Must be a power of two
+#define PCAP_SERIAL_BAUD 921600
+
+#define PCAP_SYNC0 0xA5
+#define PCAP_SYNC1 0x5A
+#define PCAP_FRAME_HEADER 1
+#define PCAP_FRAME_PACKET 2
+
+#define PCAP_LINKTYPE_RADIOTAP 127
+#define PCAP_RADIOTAP_LEN 15
+#define PCAP_FRAME_OVERHEAD 7    // sync + type + length + checksum
+#define PCAP_RECORD_HEADER_LEN 16
+#define PCAP_GLOBAL_HEADER_LEN 24
+#define PCAP_FRAME_MAX (PCAP_FRAME_OVERHEAD + PCAP_RECORD_HEADER_LEN + PCAP_RADIOTAP_LEN + PCAP_MAX_SNAPLEN)
+
+// One captured frame, filled in place by the RX callback
+struct PcapSlot {
+    uint32_t tsSec;
+    uint32_t tsUsec;
+    uint16_t origLen;   // Length on air (incl. FCS)
+    uint16_t capLen;    // Bytes actually kept in data[]
+    int8_t rssi;
+    uint8_t channel;
+    uint8_t data[PCAP_MAX_SNAPLEN];
+};
+
+// Encode a framed pcap global header, returns bytes written to out
+size_t pcapEncodeGlobalHeader(uint8_t* out, uint16_t snapLen);
+
+// Encode a framed pcap record (radiotap + 802.11), returns bytes written.
+// out must hold PCAP_FRAME_MAX bytes.
+size_t pcapEncodeRecord(const PcapSlot& slot, uint8_t* out);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef RATE_WINDOW_H
+#define RATE_WINDOW_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Sliding one-second event counter: a ring of 100 ms buckets plus a
+// running sum. Advancing clears each elapsed bucket exactly once, so the
+// cost is O(1) amortised per event however long the window sat idle.
+// Timestamps slightly older than the newest bucket (queued events) count
+// towards the newest bucket. Header-only, no platform dependencies.
+
+#define RATE_BUCKET_COUNT 10
+#define RATE_BUCKET_MS 100
+#define RATE_WINDOW_MS (RATE_BUCKET_COUNT * RATE_BUCKET_MS)
+
+class RateWindow {
+public:
+    RateWindow() { reset(0); }
+
+    void reset(uint32_t now) {
+        memset(buckets, 0, sizeof(buckets));
+        tick = now / RATE_BUCKET_MS;
+        sum = 0;
+    }
+
+    // Count one event, returns events in the last second
+    uint32_t add(uint32_t now) {
+        advance(now);
+        uint16_t& b = buckets[tick % RATE_BUCKET_COUNT];
+        if (b < 0xFFFF) {
+            b++;
+            sum++;
+        }
+        return sum;
+    }
+
+    // Events in the last second
+    uint32_t count(uint32_t now) {
+        advance(now);
+        return sum;
+    }
+
+private:
+    uint16_t buckets[RATE_BUCKET_COUNT];
+    uint32_t tick;   // Bucket number (time / RATE_BUCKET_MS) of the newest bucket
+    uint32_t sum;
+
+    void advance(uint32_t now) {
+        uint32_t t = now / RATE_BUCKET_MS;
+        int32_t steps = (int32_t)(t - tick);
+        if (steps <= 0) return;
+
+        if (steps >= RATE_BUCKET_COUNT) {
+            memset(buckets, 0, sizeof(buckets));
+            sum = 0;
+        } else {
+            for (int32_t i = 1; i <= steps; i++) {
+                uint16_t& b = buckets[(tick + i) % RATE_BUCKET_COUNT];
+                sum -= b;
+                b = 0;
+            }
+        }
+        tick = t;
+    }
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "rssi_stats.h"
+#include <string.h>
+
+RssiWindow::RssiWindow(uint16_t period) : periodMs(period) {
+    reset(0);
+}
+
+void RssiWindow::reset(uint32_t now) {
+    bucketEnd = now + periodMs;
+    count = 0;
+    sum = 0;
+    min = 0;
+    max = RSSI_FLOOR;
+    memset(bins, 0, sizeof(bins));
+    memset(&summary, 0, sizeof(summary));
+}
+
+void RssiWindow::add(int8_t rssi, uint32_t now) {
+    roll(now);
+
+    if (rssi > max) max = rssi;
+    if (rssi < min) min = rssi;
+    sum += rssi;
+    count++;
+
+    int bin = (rssi - RSSI_FLOOR) / RSSI_BIN_DB;
+    if (bin < 0) bin = 0;
+    if (bin >= RSSI_BIN_COUNT) bin = RSSI_BIN_COUNT - 1;
+    if (bins[bin] != 0xFFFF) bins[bin]++;
+}
+
+bool RssiWindow::roll(uint32_t now) {
+    if ((int32_t)(now - bucketEnd) < 0) return false;
+
+    summary.count = count;
+    if (count > 0) {
+        summary.min = min;
+        summary.max = max;
+        summary.mean = (int8_t)(sum / (int32_t)count);
+
+        // Walk up from the weak end until 90% of frames are covered
+        uint32_t target = count - count / 10;
+        uint32_t seen = 0;
+        int bin = 0;
+        for (; bin < RSSI_BIN_COUNT - 1; bin++) {
+            seen += bins[bin];
+            if (seen >= target) break;
+        }
+        int p90 = RSSI_FLOOR + bin * RSSI_BIN_DB + RSSI_BIN_DB / 2;
+        summary.p90 = (int8_t)(p90 > max ? max : p90);
+    } else {
+        summary.min = summary.max = summary.mean = summary.p90 = RSSI_FLOOR;
+    }
+
+    // Skip whole periods that passed without a call, keep the phase
+    bucketEnd += ((now - bucketEnd) / periodMs + 1) * periodMs;
+    count = 0;
+    sum = 0;
+    min = 0;
+    max = RSSI_FLOOR;
+    memset(bins, 0, sizeof(bins));
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef RSSI_STATS_H
+#define RSSI_STATS_H
+
+#include <stdint.h>
+
+// Fixed time-bucket RSSI aggregation. Frames are folded into a small
+// 2 dB histogram instead of being stored, so min/max/mean/p90 cost the
+// same at 10 or 10,000 frames per bucket. Owned by a single task.
+
+#define RSSI_FLOOR -100          // Anything weaker lands in the first bin
+#define RSSI_BIN_DB 2
+#define RSSI_BIN_COUNT 50        // -100 .. -1 dBm
+
+struct RssiSummary {
+    uint32_t count;   // Frames in the bucket, 0 = nothing heard
+    int8_t min;
+    int8_t max;
+    int8_t mean;
+    int8_t p90;       // 90% of frames were at or below this level
+};
+
+class RssiWindow {
+public:
+    explicit RssiWindow(uint16_t period);
+
+    // Fold in one frame; closes the current bucket first if it is due
+    void add(int8_t rssi, uint32_t now);
+
+    // Close the current bucket if its period has elapsed, even with no
+    // frames in it. Returns true when a new summary is available.
+    bool roll(uint32_t now);
+
+    void reset(uint32_t now);
+    const RssiSummary& last() const { return summary; }
+
+private:
+    uint16_t periodMs;
+    uint32_t bucketEnd;
+    uint32_t count;
+    int32_t sum;
+    int8_t min;
+    int8_t max;
+    uint16_t bins[RSSI_BIN_COUNT];
+    RssiSummary summary; // Last closed bucket
+};
+
+#endif
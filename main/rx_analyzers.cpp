@@ -0,0 +1,252 @@
+#include "rx_analyzers.h"
+#include "frame_decode.h"
+#include <string.h>
+
+// ==================== TRAFFIC ====================
+
+TrafficAnalyzer::TrafficAnalyzer() : rssiFast(RSSI_FAST_MS), rssiSlow(RSSI_SLOW_MS) {
+    reset(0);
+}
+
+void TrafficAnalyzer::reset(uint32_t nowMs) {
+    memset(&stats, 0, sizeof(stats));
+    stats.rssi = -100;
+    stats.isActive = true;
+    memset(&frames, 0, sizeof(frames));
+    rssiFast.reset(nowMs);
+    rssiSlow.reset(nowMs);
+
+    statsOut.write(stats);
+    framesOut.write(frames);
+}
+
+void TrafficAnalyzer::onFrame(const WiFiEventData& rec) {
+    // RSSI folded into fixed buckets rather than last-frame samples
+    rssiFast.add(rec.rssi, rec.timestamp);
+    rssiSlow.add(rec.rssi, rec.timestamp);
+
+    switch (rec.type) {
+        case PKT_MGMT: stats.mgmtCount++; break;
+        case PKT_DATA: stats.dataCount++; break;
+        case PKT_CTRL: stats.ctrlCount++; break;
+        default: break;
+    }
+    stats.packetCount++;
+
+    // O(1) subtype decode straight off the frame control bits
+    uint16_t fc = rec.frameControl;
+    frames.slots[fcSlot(fc)]++;
+    frames.dsFlags[fcDsBits(fc)]++;
+    if (fcIsRetry(fc)) frames.retries++;
+    frames.total++;
+}
+
+void TrafficAnalyzer::foldRssi() {
+    stats.rssiFast = rssiFast.last();
+    stats.rssiSlow = rssiSlow.last();
+    stats.rssi = stats.rssiSlow.mean;
+}
+
+void TrafficAnalyzer::onBatchEnd(uint32_t nowMs) {
+    // One consistent snapshot per batch; readers never block us
+    foldRssi();
+    statsOut.write(stats);
+    framesOut.write(frames);
+}
+
+void TrafficAnalyzer::onIdle(uint32_t nowMs) {
+    // Close buckets on time even when the channel goes quiet
+    bool fastRolled = rssiFast.roll(nowMs);
+    bool slowRolled = rssiSlow.roll(nowMs);
+    if (fastRolled || slowRolled) {
+        foldRssi();
+        statsOut.write(stats);
+    }
+}
+
+// ==================== STATIONS ====================
+
+void StationAnalyzer::reset(uint32_t nowMs) {
+    table.clear();
+    lastPublish = nowMs;
+
+    TopTalkers none;
+    memset(&none, 0, sizeof(none));
+    talkersOut.write(none);
+}
+
+void StationAnalyzer::onFrame(const WiFiEventData& rec) {
+    // CTS/ACK and truncated frames carry no transmitter address
+    if (!(rec.flags & RX_REC_TA)) return;
+
+    table.update(macToKey(rec.bssid), rec.rssi, rec.channel, rec.timestamp);
+}
+
+void StationAnalyzer::onIdle(uint32_t nowMs) {
+    // Ranking walks the whole table, so only refresh it at UI rate
+    if (nowMs - lastPublish < TALKERS_PUBLISH_MS) return;
+    lastPublish = nowMs;
+
+    TopTalkers talkers;
+    table.topTalkers(talkers);
+    talkersOut.write(talkers);
+}
+
+// ==================== SPECTROGRAM ====================
+
+void SpectrogramAnalyzer::reset(uint32_t nowMs) {
+    spectrogram.reset();
+    lastTick = nowMs;
+    for (int i = 0; i < HOP_CHANNEL_COUNT; i++) {
+        base[i] = channelFrames[i + HOP_FIRST_CHANNEL].load(std::memory_order_relaxed);
+    }
+}
+
+void SpectrogramAnalyzer::onIdle(uint32_t nowMs) {
+    if (nowMs - lastTick < SPECTRO_TICK_MS) return;
+    lastTick += SPECTRO_TICK_MS;
+
+    uint8_t row[HOP_CHANNEL_COUNT];
+    for (int i = 0; i < HOP_CHANNEL_COUNT; i++) {
+        uint32_t now = channelFrames[i + HOP_FIRST_CHANNEL].load(std::memory_order_relaxed);
+        row[i] = spectroLevel(now - base[i]);
+        base[i] = now;
+    }
+    spectrogram.appendRow(row);
+}
+
+// ==================== DEAUTH ====================
+
+DeauthAnalyzer::DeauthAnalyzer()
+    : lastAnalytics(0), publishedEvents(0), historyCount(0) {
+    pendingThresholds.write(DEAUTH_DEFAULT_THRESHOLDS);
+    statsOut.write(detector.getStats());
+    publishAnalytics(0);
+}
+
+void DeauthAnalyzer::reset(uint32_t nowMs) {
+    // Keep the old thresholds if the writer keeps racing us
+    DeauthThresholds t;
+    if (pendingThresholds.tryRead(t)) detector.setThresholds(t);
+    detector.reset();
+    historyCount.store(0, std::memory_order_release);
+    statsOut.write(detector.getStats());
+    publishAnalytics(nowMs);
+}
+
+void DeauthAnalyzer::publishAnalytics(uint32_t nowMs) {
+    DeauthAnalytics a;
+    detector.getAnalytics(a);
+    analyticsOut.write(a);
+    publishedEvents = a.events;
+    lastAnalytics = nowMs;
+}
+
+void DeauthAnalyzer::onFrame(const WiFiEventData& rec) {
+    DeauthEvent event;
+    if (!deauthFromRecord(rec, event)) return;
+
+    detector.onDeauth(event);
+
+    uint32_t n = historyCount.load(std::memory_order_relaxed);
+    HistoryEntry entry = {n, event};
+    history[n % DEAUTH_HISTORY_SIZE].write(entry);
+    historyCount.store(n + 1, std::memory_order_release);
+}
+
+bool DeauthAnalyzer::readHistory(int age, DeauthEvent& out) const {
+    uint32_t n = historyCount.load(std::memory_order_acquire);
+    if (age < 0 || age >= DEAUTH_HISTORY_SIZE || (uint32_t)age >= n) return false;
+
+    uint32_t want = n - 1 - age;
+    HistoryEntry entry;
+    if (!history[want % DEAUTH_HISTORY_SIZE].tryRead(entry) || entry.index != want) return false;
+
+    out = entry.event;
+    return true;
+}
+
+int DeauthAnalyzer::historySize() const {
+    uint32_t n = historyCount.load(std::memory_order_acquire);
+    return n < DEAUTH_HISTORY_SIZE ? n : DEAUTH_HISTORY_SIZE;
+}
+
+void DeauthAnalyzer::onBatchEnd(uint32_t nowMs) {
+    statsOut.write(detector.getStats());
+}
+
+void DeauthAnalyzer::onIdle(uint32_t nowMs) {
+    // Windows slide and the alert expires even when nothing arrives
+    if (detector.tick(nowMs)) {
+        statsOut.write(detector.getStats());
+    }
+
+    // Rankings walk the client table, so only at UI rate and when moved
+    if (nowMs - lastAnalytics >= DEAUTH_ANALYTICS_MS &&
+        detector.eventCount() != publishedEvents) {
+        publishAnalytics(nowMs);
+    }
+}
+
+// ==================== BEACON FLOOD ====================
+
+BeaconFloodAnalyzer::BeaconFloodAnalyzer() {
+    pendingThresholds.write(DEAUTH_DEFAULT_THRESHOLDS);
+    statsOut.write(detector.getStats());
+}
+
+void BeaconFloodAnalyzer::reset(uint32_t nowMs) {
+    DeauthThresholds t;
+    if (pendingThresholds.tryRead(t)) detector.setThresholds(t.beaconBssidsPerSec, t.holdMs);
+    detector.reset(nowMs);
+    statsOut.write(detector.getStats());
+}
+
+void BeaconFloodAnalyzer::onFrame(const WiFiEventData& rec) {
+    if (!(rec.flags & RX_REC_TA)) return;
+    detector.onBeacon(macToKey(rec.bssid), rec.timestamp);
+}
+
+void BeaconFloodAnalyzer::onBatchEnd(uint32_t nowMs) {
+    statsOut.write(detector.getStats());
+}
+
+void BeaconFloodAnalyzer::onIdle(uint32_t nowMs) {
+    if (detector.tick(nowMs)) {
+        statsOut.write(detector.getStats());
+    }
+}
+
+// ==================== EVIL TWIN ====================
+
+TwinAnalyzer::TwinAnalyzer() : pendingHoldMs(DEAUTH_DEFAULT_THRESHOLDS.holdMs), publishedConflicts(0), publishedSsids(0) {
+    statsOut.write(detector.getStats());
+}
+
+void TwinAnalyzer::reset(uint32_t nowMs) {
+    detector.setHoldMs(pendingHoldMs.load(std::memory_order_relaxed));
+    detector.reset();
+    publishedConflicts = 0;
+    publishedSsids = 0;
+    statsOut.write(detector.getStats());
+}
+
+void TwinAnalyzer::onFrame(const WiFiEventData& rec) {
+    detector.onBeacon(rec);
+}
+
+void TwinAnalyzer::onBatchEnd(uint32_t nowMs) {
+    // Beacons mostly refresh known APs; only publish when something moved
+    const TwinStats& st = detector.getStats();
+    if (st.conflicts != publishedConflicts || st.ssidsTracked != publishedSsids) {
+        publishedConflicts = st.conflicts;
+        publishedSsids = st.ssidsTracked;
+        statsOut.write(st);
+    }
+}
+
+void TwinAnalyzer::onIdle(uint32_t nowMs) {
+    if (detector.tick(nowMs)) {
+        statsOut.write(detector.getStats());
+    }
+}
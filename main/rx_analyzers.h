@@ -0,0 +1,185 @@
+#ifndef RX_ANALYZERS_H
+#define RX_ANALYZERS_H
+
+#include <stdint.h>
+#include <atomic>
+#include "rx_pipeline.h"
+#include "seqlock.h"
+#include "rssi_stats.h"
+#include "station_table.h"
+#include "spectrogram.h"
+#include "channel_hopper.h"
+#include "deauth_detector.h"
+#include "beacon_flood.h"
+#include "twin_detector.h"
+
+// The analyzers behind the Traffic and Deauth Detect pages. Each one owns its
+// state on the RX consumer task and publishes lock-free snapshots the UI
+// reads whenever it likes.
+
+#define SPECTRO_ROWS 64          // Time slices kept, must be a power of two
+#define SPECTRO_TICK_MS 250      // One spectrogram row per tick
+#define RSSI_FAST_MS 50          // RSSI buckets: UI refresh rate
+#define RSSI_SLOW_MS 1000        // and a steadier one-second view
+#define TALKERS_PUBLISH_MS 250   // Top talkers ranking refresh
+#define DEAUTH_HISTORY_SIZE 20
+#define DEAUTH_ANALYTICS_MS 250  // Reason/target rankings refresh
+
+// Frame counts, subtype histogram and RSSI buckets
+class TrafficAnalyzer : public RxAnalyzer {
+public:
+    TrafficAnalyzer();
+
+    const char* name() const { return "Traffic"; }
+    void reset(uint32_t nowMs);
+    void onFrame(const WiFiEventData& rec);
+    void onBatchEnd(uint32_t nowMs);
+    void onIdle(uint32_t nowMs);
+
+    // Any task; false if the writer kept racing the read
+    bool readStats(WiFiStats& out) const { return statsOut.tryRead(out); }
+    bool readFrames(FrameHistogram& out) const { return framesOut.tryRead(out); }
+
+private:
+    WiFiStats stats;
+    FrameHistogram frames;
+    RssiWindow rssiFast;
+    RssiWindow rssiSlow;
+    Seqlock<WiFiStats> statsOut;
+    Seqlock<FrameHistogram> framesOut;
+
+    void foldRssi();
+};
+
+// Per-transmitter table and its top talkers
+class StationAnalyzer : public RxAnalyzer {
+public:
+    StationAnalyzer() : lastPublish(0) {}
+
+    const char* name() const { return "Stations"; }
+    void reset(uint32_t nowMs);
+    void onFrame(const WiFiEventData& rec);
+    void onIdle(uint32_t nowMs);
+
+    bool readTopTalkers(TopTalkers& out) const { return talkersOut.tryRead(out); }
+
+private:
+    StationTable table;
+    uint32_t lastPublish;
+    Seqlock<TopTalkers> talkersOut;
+};
+
+// Time x channel heatmap. No per-frame work: rows come from the
+// per-channel counters the RX callback already bumps.
+class SpectrogramAnalyzer : public RxAnalyzer {
+public:
+    // channelFrames is indexed by channel, as kept by WiFiHandler
+    explicit SpectrogramAnalyzer(const std::atomic<uint32_t>* channelFrames)
+        : channelFrames(channelFrames), lastTick(0) {}
+
+    const char* name() const { return "Spectro"; }
+    void reset(uint32_t nowMs);
+    void onFrame(const WiFiEventData& rec) {}
+    void onIdle(uint32_t nowMs);
+
+    const Spectrogram<SPECTRO_ROWS, HOP_CHANNEL_COUNT>& rows() const { return spectrogram; }
+
+private:
+    const std::atomic<uint32_t>* channelFrames;
+    uint32_t lastTick;
+    uint32_t base[HOP_CHANNEL_COUNT];
+    Spectrogram<SPECTRO_ROWS, HOP_CHANNEL_COUNT> spectrogram;
+};
+
+// Deauth/disassoc flood detection, triage aggregates and a short event
+// history
+class DeauthAnalyzer : public RxAnalyzer {
+public:
+    DeauthAnalyzer();
+
+    // One writer task at a time; taken over by the next reset(), which
+    // may already be running on the consumer
+    void setThresholds(const DeauthThresholds& t) { pendingThresholds.write(t); }
+
+    const char* name() const { return "Deauth"; }
+    void reset(uint32_t nowMs);
+    void onFrame(const WiFiEventData& rec);
+    void onBatchEnd(uint32_t nowMs);
+    void onIdle(uint32_t nowMs);
+
+    bool readStats(DeauthStats& out) const { return statsOut.tryRead(out); }
+    bool readAnalytics(DeauthAnalytics& out) const { return analyticsOut.tryRead(out); }
+
+    // Any task, one event at a time straight out of the ring; age 0 is
+    // the newest. False past the oldest kept event, or when the slot was
+    // overwritten under the reader.
+    bool readHistory(int age, DeauthEvent& out) const;
+    int historySize() const;
+
+private:
+    // Index tells a reader whether the slot still holds the event it wanted
+    struct HistoryEntry {
+        uint32_t index;
+        DeauthEvent event;
+    };
+
+    Seqlock<DeauthThresholds> pendingThresholds;
+    DeauthDetector detector;
+    Seqlock<DeauthStats> statsOut;
+    Seqlock<DeauthAnalytics> analyticsOut;
+    uint32_t lastAnalytics;
+    uint32_t publishedEvents;
+
+    // Each slot is its own seqlock; historyCount is bumped after the write
+    Seqlock<HistoryEntry> history[DEAUTH_HISTORY_SIZE];
+    std::atomic<uint32_t> historyCount;
+
+    void publishAnalytics(uint32_t nowMs);
+};
+
+// Distinct BSSIDs beaconing per second
+class BeaconFloodAnalyzer : public RxAnalyzer {
+public:
+    BeaconFloodAnalyzer();
+
+    // As DeauthAnalyzer::setThresholds
+    void setThresholds(const DeauthThresholds& t) { pendingThresholds.write(t); }
+
+    const char* name() const { return "Beacons"; }
+    void reset(uint32_t nowMs);
+    void onFrame(const WiFiEventData& rec);
+    void onBatchEnd(uint32_t nowMs);
+    void onIdle(uint32_t nowMs);
+
+    bool readStats(BeaconFloodStats& out) const { return statsOut.tryRead(out); }
+
+private:
+    Seqlock<DeauthThresholds> pendingThresholds;
+    BeaconFloodDetector detector;
+    Seqlock<BeaconFloodStats> statsOut;
+};
+
+// SSIDs advertised by conflicting BSSIDs. Needs the beacon body decoded.
+class TwinAnalyzer : public RxAnalyzer {
+public:
+    TwinAnalyzer();
+
+    void setThresholds(const DeauthThresholds& t) { pendingHoldMs.store(t.holdMs, std::memory_order_relaxed); }
+
+    const char* name() const { return "Twins"; }
+    void reset(uint32_t nowMs);
+    void onFrame(const WiFiEventData& rec);
+    void onBatchEnd(uint32_t nowMs);
+    void onIdle(uint32_t nowMs);
+
+    bool readStats(TwinStats& out) const { return statsOut.tryRead(out); }
+
+private:
+    std::atomic<uint16_t> pendingHoldMs;
+    TwinDetector detector;
+    uint32_t publishedConflicts;
+    uint16_t publishedSsids;
+    Seqlock<TwinStats> statsOut;
+};
+
+#endif
@@ -0,0 +1,134 @@
+#include "rx_pipeline.h"
+
+RxPipeline::RxPipeline(ClockUs clock)
+    : clock(clock), analyzerCount(0) {
+    wanted.store(0);
+    bodyWanted.store(0);
+    for (int i = 0; i < RX_MAX_ANALYZERS; i++) {
+        slots[i].analyzer = nullptr;
+        slots[i].mask = 0;
+        slots[i].bodyMask = 0;
+        slots[i].enabled.store(false, std::memory_order_relaxed);
+        slots[i].resetPending.store(false, std::memory_order_relaxed);
+        slots[i].frames.store(0, std::memory_order_relaxed);
+        slots[i].busyUs.store(0, std::memory_order_relaxed);
+        slots[i].maxPassUs.store(0, std::memory_order_relaxed);
+    }
+}
+
+int RxPipeline::add(RxAnalyzer* analyzer, uint64_t slotMask, uint64_t bodyMask) {
+    if (analyzerCount >= RX_MAX_ANALYZERS) return -1;
+
+    slots[analyzerCount].analyzer = analyzer;
+    slots[analyzerCount].mask = slotMask;
+    slots[analyzerCount].bodyMask = bodyMask & slotMask;
+    return analyzerCount++;
+}
+
+void RxPipeline::setEnabled(int id, bool enabled) {
+    if (id < 0 || id >= analyzerCount) return;
+
+    Slot& s = slots[id];
+    if (s.enabled.load(std::memory_order_relaxed) == enabled) return;
+
+    // Reset is flagged first so the consumer never sees the analyzer
+    // enabled with last session's state
+    if (enabled) s.resetPending.store(true, std::memory_order_release);
+    s.enabled.store(enabled, std::memory_order_release);
+    updateMask();
+}
+
+bool RxPipeline::isEnabled(int id) const {
+    if (id < 0 || id >= analyzerCount) return false;
+    return slots[id].enabled.load(std::memory_order_acquire);
+}
+
+bool RxPipeline::anyEnabled() const {
+    for (int i = 0; i < analyzerCount; i++) {
+        if (slots[i].enabled.load(std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+void RxPipeline::requestReset(int id) {
+    if (id < 0 || id >= analyzerCount) return;
+    slots[id].resetPending.store(true, std::memory_order_release);
+}
+
+void RxPipeline::updateMask() {
+    uint64_t mask = 0;
+    uint64_t body = 0;
+    for (int i = 0; i < analyzerCount; i++) {
+        if (!slots[i].enabled.load(std::memory_order_relaxed)) continue;
+        mask |= slots[i].mask;
+        body |= slots[i].bodyMask;
+    }
+    wanted.store(mask);
+    bodyWanted.store(body);
+}
+
+// Enabled, with any pending reset done
+bool RxPipeline::ready(Slot& s, uint32_t nowMs) {
+    if (!s.enabled.load(std::memory_order_acquire)) return false;
+
+    if (s.resetPending.load(std::memory_order_acquire)) {
+        s.resetPending.store(false, std::memory_order_relaxed);
+        s.analyzer->reset(nowMs);
+        s.frames.store(0, std::memory_order_relaxed);
+        s.busyUs.store(0, std::memory_order_relaxed);
+        s.maxPassUs.store(0, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void RxPipeline::charge(Slot& s, uint32_t frames, uint32_t us) {
+    s.frames.store(s.frames.load(std::memory_order_relaxed) + frames, std::memory_order_relaxed);
+    s.busyUs.store(s.busyUs.load(std::memory_order_relaxed) + us, std::memory_order_relaxed);
+    if (us > s.maxPassUs.load(std::memory_order_relaxed)) {
+        s.maxPassUs.store(us, std::memory_order_relaxed);
+    }
+}
+
+void RxPipeline::dispatch(const WiFiEventData* batch, size_t count, uint32_t nowMs) {
+    // Analyzer-major so each one runs its loop hot and gets timed once
+    for (int a = 0; a < analyzerCount; a++) {
+        Slot& s = slots[a];
+        if (!ready(s, nowMs)) continue;
+
+        uint32_t t0 = clock();
+        uint32_t delivered = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (!(s.mask & rxSlotBit(fcSlot(batch[i].frameControl)))) continue;
+            s.analyzer->onFrame(batch[i]);
+            delivered++;
+        }
+        if (delivered == 0) continue;
+
+        s.analyzer->onBatchEnd(nowMs);
+        charge(s, delivered, clock() - t0);
+    }
+}
+
+void RxPipeline::idle(uint32_t nowMs) {
+    for (int a = 0; a < analyzerCount; a++) {
+        Slot& s = slots[a];
+        if (!ready(s, nowMs)) continue;
+
+        uint32_t t0 = clock();
+        s.analyzer->onIdle(nowMs);
+        charge(s, 0, clock() - t0);
+    }
+}
+
+void RxPipeline::getStats(int id, AnalyzerStats& out) const {
+    out = {};
+    if (id < 0 || id >= analyzerCount) return;
+
+    const Slot& s = slots[id];
+    out.name = s.analyzer->name();
+    out.enabled = s.enabled.load(std::memory_order_relaxed);
+    out.frames = s.frames.load(std::memory_order_relaxed);
+    out.busyUs = s.busyUs.load(std::memory_order_relaxed);
+    out.maxPassUs = s.maxPassUs.load(std::memory_order_relaxed);
+    out.nsPerFrame = out.frames ? (uint32_t)((uint64_t)out.busyUs * 1000 / out.frames) : 0;
+}
@@ -0,0 +1,124 @@
+#ifndef RX_PIPELINE_H
+#define RX_PIPELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "shared_types.h"
+
+// Fan-out behind the single promiscuous RX callback. The callback decodes
+// each frame once into a WiFiEventData record; the consumer task hands
+// each batch to every enabled analyzer in registration order. Analyzers
+// declare the frame slots they care about (type << 4 | subtype, see
+// ieee80211.h) and the union of the enabled masks decides what the
+// callback queues and which frame classes the radio lets through, so an
+// extra analyzer only adds its own per-frame work. The same goes for the
+// beacon body: its IEs are only parsed while an analyzer asks for them.
+// No Arduino/FreeRTOS dependencies: time comes in as arguments and through
+// a clock hook.
+
+#define RX_SLOTS_MGMT 0x000000000000FFFFULL
+#define RX_SLOTS_CTRL 0x00000000FFFF0000ULL
+#define RX_SLOTS_DATA 0x0000FFFF00000000ULL
+#define RX_SLOTS_ALL  0xFFFFFFFFFFFFFFFFULL
+
+inline uint64_t rxSlotBit(uint8_t slot) { return 1ULL << slot; }
+
+// One consumer of decoded frames. Every method runs on the consumer task.
+class RxAnalyzer {
+public:
+    virtual ~RxAnalyzer() {}
+
+    // Short label for the cost view
+    virtual const char* name() const = 0;
+
+    // Start over: called before the first frame after enabling, and on
+    // requestReset()
+    virtual void reset(uint32_t nowMs) = 0;
+
+    virtual void onFrame(const WiFiEventData& rec) = 0;
+
+    // After each batch this analyzer took part in, e.g. to publish
+    virtual void onBatchEnd(uint32_t nowMs) {}
+
+    // Once per consumer pass, frames or not, for time-driven work
+    virtual void onIdle(uint32_t nowMs) {}
+};
+
+class RxPipeline {
+public:
+    typedef uint32_t (*ClockUs)();
+
+    explicit RxPipeline(ClockUs clock);
+
+    // Registration happens once at startup, before the consumer runs.
+    // bodyMask lists the slots whose body must be decoded for it (see
+    // decodeRxFrame). Returns the analyzer id, or -1 when the registry is full.
+    int add(RxAnalyzer* analyzer, uint64_t slotMask, uint64_t bodyMask = 0);
+
+    // Any task. Enabling queues a reset for the consumer to run first.
+    void setEnabled(int id, bool enabled);
+    bool isEnabled(int id) const;
+    bool anyEnabled() const;
+    void requestReset(int id);
+
+    // Union of the enabled analyzers' slots
+    uint64_t slotMask() const { return wanted.load(); }
+
+    // RX callback side: should a frame in this slot be queued at all,
+    // and does anyone need its body decoded
+    bool wants(uint8_t slot) const { return wanted.test(slot); }
+    bool wantsBody(uint8_t slot) const { return bodyWanted.test(slot); }
+
+    // Consumer side
+    void dispatch(const WiFiEventData* batch, size_t count, uint32_t nowMs);
+    void idle(uint32_t nowMs);
+
+    int count() const { return analyzerCount; }
+    void getStats(int id, AnalyzerStats& out) const;
+
+private:
+    // 64 slot bits as two words, so the callback can read them lock-free
+    // on a 32-bit core. A torn read during an update only misroutes a
+    // frame or two.
+    struct SlotSet {
+        std::atomic<uint32_t> lo;
+        std::atomic<uint32_t> hi;
+
+        void store(uint64_t v) {
+            lo.store((uint32_t)v, std::memory_order_relaxed);
+            hi.store((uint32_t)(v >> 32), std::memory_order_relaxed);
+        }
+        uint64_t load() const {
+            return ((uint64_t)hi.load(std::memory_order_relaxed) << 32) | lo.load(std::memory_order_relaxed);
+        }
+        bool test(uint8_t slot) const {
+            uint32_t word = (slot < 32 ? lo : hi).load(std::memory_order_relaxed);
+            return (word >> (slot & 31)) & 1;
+        }
+    };
+
+    struct Slot {
+        RxAnalyzer* analyzer;
+        uint64_t mask;
+        uint64_t bodyMask;
+        std::atomic<bool> enabled;
+        std::atomic<bool> resetPending;
+        // Written by the consumer only
+        std::atomic<uint32_t> frames;
+        std::atomic<uint32_t> busyUs;
+        std::atomic<uint32_t> maxPassUs;
+    };
+
+    ClockUs clock;
+    Slot slots[RX_MAX_ANALYZERS];
+    int analyzerCount;
+    SlotSet wanted;
+    SlotSet bodyWanted;
+
+    void updateMask();
+    bool ready(Slot& s, uint32_t nowMs);
+    void charge(Slot& s, uint32_t frames, uint32_t us);
+};
+
+#endif
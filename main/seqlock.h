@@ -0,0 +1,65 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+// Single-writer sequence lock for publishing small POD snapshots.
+// The writer never waits; readers retry while a write is in flight and
+// give up after a few attempts so the caller can fall back to its last
+// good copy. The payload is kept as relaxed atomic words so a racing
+// read is well defined and simply discarded.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock payload must be trivially copyable");
+    static constexpr size_t WORDS = (sizeof(T) + 3) / 4;
+
+public:
+    // constexpr so static instances are ready before any constructor runs
+    constexpr Seqlock() : seq(0), data{} {}
+
+    void write(const T& value) {
+        uint32_t words[WORDS] = {};
+        memcpy(words, &value, sizeof(T));
+
+        // Always start from an odd value, even if a previous writer was
+        // deleted mid-write and left the sequence odd
+        uint32_t s = (seq.load(std::memory_order_relaxed) + 1) | 1;
+        seq.store(s, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++) {
+            data[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        seq.store(s + 1, std::memory_order_release);
+    }
+
+    bool tryRead(T& out, int maxRetries = 8) const {
+        for (int attempt = 0; attempt < maxRetries; attempt++) {
+            uint32_t s = seq.load(std::memory_order_acquire);
+            if (s & 1) continue;
+
+            uint32_t words[WORDS];
+            for (size_t i = 0; i < WORDS; i++) {
+                words[i] = data[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == s) {
+                memcpy(&out, words, sizeof(T));
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::atomic<uint32_t> seq;
+    std::atomic<uint32_t> data[WORDS];
+};
+
+#endif
@@ -1,38 +1,119 @@
 #ifndef SHARED_TYPES_H
 #define SHARED_TYPES_H
 
-#include <Arduino.h>
+#include <stdint.h>
+#include "ieee80211.h"
+#include "rssi_stats.h"
 
 // Packet types
 enum PktType { PKT_MGMT, PKT_DATA, PKT_CTRL, PKT_UNKNOWN };
 
-// WiFi event data structure
+// MAC addresses travel through the capture path as raw bytes and are only
+// turned into text when the UI actually draws them
+#define MAC_LEN     6
+#define MAC_STR_LEN 18
+
+static const uint8_t BROADCAST_MAC[MAC_LEN] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+inline bool macIsZero(const uint8_t* mac) {
+    for (int i = 0; i < MAC_LEN; i++) {
+        if (mac[i] != 0) return false;
+    }
+    return true;
+}
+
+// Format "AA:BB:CC:DD:EE:FF" into out (MAC_STR_LEN bytes)
+inline void formatMac(const uint8_t* mac, char* out) {
+    static const char hex[] = "0123456789ABCDEF";
+    for (int i = 0; i < MAC_LEN; i++) {
+        out[i * 3]     = hex[mac[i] >> 4];
+        out[i * 3 + 1] = hex[mac[i] & 0x0F];
+        out[i * 3 + 2] = (i < MAC_LEN - 1) ? ':' : '\0';
+    }
+}
+
+// WiFiEventData.flags: which optional fields the frame actually carried
+#define RX_REC_TA     0x01     // bssid holds a transmitter address
+#define RX_REC_REASON 0x02     // reasonCode is valid (deauth/disassoc)
+#define RX_REC_BEACON 0x04     // SSID/channel/security parsed from a beacon or probe response
+
+#define RX_SSID_LEN 16         // SSID prefix kept per record, NUL terminated
+
+// AP security class as advertised in a beacon
+enum ApSecurity : uint8_t { SEC_UNKNOWN, SEC_OPEN, SEC_WEP, SEC_WPA, SEC_RSN };
+
+inline const char* apSecurityName(uint8_t sec) {
+    switch (sec) {
+        case SEC_OPEN: return "Open";
+        case SEC_WEP:  return "WEP";
+        case SEC_WPA:  return "WPA";
+        case SEC_RSN:  return "WPA2+";
+        default:       return "?";
+    }
+}
+
+// Decoded once by the RX callback and shared by every analyzer. Fields
+// the frame didn't carry are zero and their flag is clear.
 struct WiFiEventData {
-    char bssid[18];
+    uint8_t bssid[MAC_LEN];    // Address 2 (transmitter)
+    uint8_t receiver[MAC_LEN]; // Address 1
     int8_t rssi;
-    int channel;
+    uint8_t flags;             // RX_REC_*
+    uint16_t reasonCode;
+    uint8_t channel;
+    uint8_t apChannel;         // DS parameter set; beacon fields only parsed on request
+    ApSecurity security;
+    uint32_t ssidHash;         // FNV-1a over the full SSID, 0 = hidden
+    char ssid[RX_SSID_LEN];
     PktType type;
+    uint16_t frameControl; // Raw 802.11 FC, decoded by the consumer
     uint32_t timestamp;
+    uint32_t rxTimestamp; // rx_ctrl.timestamp (us), for queue latency
 };
 
-// WiFi Network Info (for scanner)
+// WiFi Network Info (for scanner), copied out of the network table
 struct WiFiNetwork {
     char ssid[33];
     int8_t rssi;
+    int8_t rssiAvg;       // Mean over recent sightings
     uint8_t channel;
     uint8_t encryptionType;
-    char bssid[18];
+    uint8_t bssid[MAC_LEN];
+    const char* vendor;   // From the OUI table (flash), never NULL
+    uint16_t seenCount;
+    uint32_t firstSeen;
+    uint32_t lastSeen;
+};
+
+// Async scan progress, readable while the scan task runs
+struct ScanProgress {
+    uint8_t channel;        // Channel being scanned, 0 when idle
+    uint8_t channelsDone;
+    uint8_t channelsTotal;
+    bool active;
+    bool cancelled;         // Last scan was stopped early
+    uint32_t generation;    // Bumped whenever the result list changes
 };
 
 // WiFi statistics (lightweight for UI updates)
 struct WiFiStats {
-    int8_t rssi;
+    int8_t rssi;             // Mean of the last rssiSlow bucket
     uint32_t packetCount;
     uint32_t mgmtCount;
     uint32_t dataCount;
     uint32_t ctrlCount;
     int channel;
     bool isActive;
+    RssiSummary rssiFast;    // Last RSSI_FAST_MS bucket
+    RssiSummary rssiSlow;    // Last RSSI_SLOW_MS bucket
+};
+
+// Per-subtype frame breakdown (see ieee80211.h for slot layout)
+struct FrameHistogram {
+    uint32_t slots[FRAME_SLOT_COUNT]; // index = type << 4 | subtype
+    uint32_t retries;
+    uint32_t dsFlags[4];              // index = fromDS << 1 | toDS
+    uint32_t total;
 };
 
 // Waterfall data point
@@ -45,28 +126,170 @@ struct WaterfallPoint {
 enum ModuleState {
     STATE_IDLE,
     STATE_SCANNING,
-    STATE_SNIFFING,
+    STATE_SNIFFING,     // Shared RX pipeline up (traffic and/or deauth analyzers)
     STATE_SPAMMING,
-    STATE_DEAUTH_DETECT,
+    STATE_CAPTURING,
     STATE_ERROR
 };
 
 // Deauth detection structures
 struct DeauthEvent {
-    char apMac[18];
-    char clientMac[18];
-    uint8_t reasonCode;
+    uint8_t apMac[MAC_LEN];
+    uint8_t clientMac[MAC_LEN];
+    uint16_t reasonCode;
+    uint8_t subtype;      // FC_MGMT_DEAUTH or FC_MGMT_DISASSOC
     uint32_t timestamp;
+    uint32_t rxTimestamp; // rx_ctrl.timestamp (us), for queue latency
     int8_t rssi;
 };
 
+#define DEAUTH_PAIR_COUNT 4
+
+// AP/client pair whose deauth rate crossed the per-client threshold
+struct DeauthPair {
+    uint8_t apMac[MAC_LEN];
+    uint8_t clientMac[MAC_LEN];
+    uint16_t rate;                 // Deauths/s at the last hit
+    uint32_t lastSeen;
+};
+
+// Alert thresholds, all in deauths per sliding second
+struct DeauthThresholds {
+    uint16_t totalPerSec;          // Everything heard on the channel
+    uint16_t apPerSec;             // From one AP address
+    uint16_t clientPerSec;         // Aimed at one client
+    uint16_t broadcastPerSec;      // Aimed at everyone
+    uint16_t holdMs;               // Alert stays up this long after the last breach
+    uint16_t disassocPerSec;       // Disassociations, counted apart from deauths
+    uint16_t beaconBssidsPerSec;   // Distinct beaconing BSSIDs before it's a flood
+};
+
 struct DeauthStats {
-    uint32_t totalDeauths;
+    uint32_t totalDeauths;         // Deauthentication frames only
     uint32_t broadcastDeauths;
-    uint32_t suspiciousCount;
+    uint32_t suspiciousCount;      // Threshold crossings
     bool attackDetected;
-    char suspiciousAP[18];
+    uint8_t suspiciousAP[MAC_LEN]; // all zero when none
     uint32_t lastDetectionTime;
+    uint16_t trackedSources;       // Entries in the per-AP tracker
+    uint32_t trackerEvictions;     // APs recycled to make room
+    uint16_t totalRate;            // Deauths in the last second
+    uint16_t peakRate;
+    DeauthPair pairs[DEAUTH_PAIR_COUNT]; // Most recent first
+    uint8_t pairCount;
+    uint32_t disassocCount;
+    uint16_t disassocRate;         // Disassociations in the last second
+    bool disassocFlood;            // disassocPerSec breached within holdMs
+    uint32_t lastDisassocTime;     // Last disassocPerSec breach, 0 = none yet
+};
+
+#define DEAUTH_REASON_BUCKETS 24  // Reason codes 0-22 one each, the rest share the last
+#define DEAUTH_TOP_COUNT 4
+
+// Most targeted client
+struct DeauthTarget {
+    uint8_t mac[MAC_LEN];
+    uint32_t frames;               // Deauths + disassocs aimed at it
+    uint16_t peakRate;             // Highest per-second rate seen
+};
+
+// Triage aggregates over every deauth/disassoc since the last reset.
+// Fixed size; counters move per event, the rankings at UI rate.
+struct DeauthAnalytics {
+    uint32_t events;
+    uint32_t reasons[DEAUTH_REASON_BUCKETS];
+    uint32_t broadcast;            // Addressed to FF:FF:FF:FF:FF:FF
+    uint32_t unicast;
+    DeauthTarget targets[DEAUTH_TOP_COUNT];   // Most frames first
+    uint8_t targetCount;
+    DeauthPair topPairs[DEAUTH_TOP_COUNT];    // Highest peak rate first
+    uint8_t topPairCount;
+};
+
+inline uint8_t deauthReasonBucket(uint16_t reason) {
+    return reason < DEAUTH_REASON_BUCKETS - 1 ? reason : DEAUTH_REASON_BUCKETS - 1;
+}
+
+// Beacon/probe response flood: many distinct BSSIDs per second
+struct BeaconFloodStats {
+    uint32_t frames;               // Beacons + probe responses seen
+    uint16_t framesPerSec;         // Last full second
+    uint16_t bssidsPerSec;         // Distinct BSSIDs, last full second (estimate)
+    uint16_t peakBssidsPerSec;
+    bool floodDetected;
+    uint32_t lastDetectionTime;
+};
+
+#define TWIN_CONFLICT_COUNT 2
+
+// One SSID advertised by two BSSIDs that disagree on security, or on
+// channel across different vendors
+struct TwinConflict {
+    char ssid[RX_SSID_LEN];
+    uint8_t knownBssid[MAC_LEN];   // First seen
+    uint8_t twinBssid[MAC_LEN];    // The newcomer
+    uint8_t knownChannel;
+    uint8_t twinChannel;
+    uint8_t knownSecurity;         // ApSecurity
+    uint8_t twinSecurity;
+    uint32_t lastSeen;
+};
+
+struct TwinStats {
+    uint16_t ssidsTracked;
+    uint32_t ssidEvictions;        // SSIDs recycled to make room
+    uint32_t conflicts;            // Distinct twin BSSIDs flagged (the last 16 are deduplicated)
+    bool twinDetected;             // A conflict within the hold time
+    TwinConflict recent[TWIN_CONFLICT_COUNT]; // Most recent first
+    uint8_t recentCount;
+};
+
+// Capture queue health (callback -> consumer task)
+struct QueueStats {
+    uint32_t enqueued;
+    uint32_t dropped;
+    uint32_t highWater;    // Deepest fill level seen
+    uint32_t capacity;
+    uint32_t latencyAvgUs; // RX timestamp to consumer, smoothed
+    uint32_t latencyMaxUs;
+};
+
+// Radio-side promiscuous filtering for the active mode
+struct FilterStats {
+    uint32_t frameMask;     // WIFI_PROMIS_FILTER_MASK_* programmed into the radio
+    uint32_t avoidedPerSec; // Callbacks the filter saved, estimated by sampling
+};
+
+#define RX_MAX_ANALYZERS 6
+
+// Per-analyzer cost on the shared RX pipeline
+struct AnalyzerStats {
+    const char* name;
+    bool enabled;
+    uint32_t frames;      // Frames handed to this analyzer
+    uint32_t busyUs;      // Time spent in it, batches and idle passes
+    uint32_t nsPerFrame;  // busyUs spread over frames
+    uint32_t maxPassUs;   // Longest single batch or idle pass
+};
+
+struct PipelineStats {
+    QueueStats rx;        // Shared promiscuous callback -> analyzers
+    uint32_t rxMalformed; // Frames too short to parse, dropped in the callback
+    uint32_t rxStackFree; // Least free WiFiRx stack seen, bytes; 0 until sampled
+    QueueStats capture;
+    FilterStats filter;
+    AnalyzerStats analyzers[RX_MAX_ANALYZERS];
+    uint8_t analyzerCount;
+};
+
+// PCAP export progress
+struct CaptureStats {
+    uint32_t framesSent;
+    uint32_t bytesSent;
+    uint32_t dropped;   // Frames lost because the serial link couldn't keep up
+    uint32_t baud;
+    uint16_t snapLen;
+    bool active;
 };
 
 // UI Update flags (bitwise for efficiency)
@@ -0,0 +1,103 @@
+#ifndef SORTED_INDEX_H
+#define SORTED_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Rank order over a densely packed table, kept as two index arrays
+// (rank -> item, item -> rank) so the table itself never moves for
+// sorting. Changes are applied incrementally: a new or updated item is
+// shifted left/right until it is in place, which for RSSI jitter or a
+// fresher last-seen is usually a step or two. Only changing the sort key
+// re-sorts everything. Storage is supplied by the owner; same locking
+// rules as the table it indexes.
+template <typename T>
+class SortedIndex {
+public:
+    // Negative if a ranks before b
+    typedef int (*Compare)(const T& a, const T& b);
+
+    SortedIndex() : items(nullptr), order(nullptr), ranks(nullptr), count(0), compare(nullptr) {}
+
+    // order and ranks must each hold as many entries as the table
+    void attach(const T* table, uint16_t* orderBuf, uint16_t* rankBuf) {
+        items = table;
+        order = orderBuf;
+        ranks = rankBuf;
+        count = 0;
+    }
+
+    void clear() { count = 0; }
+
+    // Switch sort key; the one full re-sort (insertion sort, the order is
+    // usually close already)
+    void setCompare(Compare cmp) {
+        compare = cmp;
+        for (uint16_t r = 1; r < count; r++) {
+            uint16_t item = order[r];
+            uint16_t pos = r;
+            while (pos > 0 && compare(items[item], items[order[pos - 1]]) < 0) {
+                order[pos] = order[pos - 1];
+                pos--;
+            }
+            order[pos] = item;
+        }
+        for (uint16_t r = 0; r < count; r++) ranks[order[r]] = r;
+    }
+
+    // Table appended item idx
+    void insert(uint16_t idx) {
+        order[count] = idx;
+        ranks[idx] = count;
+        count++;
+        update(idx);
+    }
+
+    // Item idx changed in place
+    void update(uint16_t idx) {
+        if (compare == nullptr) return;
+        uint16_t r = ranks[idx];
+
+        while (r > 0 && compare(items[idx], items[order[r - 1]]) < 0) {
+            order[r] = order[r - 1];
+            ranks[order[r]] = r;
+            r--;
+        }
+        while (r + 1 < count && compare(items[order[r + 1]], items[idx]) < 0) {
+            order[r] = order[r + 1];
+            ranks[order[r]] = r;
+            r++;
+        }
+
+        order[r] = idx;
+        ranks[idx] = r;
+    }
+
+    // Table removed item idx and moved its last item (movedFrom) into the
+    // hole; pass movedFrom == idx when nothing moved
+    void remove(uint16_t idx, uint16_t movedFrom) {
+        for (uint16_t r = ranks[idx]; r + 1 < count; r++) {
+            order[r] = order[r + 1];
+            ranks[order[r]] = r;
+        }
+        count--;
+
+        if (movedFrom != idx) {
+            uint16_t r = ranks[movedFrom];
+            order[r] = idx;
+            ranks[idx] = r;
+        }
+    }
+
+    uint16_t size() const { return count; }
+    uint16_t at(uint16_t rank) const { return order[rank]; }
+
+private:
+    const T* items;
+    uint16_t* order;
+    uint16_t* ranks;
+    uint16_t count;
+    Compare compare;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef SPECTROGRAM_H
+#define SPECTROGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Time x channel activity store behind the Traffic ANLZ heatmap. Cells are
+// one contiguous row-major block; appending a row overwrites the oldest
+// one in place, so rotation is a counter increment with no copying. One
+// writer task fills rows, any number of readers copy them out lock-free
+// and drop rows that were recycled while they were copying.
+template <size_t ROWS, size_t COLS>
+class Spectrogram {
+    static_assert(ROWS >= 2 && (ROWS & (ROWS - 1)) == 0, "Spectrogram rows must be a power of two");
+
+public:
+    Spectrogram() : rows(0) {}
+
+    // Writer: fill the next row (oldest slot), then publish it
+    void appendRow(const uint8_t* values) {
+        uint32_t r = rows.load(std::memory_order_relaxed);
+        std::atomic<uint8_t>* row = &cells[(r & (ROWS - 1)) * COLS];
+        for (size_t c = 0; c < COLS; c++) {
+            row[c].store(values[c], std::memory_order_relaxed);
+        }
+        rows.store(r + 1, std::memory_order_release);
+    }
+
+    // Rows appended so far. The newest ROWS - 1 rows are readable; the
+    // oldest slot is the one the writer fills next
+    uint32_t rowCount() const { return rows.load(std::memory_order_acquire); }
+
+    // Copy row n into out. False if it isn't written yet or was recycled.
+    bool readRow(uint32_t n, uint8_t* out) const {
+        if ((int32_t)(rowCount() - n) <= 0) return false;
+        const std::atomic<uint8_t>* row = &cells[(n & (ROWS - 1)) * COLS];
+        for (size_t c = 0; c < COLS; c++) {
+            out[c] = row[c].load(std::memory_order_relaxed);
+        }
+        // The writer is filling row rowCount(); ours survived if that isn't n + ROWS
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return rows.load(std::memory_order_relaxed) - n < ROWS;
+    }
+
+    static constexpr size_t rowCapacity() { return ROWS; }
+    static constexpr size_t columns() { return COLS; }
+
+    // Only valid while the writer is stopped
+    void reset() {
+        for (size_t i = 0; i < ROWS * COLS; i++) cells[i].store(0, std::memory_order_relaxed);
+        rows.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> rows;
+    std::atomic<uint8_t> cells[ROWS * COLS];
+};
+
+// Log-scaled cell value for a frame count: 0 = silent, +16 per doubling,
+// with 4 bits of interpolation in between
+inline uint8_t spectroLevel(uint32_t frames) {
+    if (frames == 0) return 0;
+    uint32_t bits = 32 - __builtin_clz(frames);
+    uint32_t frac = (bits > 5) ? (frames >> (bits - 5)) : (frames << (5 - bits));
+    uint32_t level = bits * 16 + (frac & 0x0F);
+    return level > 255 ? 255 : (uint8_t)level;
+}
+
+#endif
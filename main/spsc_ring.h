@@ -0,0 +1,87 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Lock-free single-producer/single-consumer ring buffer.
+// The producer (Wi-Fi RX callback) only ever writes head, the consumer
+// (analysis task) only ever writes tail, so no locks are needed. Capacity
+// must be a power of two. No Arduino/FreeRTOS dependencies, so the same
+// header builds on a Linux host.
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    // Producer side. Returns false when the ring is full (record dropped).
+    bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N) return false;
+        slots[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Copies up to maxCount records into out, returns count.
+    size_t popBatch(T* out, size_t maxCount) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t avail = head.load(std::memory_order_acquire) - t;
+        size_t n = avail < maxCount ? avail : maxCount;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = slots[(t + i) & (N - 1)];
+        }
+        tail.store(t + (uint32_t)n, std::memory_order_release);
+        return n;
+    }
+
+    bool pop(T& out) { return popBatch(&out, 1) == 1; }
+
+    // Zero-copy producer API for large records: fill the slot returned by
+    // claim() in place, then publish it with commit(). NULL when full.
+    T* claim() {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N) return nullptr;
+        return &slots[h & (N - 1)];
+    }
+
+    void commit() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Zero-copy consumer API: read the oldest record in place, then
+    // hand the slot back with release(). NULL when empty.
+    const T* front() const {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) return nullptr;
+        return &slots[t & (N - 1)];
+    }
+
+    void release() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Approximate fill level, safe to call from either side
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+    // Only valid while neither producer nor consumer is running
+    void reset() {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // Separate head/tail so the two cores don't share a line on hosts with caches
+    alignas(64) std::atomic<uint32_t> head;
+    alignas(64) std::atomic<uint32_t> tail;
+    T slots[N];
+};
+
+#endif
@@ -0,0 +1,65 @@
+#include "station_table.h"
+
+void StationTable::clear() {
+    index.clear();
+}
+
+void StationTable::update(uint64_t key, int8_t rssi, uint8_t channel, uint32_t now) {
+    int found = index.find(key);
+
+    if (found >= 0) {
+        Entry& e = entries[found];
+        e.frames++;
+        e.lastSeen = now;
+        e.lastRssi = rssi;
+        e.channel = channel;
+        if (rssi < e.minRssi) e.minRssi = rssi;
+        if (rssi > e.maxRssi) e.maxRssi = rssi;
+        index.touch(found);
+        return;
+    }
+
+    // New transmitter; recycles the least recently seen when full
+    Entry& e = entries[index.insert(key)];
+    e.frames = 1;
+    e.lastSeen = now;
+    e.lastRssi = rssi;
+    e.minRssi = rssi;
+    e.maxRssi = rssi;
+    e.channel = channel;
+}
+
+void StationTable::topTalkers(TopTalkers& out) const {
+    // Insertion into a short sorted list; O(capacity * TOP_TALKER_COUNT)
+    // worst case, run at UI rate rather than per frame
+    uint16_t top[TOP_TALKER_COUNT];
+    int n = 0;
+
+    for (uint16_t idx = 0; idx < index.size(); idx++) {
+        uint32_t frames = entries[idx].frames;
+        if (n == TOP_TALKER_COUNT && frames <= entries[top[n - 1]].frames) continue;
+
+        int pos = (n < TOP_TALKER_COUNT) ? n++ : n - 1;
+        while (pos > 0 && entries[top[pos - 1]].frames < frames) {
+            top[pos] = top[pos - 1];
+            pos--;
+        }
+        top[pos] = idx;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const Entry& e = entries[top[i]];
+        StationInfo& s = out.stations[i];
+        keyToMac(index.key(top[i]), s.mac);
+        s.lastRssi = e.lastRssi;
+        s.minRssi = e.minRssi;
+        s.maxRssi = e.maxRssi;
+        s.channel = e.channel;
+        s.frames = e.frames;
+        s.lastSeen = e.lastSeen;
+    }
+
+    out.count = n;
+    out.tracked = index.size();
+    out.evictions = index.getEvictions();
+}
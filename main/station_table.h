@@ -0,0 +1,71 @@
+#ifndef STATION_TABLE_H
+#define STATION_TABLE_H
+
+#include <stdint.h>
+#include "ieee80211.h"
+#include "mac_index.h"
+
+// Fixed-capacity per-transmitter table for the sniffer: a static entry
+// pool behind a FixedMacIndex, so lookup, insert and LRU eviction are all
+// O(1) and the heap is never touched. Owned by a single task; not thread
+// safe.
+
+#ifndef STATION_TABLE_CAPACITY
+#define STATION_TABLE_CAPACITY 128    // Tracked transmitters
+#endif
+#ifndef STATION_HASH_BITS
+#define STATION_HASH_BITS 8           // 256 slots, load factor <= 0.5
+#endif
+#define STATION_HASH_SLOTS (1 << STATION_HASH_BITS)
+#define TOP_TALKER_COUNT 10
+
+static_assert(STATION_TABLE_CAPACITY * 2 <= STATION_HASH_SLOTS, "Station hash must be at least twice the pool");
+
+// Copy of one entry handed to the UI
+struct StationInfo {
+    uint8_t mac[6];
+    int8_t lastRssi;
+    int8_t minRssi;
+    int8_t maxRssi;
+    uint8_t channel;
+    uint32_t frames;
+    uint32_t lastSeen;
+};
+
+// Top transmitters by frame count, published by the sniffer task
+struct TopTalkers {
+    StationInfo stations[TOP_TALKER_COUNT];
+    uint16_t count;      // Valid rows in stations[]
+    uint16_t tracked;    // Entries currently in the table
+    uint32_t evictions;  // LRU evictions since clear()
+};
+
+class StationTable {
+public:
+    void clear();
+
+    // Find or insert key and fold one frame into it. Evicts the least
+    // recently seen entry when the pool is full.
+    void update(uint64_t key, int8_t rssi, uint8_t channel, uint32_t now);
+
+    // Fill out with up to TOP_TALKER_COUNT entries, highest frame count first
+    void topTalkers(TopTalkers& out) const;
+
+    int size() const { return index.size(); }
+    uint32_t getEvictions() const { return index.getEvictions(); }
+
+private:
+    struct Entry {
+        uint32_t frames;
+        uint32_t lastSeen;
+        int8_t lastRssi;
+        int8_t minRssi;
+        int8_t maxRssi;
+        uint8_t channel;
+    };
+
+    FixedMacIndex<STATION_TABLE_CAPACITY, STATION_HASH_SLOTS> index;
+    Entry entries[STATION_TABLE_CAPACITY];
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "twin_detector.h"
+#include <string.h>
+
+TwinDetector::TwinDetector() : holdMs(5000) {
+    reset();
+}
+
+void TwinDetector::reset() {
+    memset(entries, 0, sizeof(entries));
+    memset(&stats, 0, sizeof(stats));
+    lastDetectionTime = 0;
+    flaggedCount = 0;
+    flaggedNext = 0;
+}
+
+bool TwinDetector::wasFlagged(uint64_t key) const {
+    for (int i = 0; i < flaggedCount; i++) {
+        if (flagged[i] == key) return true;
+    }
+    return false;
+}
+
+void TwinDetector::rememberFlagged(uint64_t key) {
+    if (wasFlagged(key)) return;
+
+    flagged[flaggedNext] = key;
+    flaggedNext = (flaggedNext + 1) % TWIN_FLAGGED_CAPACITY;
+    if (flaggedCount < TWIN_FLAGGED_CAPACITY) flaggedCount++;
+}
+
+// Same OUI, ignoring the locally administered bit vendors flip for extra BSSIDs
+static bool sameVendorBlock(const uint8_t* a, const uint8_t* b) {
+    return (a[0] | 0x02) == (b[0] | 0x02) && a[1] == b[1] && a[2] == b[2];
+}
+
+TwinDetector::SsidEntry* TwinDetector::findOrAdd(const WiFiEventData& rec) {
+    SsidEntry* oldest = &entries[0];
+    SsidEntry* free = NULL;
+
+    for (int i = 0; i < TWIN_SSID_CAPACITY; i++) {
+        SsidEntry& e = entries[i];
+        if (e.ssidHash == rec.ssidHash) return &e;
+        if (e.ssidHash == 0) {
+            if (free == NULL) free = &e;
+        } else if ((int32_t)(e.lastSeen - oldest->lastSeen) < 0) {
+            oldest = &e;
+        }
+    }
+
+    SsidEntry* e = free;
+    if (e == NULL) {
+        e = oldest;
+        stats.ssidEvictions++;
+    } else {
+        stats.ssidsTracked++;
+    }
+
+    memset(e, 0, sizeof(*e));
+    e->ssidHash = rec.ssidHash;
+    memcpy(e->ssid, rec.ssid, RX_SSID_LEN);
+    return e;
+}
+
+void TwinDetector::recordConflict(const SsidEntry& e, const Ap& known, const WiFiEventData& rec) {
+    stats.twinDetected = true;
+    lastDetectionTime = rec.timestamp;
+
+    // Back after being rotated out of the AP list: keep the alert up, but
+    // it's the same twin
+    uint64_t twinKey = macToKey(rec.bssid);
+    if (wasFlagged(twinKey)) return;
+
+    stats.conflicts++;
+    rememberFlagged(twinKey);
+    rememberFlagged(macToKey(known.bssid));
+
+    if (stats.recentCount < TWIN_CONFLICT_COUNT) stats.recentCount++;
+    for (int i = stats.recentCount - 1; i > 0; i--) stats.recent[i] = stats.recent[i - 1];
+
+    TwinConflict& c = stats.recent[0];
+    memcpy(c.ssid, e.ssid, RX_SSID_LEN);
+    memcpy(c.knownBssid, known.bssid, MAC_LEN);
+    memcpy(c.twinBssid, rec.bssid, MAC_LEN);
+    c.knownChannel = known.channel;
+    c.twinChannel = rec.apChannel;
+    c.knownSecurity = known.security;
+    c.twinSecurity = rec.security;
+    c.lastSeen = rec.timestamp;
+}
+
+void TwinDetector::onBeacon(const WiFiEventData& rec) {
+    // Hidden SSIDs say nothing about who they impersonate
+    if (!(rec.flags & RX_REC_BEACON) || !(rec.flags & RX_REC_TA) || rec.ssidHash == 0) return;
+
+    SsidEntry* e = findOrAdd(rec);
+    e->lastSeen = rec.timestamp;
+
+    int oldest = 0;
+    for (int i = 0; i < e->apCount; i++) {
+        Ap& ap = e->aps[i];
+        if (memcmp(ap.bssid, rec.bssid, MAC_LEN) == 0) {
+            // Known BSSID: follow it if it moves or changes security
+            ap.channel = rec.apChannel;
+            ap.security = rec.security;
+            ap.lastSeen = rec.timestamp;
+            return;
+        }
+        if ((int32_t)(ap.lastSeen - e->aps[oldest].lastSeen) < 0) oldest = i;
+    }
+
+    // New BSSID for this SSID: compare against everyone already on it
+    for (int i = 0; i < e->apCount; i++) {
+        const Ap& ap = e->aps[i];
+        bool securityDiffers = ap.security != rec.security;
+        bool channelDiffers = ap.channel != 0 && rec.apChannel != 0 && ap.channel != rec.apChannel &&
+                              !sameVendorBlock(ap.bssid, rec.bssid);
+        if (securityDiffers || channelDiffers) {
+            recordConflict(*e, ap, rec);
+            break;
+        }
+    }
+
+    int slot = e->apCount < TWIN_APS_PER_SSID ? e->apCount++ : oldest;
+    Ap& ap = e->aps[slot];
+    memcpy(ap.bssid, rec.bssid, MAC_LEN);
+    ap.channel = rec.apChannel;
+    ap.security = rec.security;
+    ap.lastSeen = rec.timestamp;
+}
+
+bool TwinDetector::tick(uint32_t now) {
+    if (stats.twinDetected && now - lastDetectionTime > holdMs) {
+        stats.twinDetected = false;
+        return true;
+    }
+    return false;
+}
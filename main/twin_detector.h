@@ -0,0 +1,71 @@
+#ifndef TWIN_DETECTOR_H
+#define TWIN_DETECTOR_H
+
+#include <stdint.h>
+#include "shared_types.h"
+
+// Evil twin candidates: an SSID that turns up under a new BSSID whose
+// security differs from the BSSIDs already advertising it, or whose
+// channel differs while the address isn't from the same vendor block
+// (multi-BSSID APs and same-vendor meshes legitimately spread one SSID
+// over several channels). Pure bookkeeping like DeauthDetector, fed
+// beacon/probe response records with RX_REC_BEACON.
+//
+// Memory is fixed: TWIN_SSID_CAPACITY SSIDs, recycled least recently
+// seen first, each remembering up to TWIN_APS_PER_SSID BSSIDs. A linear
+// scan is cheaper than hashing at this size. When a busy SSID rotates a
+// BSSID out of its list and sees it again, it looks new; the last
+// TWIN_FLAGGED_CAPACITY BSSIDs involved in a conflict are remembered
+// apart so that doesn't count the same twin twice.
+
+#ifndef TWIN_SSID_CAPACITY
+#define TWIN_SSID_CAPACITY 32
+#endif
+#define TWIN_APS_PER_SSID 4
+#define TWIN_FLAGGED_CAPACITY 16
+
+class TwinDetector {
+public:
+    TwinDetector();
+
+    void setHoldMs(uint16_t ms) { holdMs = ms; }
+    void reset();
+
+    void onBeacon(const WiFiEventData& rec);
+
+    // Age the alert; true if the stats changed
+    bool tick(uint32_t now);
+
+    const TwinStats& getStats() const { return stats; }
+
+private:
+    struct Ap {
+        uint8_t bssid[MAC_LEN];
+        uint8_t channel;
+        uint8_t security;
+        uint32_t lastSeen;
+    };
+
+    struct SsidEntry {
+        uint32_t ssidHash;  // 0 = free
+        uint32_t lastSeen;
+        char ssid[RX_SSID_LEN];
+        Ap aps[TWIN_APS_PER_SSID];
+        uint8_t apCount;
+    };
+
+    SsidEntry entries[TWIN_SSID_CAPACITY];
+    TwinStats stats;
+    uint16_t holdMs;
+    uint32_t lastDetectionTime;
+    uint64_t flagged[TWIN_FLAGGED_CAPACITY]; // Ring of BSSID keys already in a conflict
+    uint8_t flaggedCount;
+    uint8_t flaggedNext;
+
+    bool wasFlagged(uint64_t key) const;
+    void rememberFlagged(uint64_t key);
+    SsidEntry* findOrAdd(const WiFiEventData& rec);
+    void recordConflict(const SsidEntry& e, const Ap& known, const WiFiEventData& rec);
+};
+
+#endif
@@ -1,5 +1,32 @@
 #include "ui_manager.h"
 
+// Scanner list filter presets, cycled by the FLT button
+struct ScanFilterPreset {
+    const char* name;
+    NetworkFilter filter;
+};
+
+static const ScanFilterPreset scanFilterPresets[] = {
+    {"ALL",    {0, -128, 0}},
+    {"OPEN",   {0, -128, 1u << WIFI_AUTH_OPEN}},
+    {"ENC",    {0, -128, (uint16_t)~(1u << WIFI_AUTH_OPEN)}},
+    {"STRONG", {0, -70, 0}}
+};
+#define SCAN_FILTER_PRESETS (sizeof(scanFilterPresets) / sizeof(scanFilterPresets[0]))
+
+struct BTFilterPreset {
+    const char* name;
+    BTFilter filter;
+};
+
+static const BTFilterPreset btFilterPresets[] = {
+    {"ALL",    {0, -128, false}},
+    {"NAMED",  {0, -128, true}},
+    {"TRACK",  {1u << 5, -128, false}},
+    {"STRONG", {0, -70, false}}
+};
+#define BT_FILTER_PRESETS (sizeof(btFilterPresets) / sizeof(btFilterPresets[0]))
+
 // Menu Definitions
 MenuItem mainItems[] = {
     { "WiFi 2.4GHz", MENU_WIFI },
@@ -12,8 +39,10 @@ const int MAIN_COUNT = sizeof(mainItems) / sizeof(MenuItem);
 MenuItem wifiItems[] = { 
     {"Traffic ANLZ", PAGE_WATERFALL}, 
     {"WiFi Scanner", PAGE_SCANNER},
+    {"Channel Load", PAGE_CHANNEL_LOAD},
     {"Beacon Spam", PAGE_SPAM},
-    {"Deauth Detect", PAGE_DEAUTH}
+    {"Deauth Detect", PAGE_DEAUTH},
+    {"PCAP Export", PAGE_PCAP}
 };
 const int WIFI_COUNT = sizeof(wifiItems) / sizeof(MenuItem);
 
@@ -39,7 +68,7 @@ const int SETTINGS_COUNT = sizeof(settingsItems) / sizeof(MenuItem);
 
 UIManager::UIManager(WiFiHandler &wh, BTHandler &bh) 
     : wifi(wh), bt(bh), tft(TFT_eSPI()) {
-    cachedStats = {-100, 0, 0, 0, 0, 1, false};
+    cachedStats = {-100, 0, 0, 0, 0, 1, false, {}, {}};
 }
 
 void UIManager::begin() {
@@ -57,6 +86,8 @@ void UIManager::begin() {
 }
 
 void UIManager::update() {
+    uint32_t frameStart = micros();
+    
     switch (currentState) {
         case MENU_MAIN:
             if (stateChanged) { 
@@ -112,12 +143,23 @@ void UIManager::update() {
             if (stateChanged) {
                 drawScannerPage();
                 wifi.startScan();
+                resetFrameTiming();
                 stateChanged = false;
             }
             updateScannerDisplay();
             handleScannerTouch();
             break;
 
+        case PAGE_CHANNEL_LOAD:
+            if (stateChanged) {
+                drawChannelLoadPage();
+                wifi.startScan();
+                stateChanged = false;
+            }
+            updateChannelLoadDisplay();
+            handleChannelLoadTouch();
+            break;
+
         case PAGE_SPAM:
             if (stateChanged) {
                 drawSpammerPage();
@@ -136,6 +178,15 @@ void UIManager::update() {
             handleDeauthTouch();
             break;
 
+        case PAGE_PCAP:
+            if (stateChanged) {
+                drawCapturePage();
+                stateChanged = false;
+            }
+            updateCaptureDisplay();
+            handleCaptureTouch();
+            break;
+
         // ===== Placeholder Pages =====
         case PAGE_PORTAL:
             if (stateChanged) { 
@@ -198,12 +249,32 @@ void UIManager::update() {
             handleListTouch(NULL, 0, MENU_RFID);
             break;
     }
+    
+    recordFrameTime(micros() - frameStart);
+}
+
+// Smoothed and worst-case duration of one update() pass
+void UIManager::recordFrameTime(uint32_t us) {
+    if (frameTimingSkip) {
+        // The pass that started the measurement also drew the page
+        frameTimingSkip = false;
+        return;
+    }
+    frameTimeAvgUs = (frameTimeAvgUs == 0) ? us : frameTimeAvgUs - (frameTimeAvgUs >> 4) + (us >> 4);
+    if (us > frameTimeMaxUs) frameTimeMaxUs = us;
+}
+
+void UIManager::resetFrameTiming() {
+    frameTimeAvgUs = 0;
+    frameTimeMaxUs = 0;
+    frameTimingSkip = true;
 }
 
 void UIManager::changeState(MenuState newState) {
     // Cleanup based on current state
     if (currentState == PAGE_WATERFALL) {
         wifi.stopSniffer();
+        wifi.stopDeauthDetector(); // May have been switched on from the analyzer view
         waterfallRunning = false;
     } else if (currentState == PAGE_SPAM) {
         wifi.stopSpammer();
@@ -211,6 +282,11 @@ void UIManager::changeState(MenuState newState) {
     } else if (currentState == PAGE_DEAUTH) {
         wifi.stopDeauthDetector();
         deauthRunning = false;
+    } else if (currentState == PAGE_PCAP) {
+        wifi.stopCapture();
+        captureRunning = false;
+    } else if (currentState == PAGE_SCANNER || currentState == PAGE_CHANNEL_LOAD) {
+        wifi.cancelScan();
     } else if (currentState == PAGE_BT_SCANNER) {
         bt.stopScan();
         btScannerRunning = false;
@@ -249,6 +325,16 @@ uint16_t UIManager::getRssiColor(int8_t rssi) {
     return 0xF800;                  // Red
 }
 
+// Spectrogram cell color, dark blue (a frame or two) to red (~1000/tick)
+uint16_t UIManager::getHeatColor(uint8_t level) {
+    static const uint16_t ramp[8] = {
+        0x0010, 0x001F, 0x041F, 0x07FF, 0x07E0, 0xFFE0, 0xFD20, 0xF800
+    };
+    if (level == 0) return FLIPPER_BLACK;
+    int idx = (level < 16) ? 0 : (level - 16) / 20;
+    return ramp[idx > 7 ? 7 : idx];
+}
+
 void UIManager::headerUi(const char* title) {
     tft.fillRect(0, 0, tft.width(), HEADER_HEIGHT, FLIPPER_ORANGE);
     tft.setTextColor(FLIPPER_BLACK, FLIPPER_ORANGE);
@@ -335,19 +421,12 @@ void UIManager::drawWaterfallPage() {
     
     // Draw borders (1px from header and back button)
     int graphY = HEADER_HEIGHT + 1;
-    int graphH = tft.height() - HEADER_HEIGHT - 57;
+    int graphH = tft.height() - HEADER_HEIGHT - 69;
     int dataY = graphY + graphH + 1;
     tft.drawRoundRect(0, graphY, tft.width(), graphH, 6, FLIPPER_GRAY);
-    tft.drawRoundRect(0, dataY, tft.width(), 20, 6, FLIPPER_GREEN);
+    tft.drawRoundRect(0, dataY, tft.width(), 32, 6, FLIPPER_GREEN);
     
-    // Draw Y-axis labels (RSSI scale)
-    tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
-    tft.setTextSize(1);
-    tft.setTextDatum(MR_DATUM);
-    
-    tft.drawString("0", 12, graphY + 10);
-    tft.drawString("-50", 18, graphY + graphH / 2);
-    tft.drawString("-100", 24, graphY + graphH - 10);
+    drawTrafficAxis(graphY, graphH);
     
     // Draw channel controls
     drawButton(tft.width() - 70, tft.height() - 33, 30, 28, "<", FLIPPER_GREEN);
@@ -356,8 +435,32 @@ void UIManager::drawWaterfallPage() {
     // Draw start/stop button
     drawButton(tft.width()/2 - 30, tft.height() - 33, 60, 28, "START", FLIPPER_GREEN);
     
+    // Waterfall / frame breakdown toggle
+    drawButton(58, tft.height() - 33, 30, 28, "VIEW", FLIPPER_GREEN, trafficView != TRAFFIC_WATERFALL);
+    
     backUi("<<<");
-    waterfallX = 25; // Start drawing position
+    spectroRowsDrawn = 0;
+    rssiPlotX = 25;
+}
+
+// Y-axis labels for the graph views, blank for the text views
+void UIManager::drawTrafficAxis(int graphY, int graphH) {
+    tft.fillRect(2, graphY + 4, 23, graphH - 8, FLIPPER_BLACK);
+    tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
+    tft.setTextSize(1);
+    tft.setTextDatum(MR_DATUM);
+    
+    if (trafficView == TRAFFIC_WATERFALL) {
+        // Time, newest row on top
+        char label[8];
+        snprintf(label, 8, "-%ds", (SPECTRO_ROWS - 1) * SPECTRO_TICK_MS / 1000);
+        tft.drawString("now", 23, graphY + 16);
+        tft.drawString(label, 23, graphY + graphH - 10);
+    } else if (trafficView == TRAFFIC_RSSI) {
+        tft.drawString("0", 12, graphY + 10);
+        tft.drawString("-50", 18, graphY + graphH / 2);
+        tft.drawString("-100", 24, graphY + graphH - 10);
+    }
 }
 
 void UIManager::updateWaterfall() {
@@ -367,41 +470,313 @@ void UIManager::updateWaterfall() {
         cachedStats = wifi.getStats();
         
         int graphY = HEADER_HEIGHT + 2;
-        int graphH = tft.height() - HEADER_HEIGHT - 59;
+        int graphH = tft.height() - HEADER_HEIGHT - 71;
         int dataY = graphY + graphH + 2;
         
-        int8_t rssi = cachedStats.rssi;
-        if (rssi < -100) rssi = -100;
-        if (rssi > 0) rssi = 0;
+        if (trafficView == TRAFFIC_RSSI) {
+            drawRssiColumn(graphY, graphH);
+        } else if (trafficView != TRAFFIC_WATERFALL) {
+            // Text-heavy views, no need to repaint at the waterfall rate
+            if (millis() - lastTextViewDraw >= 500) {
+                lastTextViewDraw = millis();
+                if (trafficView == TRAFFIC_FRAMES) drawFrameBreakdown(graphY, graphH);
+                else if (trafficView == TRAFFIC_TALKERS) drawTopTalkers(graphY, graphH);
+                else if (trafficView == TRAFFIC_CHANNELS) drawChannelStats(graphY, graphH);
+                else drawAnalyzerStats(graphY, graphH);
+            }
+        } else if (wifi.getSpectrogramRows() != spectroRowsDrawn) {
+            drawSpectrogram(graphY, graphH);
+        }
         
-        // Map RSSI to Y position
-        int y = map(rssi, 0, -100, graphY, graphY + graphH - 1);
+        // Update channel/packet info
+        tft.fillRect(2, dataY + 1, tft.width() - 4, 30, FLIPPER_BLACK);
+        tft.drawRoundRect(0, dataY, tft.width(), 32, 6, FLIPPER_GREEN);
+        tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
+        tft.setTextSize(1);
+        tft.setTextDatum(MC_DATUM);
         
-        // Get color based on signal strength
-        uint16_t color = getRssiColor(rssi);
+        // RSSI from the last 1 s bucket, not whichever frame came last
+        char info[48];
+        const RssiSummary& r = cachedStats.rssiSlow;
+        if (r.count > 0) {
+            snprintf(info, 48, "%s:%d Pkts:%lu Rssi:%d p90:%d", wifi.isHopping() ? "Hop" : "Ch",
+                     cachedStats.channel, cachedStats.packetCount, r.mean, r.p90);
+        } else {
+            snprintf(info, 48, "%s:%d Pkts:%lu Rssi:--", wifi.isHopping() ? "Hop" : "Ch",
+                     cachedStats.channel, cachedStats.packetCount);
+        }
+        tft.drawString(info, tft.width()/2, dataY + 9);
         
-        // Draw vertical line from signal to bottom
-        for (int i = y; i < graphY + graphH - 1; i++) {
-            tft.drawPixel(waterfallX, i, color);
+        // Capture queue health
+        QueueStats q = wifi.getPipelineStats().rx;
+        tft.setTextColor(q.dropped > 0 ? FLIPPER_ORANGE : FLIPPER_GRAY, FLIPPER_BLACK);
+        snprintf(info, 48, "Q:%lu/%lu Drop:%lu Lat:%luus", q.highWater, q.capacity, q.dropped, q.latencyAvgUs);
+        tft.drawString(info, tft.width()/2, dataY + 23);
+    }
+}
+
+// Scrolling heatmap: one column per channel, newest tick on top
+void UIManager::drawSpectrogram(int graphY, int graphH) {
+    const int labelH = 10;
+    int colW = (tft.width() - 27) / HOP_CHANNEL_COUNT;
+    int areaH = graphH - labelH - 2;
+    int rowH = max(1, areaH / (SPECTRO_ROWS - 1));
+    int visible = min(SPECTRO_ROWS - 1, areaH / rowH);
+    
+    // Channel labels only need drawing after a clear
+    if (spectroRowsDrawn == 0) {
+        tft.setTextSize(1);
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.setTextDatum(MC_DATUM);
+        char label[4];
+        for (int c = 0; c < HOP_CHANNEL_COUNT; c++) {
+            snprintf(label, 4, "%d", c + HOP_FIRST_CHANNEL);
+            tft.drawString(label, 25 + c * colW + colW / 2, graphY + 5);
+        }
+    }
+    
+    uint32_t total = wifi.getSpectrogramRows();
+    uint8_t row[HOP_CHANNEL_COUNT];
+    int y = graphY + labelH;
+    
+    tft.startWrite();
+    for (int i = 0; i < visible; i++, y += rowH) {
+        // Not written yet, or recycled while we were drawing
+        bool valid = (uint32_t)i < total && wifi.getSpectrogramRow(total - 1 - i, row);
+        for (int c = 0; c < HOP_CHANNEL_COUNT; c++) {
+            uint16_t color = valid ? getHeatColor(row[c]) : FLIPPER_BLACK;
+            tft.fillRect(25 + c * colW, y, colW - 1, rowH, color);
         }
+    }
+    tft.endWrite();
+    
+    spectroRowsDrawn = total;
+}
+
+// One column per UI tick: min..max span of the last 50 ms bucket, with
+// the mean in RSSI color and p90 marked in white
+void UIManager::drawRssiColumn(int graphY, int graphH) {
+    const RssiSummary& r = cachedStats.rssiFast;
+    int bottom = graphY + graphH - 2;
+    
+    tft.drawFastVLine(rssiPlotX, graphY, graphH - 1, FLIPPER_BLACK);
+    if (r.count > 0) {
+        int yMax = map(constrain(r.max, -100, 0), 0, -100, graphY, bottom);
+        int yMin = map(constrain(r.min, -100, 0), 0, -100, graphY, bottom);
+        int yMean = map(constrain(r.mean, -100, 0), 0, -100, graphY, bottom);
+        int yP90 = map(constrain(r.p90, -100, 0), 0, -100, graphY, bottom);
         
-        // Update channel/packet info
-        tft.drawRoundRect(0, dataY, tft.width(), 20, 6, FLIPPER_GREEN);
+        tft.drawFastVLine(rssiPlotX, yMax, yMin - yMax + 1, FLIPPER_GRAY);
+        tft.drawFastVLine(rssiPlotX, yMean - 1, 3, getRssiColor(r.mean));
+        tft.drawPixel(rssiPlotX, yP90, FLIPPER_WHITE);
+    }
+    
+    // Advance, with a blank cursor column ahead of the newest sample
+    rssiPlotX++;
+    if (rssiPlotX >= tft.width() - 2) rssiPlotX = 25;
+    tft.drawFastVLine(rssiPlotX, graphY, graphH - 1, FLIPPER_BLACK);
+}
+
+void UIManager::drawFrameBreakdown(int graphY, int graphH) {
+    FrameHistogram frames;
+    wifi.getFrameHistogram(frames);
+    
+    tft.fillRect(25, graphY, tft.width() - 26, graphH - 1, FLIPPER_BLACK);
+    tft.setTextSize(1);
+    
+    // Flags summary
+    char line[40];
+    uint32_t retryPct = frames.total ? (frames.retries * 100) / frames.total : 0;
+    tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    snprintf(line, 40, "Retry:%lu%% ToDS:%lu FrDS:%lu", retryPct, frames.dsFlags[1], frames.dsFlags[2]);
+    tft.drawString(line, 28, graphY + 3);
+    
+    // Subtypes ordered by count, as many as fit
+    const int rowH = 11;
+    int maxRows = (graphH - 18) / rowH;
+    int barX = 98;
+    int barMaxW = tft.width() - barX - 44;
+    uint32_t topCount = 0;
+    uint64_t drawn = 0; // Bit per slot already listed
+    
+    for (int row = 0; row < maxRows; row++) {
+        int best = -1;
+        for (int slot = 0; slot < FRAME_SLOT_COUNT; slot++) {
+            if ((drawn >> slot) & 1) continue;
+            if (frames.slots[slot] > 0 && (best < 0 || frames.slots[slot] > frames.slots[best])) {
+                best = slot;
+            }
+        }
+        if (best < 0) break;
+        drawn |= (uint64_t)1 << best;
+        if (row == 0) topCount = frames.slots[best];
+        
+        int rowY = graphY + 16 + row * rowH;
+        uint16_t color = FLIPPER_GREEN;
+        if (slotType(best) == FC_TYPE_CTRL) color = FLIPPER_ORANGE;
+        else if (slotType(best) == FC_TYPE_DATA) color = FLIPPER_WHITE;
+        
+        tft.setTextColor(color, FLIPPER_BLACK);
+        tft.setTextDatum(TL_DATUM);
+        tft.drawString(frameSlotName(best), 28, rowY);
+        
+        int barW = (int)((uint64_t)frames.slots[best] * barMaxW / topCount);
+        if (barW < 1) barW = 1;
+        tft.fillRect(barX, rowY + 1, barW, rowH - 4, color);
+        
+        snprintf(line, 40, "%lu", frames.slots[best]);
+        tft.setTextDatum(TR_DATUM);
+        tft.drawString(line, tft.width() - 4, rowY);
+    }
+    
+    if (drawn == 0) {
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.setTextDatum(MC_DATUM);
+        tft.drawString("No frames yet", (tft.width() + 25) / 2, graphY + graphH / 2);
+    }
+}
+
+void UIManager::drawTopTalkers(int graphY, int graphH) {
+    TopTalkers talkers;
+    wifi.getTopTalkers(talkers);
+    
+    tft.fillRect(25, graphY, tft.width() - 26, graphH - 1, FLIPPER_BLACK);
+    tft.setTextSize(1);
+    
+    char line[40];
+    tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    snprintf(line, 40, "Top talkers (%u tracked)", talkers.tracked);
+    tft.drawString(line, 28, graphY + 3);
+    
+    const int rowH = 11;
+    int rows = min((int)talkers.count, (graphH - 18) / rowH);
+    
+    for (int i = 0; i < rows; i++) {
+        const StationInfo& st = talkers.stations[i];
+        int rowY = graphY + 16 + i * rowH;
+        
+        char mac[MAC_STR_LEN];
+        formatMac(st.mac, mac);
         tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
-        tft.setTextSize(1);
+        tft.setTextDatum(TL_DATUM);
+        tft.drawString(mac, 28, rowY);
+        
+        // Last RSSI, colored like the waterfall
+        snprintf(line, 40, "%d", st.lastRssi);
+        tft.setTextColor(getRssiColor(st.lastRssi), FLIPPER_BLACK);
+        tft.setTextDatum(TR_DATUM);
+        tft.drawString(line, tft.width() - 44, rowY);
+        
+        snprintf(line, 40, "%lu", st.frames);
+        tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+        tft.drawString(line, tft.width() - 4, rowY);
+    }
+    
+    if (talkers.count == 0) {
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
         tft.setTextDatum(MC_DATUM);
+        tft.drawString("No transmitters yet", (tft.width() + 25) / 2, graphY + graphH / 2);
+    }
+}
+
+void UIManager::drawChannelStats(int graphY, int graphH) {
+    HopStats hop;
+    wifi.getHopStats(hop);
+    
+    tft.fillRect(25, graphY, tft.width() - 26, graphH - 1, FLIPPER_BLACK);
+    tft.setTextSize(1);
+    
+    char line[40];
+    tft.setTextColor(hop.active ? FLIPPER_GREEN : FLIPPER_GRAY, FLIPPER_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    if (hop.switches > 0) {
+        snprintf(line, 40, "Switch %luus (max %lu)", hop.switchAvgUs, hop.switchMaxUs);
+    } else {
+        snprintf(line, 40, "Tap info bar to hop");
+    }
+    tft.drawString(line, 28, graphY + 3);
+    
+    // One row per channel, bar = smoothed frame rate
+    int rowH = min(11, (graphH - 16) / HOP_CHANNEL_COUNT);
+    int barX = 50;
+    int barMaxW = tft.width() - barX - 40;
+    uint32_t maxRate = 1;
+    for (int i = 0; i < HOP_CHANNEL_COUNT; i++) {
+        if (hop.channels[i].frameRate > maxRate) maxRate = hop.channels[i].frameRate;
+    }
+    
+    for (int i = 0; i < HOP_CHANNEL_COUNT; i++) {
+        const ChannelHopStats& ch = hop.channels[i];
+        int channel = i + HOP_FIRST_CHANNEL;
+        int rowY = graphY + 15 + i * rowH;
+        bool current = hop.active && channel == hop.currentChannel;
         
-        char info[32];
-        snprintf(info, 32, "Ch:%d | Rssi:%d | Pkts:%lu", cachedStats.channel, cachedStats.rssi, cachedStats.packetCount);
-        tft.drawString(info, tft.width()/2, HEADER_HEIGHT + graphH + 4 + (20/2));
+        snprintf(line, 40, "%s%d", current ? ">" : "", channel);
+        tft.setTextColor(current ? FLIPPER_ORANGE : FLIPPER_WHITE, FLIPPER_BLACK);
+        tft.setTextDatum(TR_DATUM);
+        tft.drawString(line, barX - 4, rowY);
         
-        // Advance waterfall
-        waterfallX++;
-        if (waterfallX >= tft.width() - 2) {
-            waterfallX = 25;
-            // Clear graph area
-            tft.fillRect(25, graphY, tft.width() - 26, graphH - 1, FLIPPER_BLACK);
+        int barW = (int)((uint32_t)ch.frameRate * barMaxW / maxRate);
+        if (barW > 0) {
+            tft.fillRect(barX, rowY + 1, barW, rowH - 3, ch.deauths > 0 ? FLIPPER_RED : FLIPPER_GREEN);
         }
+        
+        snprintf(line, 40, "%u/s", ch.frameRate);
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.drawString(line, tft.width() - 4, rowY);
+    }
+}
+
+// Cost of each analyzer on the shared capture path, plus the deauth
+// detector riding along with the sniffer
+void UIManager::drawAnalyzerStats(int graphY, int graphH) {
+    PipelineStats ps = wifi.getPipelineStats();
+    
+    tft.fillRect(25, graphY, tft.width() - 26, graphH - 1, FLIPPER_BLACK);
+    tft.setTextSize(1);
+    
+    char line[40];
+    tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    tft.drawString("Analyzer", 28, graphY + 3);
+    tft.setTextDatum(TR_DATUM);
+    tft.drawString("frames ns/f max", tft.width() - 4, graphY + 3);
+    
+    const int rowH = 11;
+    for (int i = 0; i < ps.analyzerCount; i++) {
+        const AnalyzerStats& a = ps.analyzers[i];
+        int rowY = graphY + 16 + i * rowH;
+        
+        tft.setTextColor(a.enabled ? FLIPPER_GREEN : FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.setTextDatum(TL_DATUM);
+        tft.drawString(a.name, 28, rowY);
+        
+        snprintf(line, 40, "%lu %lu %luus", a.frames, a.nsPerFrame, a.maxPassUs);
+        tft.setTextDatum(TR_DATUM);
+        tft.drawString(line, tft.width() - 4, rowY);
+    }
+    
+    int statusY = graphY + 16 + ps.analyzerCount * rowH + 6;
+    tft.setTextDatum(TL_DATUM);
+    
+    // Frames shorter than a MAC header, dropped before any analyzer, and
+    // the least free stack rxTask has had
+    tft.setTextColor(ps.rxMalformed > 0 ? FLIPPER_ORANGE : FLIPPER_GRAY, FLIPPER_BLACK);
+    snprintf(line, 40, "Malformed: %lu  Stack free: %lu", ps.rxMalformed, ps.rxStackFree);
+    tft.drawString(line, 28, statusY);
+    statusY += rowH;
+    
+    if (wifi.isDeauthDetecting()) {
+        DeauthStats ds = wifi.getDeauthStats();
+        tft.setTextColor(ds.attackDetected ? FLIPPER_RED : FLIPPER_GREEN, FLIPPER_BLACK);
+        snprintf(line, 40, "%s %lu (%u/s)", ds.attackDetected ? "ATTACK! Deauth" : "Deauth",
+                 ds.totalDeauths, ds.totalRate);
+        tft.drawString(line, 28, statusY);
+    } else {
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.drawString("Tap here to watch deauths", 28, statusY);
     }
 }
 
@@ -433,6 +808,44 @@ void UIManager::handleWaterfallTouch() {
             return;
         }
         
+        // Tap on the info bar toggles channel hopping
+        int dataY = tft.height() - 67;
+        if (waterfallRunning && y >= dataY && y <= dataY + 32) {
+            if (wifi.isHopping()) wifi.stopHopping();
+            else wifi.startHopping();
+            delay(200);
+            return;
+        }
+        
+        // Tap on the analyzer view adds or drops the deauth detector
+        if (waterfallRunning && trafficView == TRAFFIC_PIPELINE && y > HEADER_HEIGHT && y < dataY) {
+            if (wifi.isDeauthDetecting()) {
+                wifi.stopDeauthDetector();
+            } else {
+                wifi.resetDeauthStats();
+                wifi.startDeauthDetector();
+            }
+            lastTextViewDraw = 0;
+            delay(200);
+            return;
+        }
+        
+        // View toggle
+        if (x >= 58 && x <= 88 && y >= tft.height() - 33 && y <= tft.height() - 5) {
+            trafficView = (TrafficView)((trafficView + 1) % TRAFFIC_VIEW_COUNT);
+            spectroRowsDrawn = 0;
+            rssiPlotX = 25;
+            lastTextViewDraw = 0;
+            int graphY = HEADER_HEIGHT + 2;
+            int graphH = tft.height() - HEADER_HEIGHT - 71;
+            tft.fillRect(25, graphY, tft.width() - 26, graphH - 1, FLIPPER_BLACK);
+            drawTrafficAxis(graphY, graphH);
+            tft.fillRect(58, tft.height() - 33, 30, 28, FLIPPER_BLACK);
+            drawButton(58, tft.height() - 33, 30, 28, "VIEW", FLIPPER_GREEN, trafficView != TRAFFIC_WATERFALL);
+            delay(200);
+            return;
+        }
+        
         // Start/Stop button
         if (x >= tft.width()/2 - 30 && x <= tft.width()/2 + 30 && 
             y >= tft.height() - 33 && y <= tft.height() - 5) {
@@ -444,9 +857,10 @@ void UIManager::handleWaterfallTouch() {
             } else {
                 wifi.startSniffer();
                 waterfallRunning = true;
-                waterfallX = 25;
+                spectroRowsDrawn = 0;
+                rssiPlotX = 25;
                 int graphY = HEADER_HEIGHT + 2;
-                int graphH = tft.height() - HEADER_HEIGHT - 39;
+                int graphH = tft.height() - HEADER_HEIGHT - 71;
                 tft.fillRect(25, graphY, tft.width() - 26, graphH - 1, FLIPPER_BLACK);
                 drawButton(tft.width()/2 - 30, tft.height() - 33, 60, 28, "STOP", FLIPPER_GREEN, true);
             }
@@ -465,6 +879,8 @@ void UIManager::drawScannerPage() {
     
     // Draw scan button
     drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28, "SCAN", FLIPPER_GREEN);
+    drawButton(tft.width() - 75, tft.height() - 33, 35, 28, "SORT", FLIPPER_GREEN);
+    drawButton(tft.width() - 37, tft.height() - 33, 32, 28, "FLT", FLIPPER_GREEN);
     
     backUi("<<<");
     
@@ -472,40 +888,43 @@ void UIManager::drawScannerPage() {
     tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
     tft.setTextDatum(MC_DATUM);
     tft.drawString("Ready for Scanning", tft.width()/2, tft.height()/2);
+    
+    // Force the list, status line and button to repaint
+    scanListGeneration = 0xFFFFFFFF;
+    scanLastDone = 0xFF;
+    scanLastActive = false;
 }
 
 void UIManager::updateScannerDisplay() {
-    static bool displayDrawn = false;
-    static int lastNetworkCount = -1;
-    
-    // Only update when scan completes and network count changes
-    if (wifi.getState() == STATE_SCANNING) {
-        displayDrawn = false;
-        return;
-    }
+    if (!shouldUpdateDisplay()) return;
     
-    int currentCount = wifi.getNetworkCount();
+    ScanProgress progress = wifi.getScanProgress();
+    int listY = HEADER_HEIGHT + 2;
+    int listH = tft.height() - HEADER_HEIGHT - 37;
+    int statusY = listY + listH - 14;
     
-    // Prevent flickering by drawing only once after scan
-    if (displayDrawn && currentCount == lastNetworkCount) {
-        return;
+    // Button follows the scan task, including when it finishes on its own
+    if (progress.active != scanLastActive) {
+        drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28,
+                   progress.active ? "CANCEL" : "SCAN", FLIPPER_GREEN, progress.active);
     }
     
-    if (currentCount > 0) {
-        int listY = HEADER_HEIGHT + 2;
-        int listH = tft.height() - HEADER_HEIGHT - 37;
+    // Results list, repainted only when the scan task merged something
+    if (progress.generation != scanListGeneration) {
+        WiFiNetwork networks[MAX_NETWORKS];
+        int count = wifi.copyNetworks(networks, MAX_NETWORKS,
+                                      scanFilterPresets[scanFilterPreset].filter, &scanMatched);
+        if (count < 0) return; // Scan task is merging, try again next tick
+        scanListGeneration = progress.generation;
         
-        // Clear list area once
         tft.fillRect(1, listY, tft.width() - 2, listH, FLIPPER_BLACK);
         tft.drawRoundRect(0, listY, tft.width(), listH, 6, FLIPPER_GRAY);
         
-        WiFiNetwork* networks = wifi.getNetworks();
-        
         tft.setTextSize(1);
         int itemH = 28;
-        int maxVisible = listH / itemH;
+        int maxVisible = (listH - 14) / itemH;
         
-        for (int i = 0; i < min(currentCount, maxVisible); i++) {
+        for (int i = 0; i < min(count, maxVisible); i++) {
             int itemY = listY + 2 + (i * itemH);
             
             // SSID
@@ -523,24 +942,58 @@ void UIManager::updateScannerDisplay() {
             tft.setTextDatum(TR_DATUM);
             tft.drawString(String(networks[i].rssi) + "dBm", tft.width() - 5, itemY);
             
-            // Auth type
+            // Auth type and how many scans have reported it
             tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
             tft.setTextDatum(TL_DATUM);
             tft.drawString(wifi.getAuthTypeName(networks[i].encryptionType), 5, itemY + 12);
+            tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+            tft.drawString("x" + String(networks[i].seenCount), 60, itemY + 12);
+            tft.drawString(networks[i].vendor, 95, itemY + 12);
+            tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
             
             // Channel
             tft.setTextDatum(TR_DATUM);
             tft.drawString("Ch:" + String(networks[i].channel), tft.width() - 5, itemY + 12);
             
             // Divider line
-            if (i < min(currentCount, maxVisible) - 1) {
+            if (i < min(count, maxVisible) - 1) {
                 tft.drawLine(5, itemY + itemH - 2, tft.width() - 5, itemY + itemH - 2, FLIPPER_GRAY);
             }
         }
         
-        displayDrawn = true;
-        lastNetworkCount = currentCount;
+        if (count == 0) {
+            tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+            tft.setTextDatum(MC_DATUM);
+            tft.drawString(progress.active ? "Scanning..." : "No networks found", tft.width()/2, tft.height()/2);
+        }
+        scanLastDone = 0xFF; // Status line was wiped with the list
+    }
+    
+    // Progress and UI frame time (shows the UI stays live during a scan)
+    if (progress.channelsDone != scanLastDone || progress.active != scanLastActive || progress.active) {
+        scanLastDone = progress.channelsDone;
+        
+        const char* sortName = networkSortName(wifi.getNetworkSort());
+        const char* filterName = scanFilterPresets[scanFilterPreset].name;
+        char status[48];
+        if (progress.active) {
+            snprintf(status, 48, "Ch %d/%d %s/%s UI %lu/%lums", progress.channel, progress.channelsTotal,
+                     sortName, filterName, frameTimeAvgUs / 1000, frameTimeMaxUs / 1000);
+        } else {
+            snprintf(status, 48, "%s %d/%d %s/%s UI %lums", progress.cancelled ? "Cancel" : "Done",
+                     scanMatched, wifi.getNetworkCount(), sortName, filterName, frameTimeMaxUs / 1000);
+        }
+        
+        tft.fillRect(4, statusY, tft.width() - 8, 12, FLIPPER_BLACK);
+        int barW = (tft.width() - 8) * progress.channelsDone / progress.channelsTotal;
+        if (progress.active && barW > 0) tft.fillRect(4, statusY + 10, barW, 2, FLIPPER_GREEN);
+        tft.setTextSize(1);
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.setTextDatum(TL_DATUM);
+        tft.drawString(status, 6, statusY);
     }
+    
+    scanLastActive = progress.active;
 }
 
 void UIManager::handleScannerTouch() {
@@ -555,24 +1008,145 @@ void UIManager::handleScannerTouch() {
             return;
         }
         
-        // Scan button
+        // Scan / cancel button
         if (x >= tft.width()/2 - 40 && x <= tft.width()/2 + 40 && 
             y >= tft.height() - 33 && y <= tft.height() - 5) {
             
-            drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28, "SCAN", FLIPPER_GREEN, true);
+            if (wifi.isScanning()) {
+                wifi.cancelScan();
+            } else {
+                wifi.startScan();
+                resetFrameTiming();
+            }
+            
+            delay(200);
+            return;
+        }
+        
+        // Sort key: one full re-sort, then incremental again
+        if (x >= tft.width() - 75 && x <= tft.width() - 40 && 
+            y >= tft.height() - 33 && y <= tft.height() - 5) {
+            
+            wifi.setNetworkSort((NetworkSort)((wifi.getNetworkSort() + 1) % NET_SORT_COUNT));
+            delay(200);
+            return;
+        }
+        
+        // Filter preset
+        if (x >= tft.width() - 37 && x <= tft.width() - 5 && 
+            y >= tft.height() - 33 && y <= tft.height() - 5) {
             
-            // Clear display
-            int listY = HEADER_HEIGHT + 2;
-            int listH = tft.height() - HEADER_HEIGHT - 37;
-            tft.fillRect(1, listY, tft.width() - 2, listH, FLIPPER_BLACK);
+            scanFilterPreset = (scanFilterPreset + 1) % SCAN_FILTER_PRESETS;
+            scanListGeneration = 0xFFFFFFFF;
+            delay(200);
+            return;
+        }
+    }
+}
+
+// ==================== CHANNEL LOAD PAGE ====================
+
+void UIManager::drawChannelLoadPage() {
+    tft.fillScreen(FLIPPER_BLACK);
+    headerUi("Channel Load");
+    
+    drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28, "SCAN", FLIPPER_GREEN);
+    backUi("<<<");
+    
+    chanLoadGeneration = 0xFFFFFFFF;
+    scanLastActive = false;
+}
+
+void UIManager::updateChannelLoadDisplay() {
+    if (!shouldUpdateDisplay()) return;
+    
+    ScanProgress progress = wifi.getScanProgress();
+    if (progress.active != scanLastActive) {
+        drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28,
+                   progress.active ? "CANCEL" : "SCAN", FLIPPER_GREEN, progress.active);
+        scanLastActive = progress.active;
+    }
+    
+    // Load is recomputed by the handler on every merge; chart only changes then
+    if (progress.generation == chanLoadGeneration) return;
+    
+    ChannelLoad load;
+    if (!wifi.copyChannelLoad(load)) return;
+    chanLoadGeneration = progress.generation;
+    
+    int areaY = HEADER_HEIGHT + 2;
+    int areaH = tft.height() - HEADER_HEIGHT - 37;
+    tft.fillRect(1, areaY, tft.width() - 2, areaH, FLIPPER_BLACK);
+    drawBorder(0, areaY, tft.width(), areaH, FLIPPER_GRAY);
+    
+    // Recommendation line
+    tft.setTextSize(1);
+    tft.setTextDatum(TL_DATUM);
+    char line[40];
+    if (load.best == 0) {
+        snprintf(line, 40, "%s", progress.active ? "Scanning..." : "No networks found");
+    } else {
+        snprintf(line, 40, "Best: ch %d (%d APs on it)", load.best, load.apCount[load.best - CHAN_LOAD_FIRST]);
+    }
+    tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
+    tft.drawString(line, 5, areaY + 4);
+    
+    // Bars: solid part is APs on the channel, outline on top is overlap
+    // spilling in from +-2 neighbours
+    int barTop = areaY + 28;
+    int barBottom = areaY + areaH - 14;
+    int barMaxH = barBottom - barTop;
+    int slotW = (tft.width() - 10) / CHAN_LOAD_COUNT;
+    
+    for (int c = 0; c < CHAN_LOAD_COUNT; c++) {
+        int x = 5 + c * slotW;
+        uint8_t ch = c + CHAN_LOAD_FIRST;
+        
+        int totalH = load.maxLoad ? (int)((uint64_t)load.load[c] * barMaxH / load.maxLoad) : 0;
+        int directH = load.maxLoad ? (int)((uint64_t)load.direct[c] * barMaxH / load.maxLoad) : 0;
+        if (directH > totalH) directH = totalH;
+        
+        uint8_t level = load.maxLoad ? 16 + (uint8_t)((uint64_t)load.load[c] * 140 / load.maxLoad) : 0;
+        uint16_t color = (ch == load.best) ? FLIPPER_GREEN : getHeatColor(level);
+        
+        if (totalH > directH) {
+            tft.drawRect(x + 1, barBottom - totalH, slotW - 2, totalH - directH + 1, color);
+        }
+        if (directH > 0) {
+            tft.fillRect(x + 1, barBottom - directH, slotW - 2, directH, color);
+        }
+        
+        // AP count above, channel number below
+        tft.setTextDatum(BC_DATUM);
+        if (load.apCount[c] > 0) {
             tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
-            tft.setTextDatum(MC_DATUM);
-            tft.drawString("Scanning...", tft.width()/2, tft.height()/2);
+            tft.drawString(String(load.apCount[c]), x + slotW / 2, barBottom - totalH - 1);
+        }
+        tft.setTextDatum(TC_DATUM);
+        tft.setTextColor(ch == load.best ? FLIPPER_GREEN : FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.drawString(String(ch), x + slotW / 2, barBottom + 3);
+    }
+}
+
+void UIManager::handleChannelLoadTouch() {
+    uint16_t x, y;
+    
+    if (tft.getTouch(&x, &y, 600)) {
+        
+        if (handleBackButton()) {
+            changeState(MENU_WIFI);
+            delay(200);
+            return;
+        }
+        
+        // Scan / cancel button
+        if (x >= tft.width()/2 - 40 && x <= tft.width()/2 + 40 && 
+            y >= tft.height() - 33 && y <= tft.height() - 5) {
             
-            wifi.startScan();
+            if (wifi.isScanning()) wifi.cancelScan();
+            else wifi.startScan();
             
             delay(200);
-            drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28, "SCAN", FLIPPER_GREEN);
             return;
         }
     }
@@ -713,6 +1287,12 @@ void UIManager::drawDeauthPage() {
     // Draw start button
     drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28, "START", FLIPPER_GREEN);
     
+    // Channel hopping toggle
+    drawButton(tft.width() - 45, tft.height() - 33, 40, 28, "HOP", FLIPPER_GREEN, wifi.isHopping());
+    
+    // Live / triage / history toggle
+    drawButton(tft.width() - 78, tft.height() - 33, 30, 28, "VIEW", FLIPPER_GREEN, deauthView != DEAUTH_LIVE);
+    
     backUi("<<<");
 }
 
@@ -730,7 +1310,7 @@ void UIManager::updateDeauthDisplay() {
     tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
     
     char buf[30];
-    snprintf(buf, 30, "Total: %lu", stats.totalDeauths);
+    snprintf(buf, 30, "Total: %lu (%u/s, peak %u)", stats.totalDeauths, stats.totalRate, stats.peakRate);
     tft.drawString(buf, 10, statsY + 5);
     
     snprintf(buf, 30, "Broadcast: %lu", stats.broadcastDeauths);
@@ -739,27 +1319,41 @@ void UIManager::updateDeauthDisplay() {
     snprintf(buf, 30, "Suspicious: %lu", stats.suspiciousCount);
     tft.drawString(buf, 10, statsY + 31);
     
-    if (strlen(stats.suspiciousAP) > 0) {
+    if (!macIsZero(stats.suspiciousAP)) {
+        char mac[MAC_STR_LEN];
+        formatMac(stats.suspiciousAP, mac);
         tft.setTextColor(FLIPPER_ORANGE, FLIPPER_BLACK);
-        snprintf(buf, 30, "AP: %.17s", stats.suspiciousAP);
+        snprintf(buf, 30, "AP: %s", mac);
         tft.drawString(buf, 10, statsY + 44);
     }
     
     // Update alert
+    BeaconFloodStats beacons = wifi.getBeaconFloodStats();
+    TwinStats twins = wifi.getTwinStats();
+    
     int alertY = statsY + 65;
     tft.fillRect(6, alertY + 1, tft.width() - 12, 38, FLIPPER_BLACK);
     tft.setTextDatum(MC_DATUM);
     
-    if (stats.attackDetected) {
+    if (stats.attackDetected || beacons.floodDetected || twins.twinDetected) {
+        // Name whichever detectors are currently firing
+        char fired[30] = "";
+        if (stats.attackDetected) {
+            strcat(fired, stats.disassocFlood ? "Disassoc " : "Deauth ");
+        }
+        if (beacons.floodDetected) strcat(fired, "Beacon ");
+        if (twins.twinDetected) strcat(fired, "Twin");
+        
         tft.setTextColor(FLIPPER_RED, FLIPPER_BLACK);
         tft.setTextSize(2);
         tft.drawString("ATTACK!", tft.width()/2, alertY + 12);
         tft.setTextSize(1);
-        tft.drawString("Detected", tft.width()/2, alertY + 28);
+        tft.drawString(fired, tft.width()/2, alertY + 28);
     } else if (deauthRunning) {
         tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
         tft.setTextSize(1);
-        tft.drawString("Monitoring...", tft.width()/2, alertY + 20);
+        snprintf(buf, 30, "Monitoring %s %d...", wifi.isHopping() ? "hop" : "ch", wifi.getChannel());
+        tft.drawString(buf, tft.width()/2, alertY + 20);
     } else {
         tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
         tft.setTextSize(1);
@@ -773,16 +1367,158 @@ void UIManager::updateDeauthDisplay() {
     tft.setTextSize(1);
     tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
     
-    if (deauthRunning) {
-        tft.drawString("Watching for:", 10, statusY + 5);
+    // Triage views stay readable after STOP, until the next START
+    if (deauthView == DEAUTH_TRIAGE) {
+        drawDeauthTriage(statusY);
+    } else if (deauthView == DEAUTH_HISTORY) {
+        drawDeauthHistory(statusY);
+    } else if (deauthRunning) {
+        PipelineStats ps = wifi.getPipelineStats();
+        QueueStats q = ps.rx;
+        
+        tft.setTextColor(q.dropped > 0 ? FLIPPER_ORANGE : FLIPPER_GRAY, FLIPPER_BLACK);
+        snprintf(buf, 30, "Q:%lu/%lu Drop:%lu Lat:%luus", q.highWater, q.capacity, q.dropped, q.latencyAvgUs);
+        tft.drawString(buf, 10, statusY + 5);
+        
+        // Non-management frames the radio filter kept out of the callback
+        tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
+        snprintf(buf, 30, "HW filter: ~%lu/s skipped", ps.filter.avoidedPerSec);
+        tft.drawString(buf, 10, statusY + 17);
+        
+        tft.setTextColor(stats.disassocFlood ? FLIPPER_RED : FLIPPER_WHITE, FLIPPER_BLACK);
+        snprintf(buf, 30, "Disassoc: %lu (%u/s)", stats.disassocCount, stats.disassocRate);
+        tft.drawString(buf, 10, statusY + 29);
+        
+        tft.setTextColor(beacons.floodDetected ? FLIPPER_RED : FLIPPER_WHITE, FLIPPER_BLACK);
+        snprintf(buf, 30, "Beacons: %u BSSID/s (pk %u)", beacons.bssidsPerSec, beacons.peakBssidsPerSec);
+        tft.drawString(buf, 10, statusY + 41);
+        
+        tft.setTextColor(twins.twinDetected ? FLIPPER_RED : FLIPPER_WHITE, FLIPPER_BLACK);
+        snprintf(buf, 30, "Twins: %lu, %u SSIDs", twins.conflicts, twins.ssidsTracked);
+        tft.drawString(buf, 10, statusY + 53);
+        
+        // Latest twin: SSID prefix, then known vs newcomer
+        if (twins.recentCount > 0) {
+            const TwinConflict& t = twins.recent[0];
+            tft.setTextColor(FLIPPER_ORANGE, FLIPPER_BLACK);
+            snprintf(buf, 30, "%.8s %u/%u %s/%s", t.ssid, t.knownChannel, t.twinChannel,
+                     apSecurityName(t.knownSecurity), apSecurityName(t.twinSecurity));
+            tft.drawString(buf, 10, statusY + 65);
+        }
+        
+        // Per-detector cost on the shared capture path
         tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
-        tft.drawString("- Broadcast deauths", 10, statusY + 18);
-        tft.drawString("- Excessive frames", 10, statusY + 30);
-        tft.drawString("- Repeated attacks", 10, statusY + 42);
-        tft.drawString("- Suspicious APs", 10, statusY + 54);
+        snprintf(buf, 30, "ns/f D:%lu B:%lu T:%lu",
+                 ps.analyzers[RX_DEAUTH].nsPerFrame,
+                 ps.analyzers[RX_BEACONS].nsPerFrame,
+                 ps.analyzers[RX_TWINS].nsPerFrame);
+        tft.drawString(buf, 10, statusY + 77);
+        
+        tft.setTextColor(stats.trackerEvictions > 0 ? FLIPPER_ORANGE : FLIPPER_GRAY, FLIPPER_BLACK);
+        snprintf(buf, 30, "Sources: %u, %lu evicted", stats.trackedSources, stats.trackerEvictions);
+        tft.drawString(buf, 10, statusY + 89);
+        
+        // Targeted AP > client pairs, last three octets of each
+        tft.setTextColor(FLIPPER_ORANGE, FLIPPER_BLACK);
+        for (int i = 0; i < stats.pairCount && i < 2; i++) {
+            const DeauthPair& p = stats.pairs[i];
+            snprintf(buf, 30, "%02X:%02X:%02X>%02X:%02X:%02X %u/s",
+                     p.apMac[3], p.apMac[4], p.apMac[5],
+                     p.clientMac[3], p.clientMac[4], p.clientMac[5], p.rate);
+            tft.drawString(buf, 10, statusY + 101 + i * 12);
+        }
     }
 }
 
+// Reasons, broadcast share, most targeted clients and fastest pairs
+void UIManager::drawDeauthTriage(int statusY) {
+    DeauthAnalytics a = wifi.getDeauthAnalytics();
+    char buf[40];
+    
+    uint32_t frames = a.broadcast + a.unicast;
+    tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+    snprintf(buf, 40, "Bcast %lu / Ucast %lu (%lu%%)", a.broadcast, a.unicast,
+             frames ? a.broadcast * 100 / frames : 0);
+    tft.drawString(buf, 10, statusY + 5);
+    
+    // Three busiest reason buckets
+    tft.drawString("Top reasons:", 10, statusY + 17);
+    tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+    uint32_t shown = 0xFFFFFFFF;
+    for (int row = 0; row < 3; row++) {
+        int best = -1;
+        for (int i = 0; i < DEAUTH_REASON_BUCKETS; i++) {
+            if (a.reasons[i] == 0 || (shown >> i & 1) == 0) continue;
+            if (best < 0 || a.reasons[i] > a.reasons[best]) best = i;
+        }
+        if (best < 0) break;
+        shown &= ~(1UL << best);
+        
+        if (best == DEAUTH_REASON_BUCKETS - 1) {
+            snprintf(buf, 40, "%2d+ %-14s %lu", best, "Other", a.reasons[best]);
+        } else {
+            snprintf(buf, 40, "%3d %-14s %lu", best, reasonCodeName(best), a.reasons[best]);
+        }
+        tft.drawString(buf, 10, statusY + 29 + row * 12);
+    }
+    
+    tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+    tft.drawString("Top targets:", 10, statusY + 65);
+    tft.setTextColor(FLIPPER_ORANGE, FLIPPER_BLACK);
+    for (int i = 0; i < a.targetCount && i < 2; i++) {
+        char mac[MAC_STR_LEN];
+        formatMac(a.targets[i].mac, mac);
+        snprintf(buf, 40, "%s %lu pk%u", mac, a.targets[i].frames, a.targets[i].peakRate);
+        tft.drawString(buf, 10, statusY + 77 + i * 12);
+    }
+    
+    // AP > client pairs by peak rate, last three octets of each
+    tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+    tft.drawString("Fastest pairs:", 10, statusY + 101);
+    tft.setTextColor(FLIPPER_ORANGE, FLIPPER_BLACK);
+    for (int i = 0; i < a.topPairCount && i < 2; i++) {
+        const DeauthPair& p = a.topPairs[i];
+        snprintf(buf, 40, "%02X:%02X:%02X>%02X:%02X:%02X pk %u/s",
+                 p.apMac[3], p.apMac[4], p.apMac[5],
+                 p.clientMac[3], p.clientMac[4], p.clientMac[5], p.rate);
+        tft.drawString(buf, 10, statusY + 113 + i * 12);
+    }
+}
+
+// Newest events first; tap the top/bottom half of the area to scroll
+void UIManager::drawDeauthHistory(int statusY) {
+    const int rows = 10;
+    int size = wifi.getDeauthHistorySize();
+    if (deauthHistoryScroll > size - rows) deauthHistoryScroll = size > rows ? size - rows : 0;
+    
+    if (size == 0) {
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.drawString("No deauths yet", 10, statusY + 5);
+        return;
+    }
+    
+    char buf[40];
+    uint32_t now = millis();
+    int drawn = 0;
+    for (int i = 0; i < rows && deauthHistoryScroll + i < size; i++) {
+        DeauthEvent e;
+        if (!wifi.getDeauthHistory(deauthHistoryScroll + i, e)) continue;
+        
+        tft.setTextColor(macToKey(e.clientMac) == MAC_BROADCAST_KEY ? FLIPPER_ORANGE : FLIPPER_WHITE, FLIPPER_BLACK);
+        snprintf(buf, 40, "%4lus %c %02X:%02X:%02X>%02X:%02X:%02X r%u",
+                 (now - e.timestamp) / 1000, e.subtype == FC_MGMT_DISASSOC ? 'X' : 'D',
+                 e.apMac[3], e.apMac[4], e.apMac[5],
+                 e.clientMac[3], e.clientMac[4], e.clientMac[5], e.reasonCode);
+        tft.drawString(buf, 10, statusY + 5 + drawn * 12);
+        drawn++;
+    }
+    
+    tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+    snprintf(buf, 40, "%d-%d of %d  D=deauth X=disassoc",
+             deauthHistoryScroll + 1, deauthHistoryScroll + drawn, size);
+    tft.drawString(buf, 10, statusY + 5 + rows * 12);
+}
+
 void UIManager::handleDeauthTouch() {
     uint16_t x, y;
     
@@ -795,6 +1531,41 @@ void UIManager::handleDeauthTouch() {
             return;
         }
         
+        // Hop toggle
+        if (deauthRunning && x >= tft.width() - 45 && x <= tft.width() - 5 &&
+            y >= tft.height() - 33 && y <= tft.height() - 5) {
+            if (wifi.isHopping()) wifi.stopHopping();
+            else wifi.startHopping();
+            tft.fillRect(tft.width() - 45, tft.height() - 33, 40, 28, FLIPPER_BLACK);
+            drawButton(tft.width() - 45, tft.height() - 33, 40, 28, "HOP", FLIPPER_GREEN, wifi.isHopping());
+            delay(200);
+            return;
+        }
+        
+        // View toggle
+        if (x >= tft.width() - 78 && x <= tft.width() - 48 &&
+            y >= tft.height() - 33 && y <= tft.height() - 5) {
+            deauthView = (DeauthView)((deauthView + 1) % DEAUTH_VIEW_COUNT);
+            deauthHistoryScroll = 0;
+            tft.fillRect(tft.width() - 78, tft.height() - 33, 30, 28, FLIPPER_BLACK);
+            drawButton(tft.width() - 78, tft.height() - 33, 30, 28, "VIEW", FLIPPER_GREEN, deauthView != DEAUTH_LIVE);
+            lastUpdate = 0;
+            delay(200);
+            return;
+        }
+        
+        // History scroll: upper half newer, lower half older
+        int statusY = HEADER_HEIGHT + 115;
+        int statusH = tft.height() - statusY - 38;
+        if (deauthView == DEAUTH_HISTORY && y > statusY && y < statusY + statusH) {
+            if (y < statusY + statusH / 2) deauthHistoryScroll -= 5;
+            else deauthHistoryScroll += 5;
+            if (deauthHistoryScroll < 0) deauthHistoryScroll = 0;
+            lastUpdate = 0;
+            delay(200);
+            return;
+        }
+        
         // Start/Stop button
         if (x >= tft.width()/2 - 40 && x <= tft.width()/2 + 40 && 
             y >= tft.height() - 33 && y <= tft.height() - 5) {
@@ -803,6 +1574,8 @@ void UIManager::handleDeauthTouch() {
                 wifi.stopDeauthDetector();
                 deauthRunning = false;
                 drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28, "START", FLIPPER_GREEN);
+                tft.fillRect(tft.width() - 45, tft.height() - 33, 40, 28, FLIPPER_BLACK);
+                drawButton(tft.width() - 45, tft.height() - 33, 40, 28, "HOP", FLIPPER_GREEN);
             } else {
                 wifi.resetDeauthStats();
                 wifi.startDeauthDetector();
@@ -816,6 +1589,135 @@ void UIManager::handleDeauthTouch() {
     }
 }
 
+// ==================== PCAP EXPORT PAGE ====================
+
+void UIManager::drawCapturePage() {
+    tft.fillScreen(FLIPPER_BLACK);
+    headerUi("PCAP Export");
+    
+    // Stats area (tap to toggle hopping)
+    int statsY = HEADER_HEIGHT + 5;
+    tft.drawRoundRect(5, statsY, tft.width() - 10, 100, 6, FLIPPER_GRAY);
+    
+    // Hint area
+    int hintY = statsY + 105;
+    tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+    tft.setTextSize(1);
+    tft.setTextDatum(TL_DATUM);
+    tft.drawString("Host: tools/pcap_reader.py", 10, hintY);
+    tft.drawString("Tap stats to toggle hopping", 10, hintY + 12);
+    
+    // Channel controls, snap length and start/stop
+    drawButton(tft.width() - 70, tft.height() - 33, 30, 28, "<", FLIPPER_GREEN);
+    drawButton(tft.width() - 35, tft.height() - 33, 30, 28, ">", FLIPPER_GREEN);
+    drawButton(58, tft.height() - 33, 30, 28, "SNAP", FLIPPER_GREEN);
+    drawButton(tft.width()/2 - 30, tft.height() - 33, 60, 28,
+               captureRunning ? "STOP" : "START", FLIPPER_GREEN, captureRunning);
+    
+    backUi("<<<");
+}
+
+void UIManager::updateCaptureDisplay() {
+    if (!shouldUpdateDisplay()) return;
+    
+    CaptureStats cs = wifi.getCaptureStats();
+    QueueStats q = wifi.getPipelineStats().capture;
+    
+    int statsY = HEADER_HEIGHT + 5;
+    tft.fillRect(6, statsY + 1, tft.width() - 12, 98, FLIPPER_BLACK);
+    tft.setTextSize(1);
+    tft.setTextDatum(TL_DATUM);
+    
+    char buf[40];
+    tft.setTextColor(cs.active ? FLIPPER_GREEN : FLIPPER_GRAY, FLIPPER_BLACK);
+    snprintf(buf, 40, "%s  %lu baud", cs.active ? "Streaming" : "Idle", cs.baud);
+    tft.drawString(buf, 10, statsY + 5);
+    
+    tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+    snprintf(buf, 40, "%s %d  Snap: %u B", wifi.isHopping() ? "Hop" : "Ch",
+             wifi.getChannel(), cs.snapLen);
+    tft.drawString(buf, 10, statsY + 20);
+    
+    snprintf(buf, 40, "Sent: %lu frames", cs.framesSent);
+    tft.drawString(buf, 10, statsY + 35);
+    
+    snprintf(buf, 40, "Bytes: %lu KB", cs.bytesSent / 1024);
+    tft.drawString(buf, 10, statsY + 50);
+    
+    tft.setTextColor(cs.dropped > 0 ? FLIPPER_ORANGE : FLIPPER_WHITE, FLIPPER_BLACK);
+    snprintf(buf, 40, "Dropped (bandwidth): %lu", cs.dropped);
+    tft.drawString(buf, 10, statsY + 65);
+    
+    tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+    snprintf(buf, 40, "Ring: %lu/%lu  Lat: %luus", q.highWater, q.capacity, q.latencyAvgUs);
+    tft.drawString(buf, 10, statsY + 80);
+}
+
+void UIManager::handleCaptureTouch() {
+    uint16_t x, y;
+    
+    if (tft.getTouch(&x, &y, 600)) {
+        
+        // Back button
+        if (handleBackButton()) {
+            changeState(MENU_WIFI);
+            delay(200);
+            return;
+        }
+        
+        // Stats box toggles hopping
+        int statsY = HEADER_HEIGHT + 5;
+        if (captureRunning && y >= statsY && y <= statsY + 100) {
+            if (wifi.isHopping()) wifi.stopHopping();
+            else wifi.startHopping();
+            delay(200);
+            return;
+        }
+        
+        // Channel decrease / increase
+        if (x >= tft.width() - 70 && x <= tft.width() - 40 && y >= tft.height() - 33 && y <= tft.height() - 5) {
+            int ch = wifi.getChannel();
+            if (ch > 1) wifi.setChannel(ch - 1);
+            delay(200);
+            return;
+        }
+        
+        if (x >= tft.width() - 35 && x <= tft.width() - 5 && y >= tft.height() - 33 && y <= tft.height() - 5) {
+            int ch = wifi.getChannel();
+            if (ch < 13) wifi.setChannel(ch + 1);
+            delay(200);
+            return;
+        }
+        
+        // Snap length cycles 64 -> 128 -> 256
+        if (x >= 58 && x <= 88 && y >= tft.height() - 33 && y <= tft.height() - 5) {
+            uint16_t snap = wifi.getCaptureSnapLen();
+            wifi.setCaptureSnapLen(snap >= PCAP_MAX_SNAPLEN ? 64 : snap * 2);
+            delay(200);
+            return;
+        }
+        
+        // Start/Stop button
+        if (x >= tft.width()/2 - 30 && x <= tft.width()/2 + 30 && 
+            y >= tft.height() - 33 && y <= tft.height() - 5) {
+            
+            tft.fillRect(tft.width()/2 - 30, tft.height() - 33, 60, 28, FLIPPER_BLACK);
+            if (captureRunning) {
+                wifi.stopCapture();
+                captureRunning = false;
+                drawButton(tft.width()/2 - 30, tft.height() - 33, 60, 28, "START", FLIPPER_GREEN);
+            } else {
+                wifi.startCapture();
+                captureRunning = true;
+                drawButton(tft.width()/2 - 30, tft.height() - 33, 60, 28, "STOP", FLIPPER_GREEN, true);
+            }
+            
+            delay(200);
+            return;
+        }
+    }
+}
+
 // ==================== SETTINGS ====================
 
 void UIManager::handleListTouch(MenuItem items[], int count, MenuState parentState) {
@@ -897,6 +1799,8 @@ void UIManager::drawBTScannerPage() {
     // Draw scan button
     drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28, 
                btScannerRunning ? "STOP" : "SCAN", FLIPPER_GREEN, btScannerRunning);
+    drawButton(tft.width() - 75, tft.height() - 33, 35, 28, "SORT", FLIPPER_GREEN);
+    drawButton(tft.width() - 37, tft.height() - 33, 32, 28, "FLT", FLIPPER_GREEN);
     
     backUi("X");
     
@@ -905,85 +1809,94 @@ void UIManager::drawBTScannerPage() {
         tft.setTextDatum(MC_DATUM);
         tft.drawString("Press SCAN", tft.width()/2, tft.height()/2);
     }
+    
+    btListSignature = 0;
+    btListLastCheck = 0;
 }
 
 void UIManager::updateBTScannerDisplay() {
-    static bool displayDrawn = false;
-    static int lastDeviceCount = -1;
+    if (!btScannerRunning) return;
     
-    if (!btScannerRunning) {
-        displayDrawn = false;
-        return;
-    }
+    // The list is already sorted and filtered by the handler, so a check
+    // once a second is just a copy of a few rows
+    if (btListLastCheck != 0 && millis() - btListLastCheck < 1000) return;
     
-    int currentCount = bt.getDeviceCount();
+    BTDevice devices[MAX_BT_DEVICES];
+    int matched = 0;
+    int count = bt.copyDevices(devices, MAX_BT_DEVICES, btFilterPresets[btFilterPreset].filter, &matched);
+    if (count < 0) return; // Scan callback holds the list, try again next tick
+    btListLastCheck = millis();
     
-    // Prevent flickering
-    if (displayDrawn && currentCount == lastDeviceCount) {
-        return;
+    int listY = HEADER_HEIGHT + 2;
+    int listH = tft.height() - HEADER_HEIGHT - 37;
+    int itemH = 26;
+    int startY = listY + 18;
+    int maxVisible = (listH - 18) / itemH;
+    int visible = min(count, maxVisible);
+    
+    // Repaint only when a visible row, the order or the header changed
+    uint32_t sig = 2166136261u;
+    sig = (sig ^ (uint32_t)matched) * 16777619u;
+    sig = (sig ^ (uint32_t)bt.getSortMode()) * 16777619u;
+    sig = (sig ^ btFilterPreset) * 16777619u;
+    for (int i = 0; i < visible; i++) {
+        sig = (sig ^ (uint8_t)devices[i].rssi) * 16777619u;
+        for (int c = 9; c < 17; c++) sig = (sig ^ (uint8_t)devices[i].address[c]) * 16777619u;
     }
+    if (sig == btListSignature) return;
+    btListSignature = sig;
     
-    if (millis() % 1000 < 100) { // Update once per second
-        int listY = HEADER_HEIGHT + 2;
-        int listH = tft.height() - HEADER_HEIGHT - 37;
-        
-        tft.fillRect(1, listY, tft.width() - 2, listH, FLIPPER_BLACK);
-        drawBorder(0, listY, tft.width(), listH, FLIPPER_GRAY);
-        
-        BTDevice* devices = bt.getDevices();
-        BTStats stats = bt.getStats();
+    tft.fillRect(1, listY, tft.width() - 2, listH, FLIPPER_BLACK);
+    drawBorder(0, listY, tft.width(), listH, FLIPPER_GRAY);
+    
+    BTStats stats = bt.getStats();
+    
+    // Draw stats header
+    tft.setTextSize(1);
+    tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    
+    char statsStr[40];
+    snprintf(statsStr, 40, "Found: %d/%lu BLE  %s/%s", matched, stats.bleDevices,
+             bt.getSortName(bt.getSortMode()), btFilterPresets[btFilterPreset].name);
+    tft.drawString(statsStr, 5, listY + 3);
+    
+    for (int i = 0; i < visible; i++) {
+        int itemY = startY + (i * itemH);
         
-        // Draw stats header
-        tft.setTextSize(1);
+        // Device name
         tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
         tft.setTextDatum(TL_DATUM);
         
-        char statsStr[40];
-        snprintf(statsStr, 40, "Found: %lu BLE devices", stats.bleDevices);
-        tft.drawString(statsStr, 5, listY + 3);
+        String name = String(devices[i].name);
+        if (!devices[i].hasName) name = "<No Name>";
+        if (name.length() > 16) name = name.substring(0, 13) + "...";
+        tft.drawString(name, 5, itemY);
         
-        int itemH = 26;
-        int startY = listY + 18;
-        int maxVisible = (listH - 18) / itemH;
+        // RSSI
+        uint16_t rssiColor = getRssiColor(devices[i].rssi);
+        tft.setTextColor(rssiColor, FLIPPER_BLACK);
+        tft.setTextDatum(TR_DATUM);
+        tft.drawString(String(devices[i].rssi) + "dB", tft.width() - 5, itemY);
         
-        for (int i = 0; i < min(currentCount, maxVisible); i++) {
-            int itemY = startY + (i * itemH);
-            
-            // Device name
-            tft.setTextColor(FLIPPER_GREEN, FLIPPER_BLACK);
-            tft.setTextDatum(TL_DATUM);
-            
-            String name = String(devices[i].name);
-            if (!devices[i].hasName) name = "<No Name>";
-            if (name.length() > 16) name = name.substring(0, 13) + "...";
-            tft.drawString(name, 5, itemY);
-            
-            // RSSI
-            uint16_t rssiColor = getRssiColor(devices[i].rssi);
-            tft.setTextColor(rssiColor, FLIPPER_BLACK);
-            tft.setTextDatum(TR_DATUM);
-            tft.drawString(String(devices[i].rssi) + "dB", tft.width() - 5, itemY);
-            
-            // Device type
-            tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
-            tft.setTextDatum(TL_DATUM);
-            tft.drawString(bt.getDeviceTypeName(devices[i].deviceType), 5, itemY + 11);
-            
-            // Address (shortened)
-            tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
-            tft.setTextDatum(TR_DATUM);
-            String addr = String(devices[i].address);
-            addr = addr.substring(9); // Last 8 chars
-            tft.drawString(addr, tft.width() - 5, itemY + 11);
-            
-            // Divider
-            if (i < min(currentCount, maxVisible) - 1) {
-                tft.drawLine(5, itemY + itemH - 2, tft.width() - 5, itemY + itemH - 2, FLIPPER_GRAY);
-            }
-        }
+        // Device type and vendor
+        tft.setTextColor(FLIPPER_WHITE, FLIPPER_BLACK);
+        tft.setTextDatum(TL_DATUM);
+        tft.drawString(bt.getDeviceTypeName(devices[i].deviceType), 5, itemY + 11);
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.drawString(devices[i].vendor, 55, itemY + 11);
+        
+        // Address (shortened)
+        tft.setTextColor(FLIPPER_GRAY, FLIPPER_BLACK);
+        tft.setTextDatum(TR_DATUM);
+        String addr = String(devices[i].address);
+        addr = addr.substring(9); // Last 8 chars
+        tft.drawString(addr, tft.width() - 5, itemY + 11);
         
-        displayDrawn = true;
-        lastDeviceCount = currentCount;
+        // Divider
+        if (i < visible - 1) {
+            tft.drawLine(5, itemY + itemH - 2, tft.width() - 5, itemY + itemH - 2, FLIPPER_GRAY);
+        }
     }
 }
 
@@ -1016,12 +1929,34 @@ void UIManager::handleBTScannerTouch() {
                 
                 bt.startScan();
                 btScannerRunning = true;
+                btListSignature = 0;
+                btListLastCheck = 0;
                 drawButton(tft.width()/2 - 40, tft.height() - 33, 80, 28, "STOP", FLIPPER_GREEN, true);
             }
             
             delay(200);
             return;
         }
+        
+        // Sort key
+        if (x >= tft.width() - 75 && x <= tft.width() - 40 && 
+            y >= tft.height() - 33 && y <= tft.height() - 5) {
+            
+            bt.setSortMode((BTSort)((bt.getSortMode() + 1) % BT_SORT_COUNT));
+            btListLastCheck = 0;
+            delay(200);
+            return;
+        }
+        
+        // Filter preset
+        if (x >= tft.width() - 37 && x <= tft.width() - 5 && 
+            y >= tft.height() - 33 && y <= tft.height() - 5) {
+            
+            btFilterPreset = (btFilterPreset + 1) % BT_FILTER_PRESETS;
+            btListLastCheck = 0;
+            delay(200);
+            return;
+        }
     }
 }
 
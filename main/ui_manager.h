@@ -33,8 +33,10 @@ enum MenuState {
     // WiFi Pages
     PAGE_WATERFALL,
     PAGE_SCANNER,
+    PAGE_CHANNEL_LOAD,
     PAGE_SPAM,
     PAGE_DEAUTH,
+    PAGE_PCAP,
 
     // Bluetooth Pages
     PAGE_BT_SCANNER,
@@ -49,6 +51,25 @@ enum MenuState {
     PAGE_RFID_EMIT
 };
 
+// Traffic ANLZ sub-views, cycled by the VIEW button
+enum TrafficView {
+    TRAFFIC_WATERFALL,
+    TRAFFIC_RSSI,
+    TRAFFIC_FRAMES,
+    TRAFFIC_TALKERS,
+    TRAFFIC_CHANNELS,
+    TRAFFIC_PIPELINE,
+    TRAFFIC_VIEW_COUNT
+};
+
+// Deauth Detect status area, cycled by the VIEW button
+enum DeauthView {
+    DEAUTH_LIVE,
+    DEAUTH_TRIAGE,
+    DEAUTH_HISTORY,
+    DEAUTH_VIEW_COUNT
+};
+
 struct MenuItem {
     const char* label;
     MenuState targetState;
@@ -70,29 +91,51 @@ private:
     
     // Update timing
     uint32_t lastUpdate = 0;
+    uint32_t frameTimeAvgUs = 0;  // update() duration, smoothed
+    uint32_t frameTimeMaxUs = 0;
+    bool frameTimingSkip = false;
+    void recordFrameTime(uint32_t us);
+    void resetFrameTiming();
     
     // Cached data
     WiFiStats cachedStats;
     
     // Waterfall state
     bool waterfallRunning = false;
-    int waterfallX = 0;
+    uint32_t spectroRowsDrawn = 0; // Spectrogram row count at last repaint
+    int rssiPlotX = 25;
+    TrafficView trafficView = TRAFFIC_WATERFALL;
+    uint32_t lastTextViewDraw = 0;
     
     // Scanner state
     int scannerScroll = 0;
     int selectedNetwork = -1;
+    uint32_t scanListGeneration = 0xFFFFFFFF; // Result generation on screen
+    uint8_t scanLastDone = 0xFF;
+    bool scanLastActive = false;
+    uint8_t scanFilterPreset = 0;
+    int scanMatched = 0;
+    uint32_t chanLoadGeneration = 0xFFFFFFFF; // Result generation charted
     
     // Spammer state
     bool spammerRunning = false;
     
     // Deauth detector state
     bool deauthRunning = false;
+    DeauthView deauthView = DEAUTH_LIVE;
+    int deauthHistoryScroll = 0;
+    
+    // PCAP export state
+    bool captureRunning = false;
 
     // Bluetooth states
     bool btScannerRunning = false;
     bool btSpammerRunning = false;
     bool btSkimmerRunning = false;
     int btSelectedDevice = -1;
+    uint8_t btFilterPreset = 0;
+    uint32_t btListSignature = 0;   // Hash of the rows on screen
+    uint32_t btListLastCheck = 0;
     
     // Calibration data
     uint16_t calDataLand[5] = { 408, 3433, 290, 3447, 7 };
@@ -112,18 +155,35 @@ private:
     void drawWaterfallPage();
     void updateWaterfall();
     void handleWaterfallTouch();
+    void drawFrameBreakdown(int graphY, int graphH);
+    void drawTopTalkers(int graphY, int graphH);
+    void drawChannelStats(int graphY, int graphH);
+    void drawAnalyzerStats(int graphY, int graphH);
+    void drawSpectrogram(int graphY, int graphH);
+    void drawRssiColumn(int graphY, int graphH);
+    void drawTrafficAxis(int graphY, int graphH);
     
     void drawScannerPage();
     void updateScannerDisplay();
     void handleScannerTouch();
     
+    void drawChannelLoadPage();
+    void updateChannelLoadDisplay();
+    void handleChannelLoadTouch();
+    
     void drawSpammerPage();
     void updateSpammerDisplay();
     void handleSpammerTouch();
     
     void drawDeauthPage();
     void updateDeauthDisplay();
+    void drawDeauthTriage(int statusY);
+    void drawDeauthHistory(int statusY);
     void handleDeauthTouch();
+    
+    void drawCapturePage();
+    void updateCaptureDisplay();
+    void handleCaptureTouch();
 
     void drawBTScannerPage();
     void updateBTScannerDisplay();
@@ -145,6 +205,7 @@ private:
     void changeState(MenuState newState);
     bool shouldUpdateDisplay();
     uint16_t getRssiColor(int8_t rssi);
+    uint16_t getHeatColor(uint8_t level);
     void drawButton(int x, int y, int w, int h, const char* label, uint16_t color, bool pressed = false);
     void drawBorder(int x, int y, int w, int h, uint16_t color);
     bool handleBackButton();
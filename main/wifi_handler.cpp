@@ -1,4 +1,5 @@
 #include "wifi_handler.h"
+#include "oui_lookup.h"
 
 // Spam SSIDs
 const char* WiFiHandler::spamSSIDs[SPAM_SSID_COUNT] = {
@@ -14,39 +15,96 @@ const char* WiFiHandler::spamSSIDs[SPAM_SSID_COUNT] = {
     "Totally Not A Trap"
 };
 
+// PCAP export keeps everything; the RX pipeline derives its filter from
+// the enabled analyzers (filterForSlots)
+static const CaptureFilter CAPTURE_FILTER = {
+    WIFI_PROMIS_FILTER_MASK_MGMT | WIFI_PROMIS_FILTER_MASK_DATA | WIFI_PROMIS_FILTER_MASK_CTRL,
+    WIFI_PROMIS_CTRL_FILTER_MASK_ALL
+};
+
+static uint32_t rxClockUs() {
+    return (uint32_t)esp_timer_get_time();
+}
+
 // Initialize static members
-QueueHandle_t WiFiHandler::dataQueue = NULL;
-QueueHandle_t WiFiHandler::deauthQueue = NULL;
-SemaphoreHandle_t WiFiHandler::statsMutex = NULL;
-SemaphoreHandle_t WiFiHandler::waterfallMutex = NULL;
+SpscRing<WiFiEventData, RX_RING_SIZE> WiFiHandler::rxRing;
+QueueCounters WiFiHandler::rxQueueCounters;
+volatile bool WiFiHandler::rxStopRequested = false;
+std::atomic<uint32_t> WiFiHandler::rxMalformed(0);
+WiFiEventData WiFiHandler::rxBatch[RX_BATCH_SIZE];
+std::atomic<uint32_t> WiFiHandler::rxStackFree(0);
+RxPipeline WiFiHandler::rxPipeline(rxClockUs);
+TrafficAnalyzer WiFiHandler::trafficAnalyzer;
+StationAnalyzer WiFiHandler::stationAnalyzer;
+SpectrogramAnalyzer WiFiHandler::spectroAnalyzer(WiFiHandler::channelFrames);
+DeauthAnalyzer WiFiHandler::deauthAnalyzer;
+BeaconFloodAnalyzer WiFiHandler::beaconAnalyzer;
+TwinAnalyzer WiFiHandler::twinAnalyzer;
+SpscRing<PcapSlot, PCAP_RING_SIZE> WiFiHandler::captureRing;
+QueueCounters WiFiHandler::captureQueueCounters;
+volatile uint16_t WiFiHandler::captureSnapLen = PCAP_DEFAULT_SNAPLEN;
+volatile bool WiFiHandler::captureStopRequested = false;
+std::atomic<uint32_t> WiFiHandler::captureFramesSent(0);
+std::atomic<uint32_t> WiFiHandler::captureBytesSent(0);
 SemaphoreHandle_t WiFiHandler::networkMutex = NULL;
-SemaphoreHandle_t WiFiHandler::deauthMutex = NULL;
-WiFiStats WiFiHandler::stats = {-100, 0, 0, 0, 0, 1, false};
-int WiFiHandler::currentChannel = 1;
-int8_t WiFiHandler::waterfallBuffer[WATERFALL_BUFFER_SIZE];
-int WiFiHandler::waterfallIndex = 0;
-DeauthStats WiFiHandler::deauthStats = {0, 0, 0, false, "", 0};
-DeauthEvent WiFiHandler::deauthHistory[20];
-int WiFiHandler::deauthHistoryIndex = 0;
+volatile int WiFiHandler::currentChannel = 1;
+ChannelHopper WiFiHandler::hopper;
+volatile bool WiFiHandler::hopStopRequested = false;
+Seqlock<HopStats> WiFiHandler::hopSnapshot;
+std::atomic<uint32_t> WiFiHandler::channelFrames[HOP_LAST_CHANNEL + 2];
+std::atomic<uint32_t> WiFiHandler::channelDeauths[HOP_LAST_CHANNEL + 2];
+volatile uint32_t WiFiHandler::activeFilterMask = WIFI_PROMIS_FILTER_MASK_ALL;
+std::atomic<uint32_t> WiFiHandler::filterSampleHits(0);
+std::atomic<uint32_t> WiFiHandler::filterAvoidedPerSec(0);
+uint32_t WiFiHandler::filterSampleStart = 0;
+uint32_t WiFiHandler::filterNextSample = 0;
 
 WiFiHandler::WiFiHandler() 
-    : snifferTaskHandle(NULL), spammerTaskHandle(NULL), deauthTaskHandle(NULL),
-      networkCount(0), moduleState(STATE_IDLE), running(false) {
+    : rxTaskHandle(NULL), spammerTaskHandle(NULL), hopperTaskHandle(NULL), captureTaskHandle(NULL), scanTaskHandle(NULL), consoleBaud(115200),
+      networkTtlMs(NETWORK_DEFAULT_TTL_MS), scanCancelRequested(false), scanCancelled(false), scanChannel(0), scanChannelsDone(0),
+      scanGeneration(0), moduleState(STATE_IDLE), running(false) {
     
-    // Initialize waterfall buffer
-    for (int i = 0; i < WATERFALL_BUFFER_SIZE; i++) {
-        waterfallBuffer[i] = -100;
-    }
+    lastStats = {-100, 0, 0, 0, 0, 1, false, {}, {}};
+    lastDeauthStats = {};
+    lastDeauthAnalytics = {};
+    lastBeaconStats = {};
+    lastTwinStats = {};
+    deauthThresholds = DEAUTH_DEFAULT_THRESHOLDS;
+    memset(&lastFrames, 0, sizeof(lastFrames));
+    memset(&lastTalkers, 0, sizeof(lastTalkers));
+    memset(&lastHopStats, 0, sizeof(lastHopStats));
+    memset(&channelLoad, 0, sizeof(channelLoad));
+    hopConfig = hopper.getConfig();
 }
 
 void WiFiHandler::begin() {
     if (running) return;
 
     // Create mutexes
-    if (statsMutex == NULL) statsMutex = xSemaphoreCreateMutex();
-    if (waterfallMutex == NULL) waterfallMutex = xSemaphoreCreateMutex();
     if (networkMutex == NULL) networkMutex = xSemaphoreCreateMutex();
-    if (deauthMutex == NULL) deauthMutex = xSemaphoreCreateMutex();
+
+    // Analyzer ids are fixed by this order (RxAnalyzerId)
+    if (rxPipeline.count() == 0) {
+        rxPipeline.add(&trafficAnalyzer, RX_SLOTS_ALL);
+        rxPipeline.add(&stationAnalyzer, RX_SLOTS_ALL);
+        rxPipeline.add(&spectroAnalyzer, 0);
+        rxPipeline.add(&deauthAnalyzer, rxSlotBit(SLOT_DEAUTH) | rxSlotBit(SLOT_DISASSOC));
+        uint64_t beacons = rxSlotBit(SLOT_BEACON) | rxSlotBit(SLOT_PROBE_RESP);
+        rxPipeline.add(&beaconAnalyzer, beacons);
+        rxPipeline.add(&twinAnalyzer, beacons, beacons);
+    }
+
+    // Scan table arena: allocated once and never freed, so repeated scans
+    // don't fragment the heap
+    if (networkTable.getCapacity() == 0) {
+        bool psram = psramFound();
+        uint16_t capacity = psram ? NETWORK_TABLE_CAPACITY_PSRAM : NETWORK_TABLE_CAPACITY;
+        uint8_t bits = psram ? NETWORK_HASH_BITS_PSRAM : NETWORK_HASH_BITS;
+        size_t bytes = NetworkTable::arenaSize(capacity, bits);
+        
+        void* arena = psram ? ps_malloc(bytes) : malloc(bytes);
+        if (arena != NULL) networkTable.attach(arena, capacity, bits);
+    }
 
     WiFi.mode(WIFI_STA);
     WiFi.disconnect();
@@ -58,246 +116,768 @@ void WiFiHandler::begin() {
 void WiFiHandler::stop() {
     if (!running) return;
 
-    stopSniffer();
+    stopRxPipeline();
     stopSpammer();
-    stopDeauthDetector();
+    stopCapture();
+    stopScanTask();
     
     running = false;
     moduleState = STATE_IDLE;
 }
 
 void WiFiHandler::cleanupTasks() {
-    if (snifferTaskHandle != NULL) {
-        vTaskDelete(snifferTaskHandle);
-        snifferTaskHandle = NULL;
-    }
+    // Hopper first so it can't switch channel under a new mode
+    stopHopping();
+    stopCaptureTask();
+    stopScanTask();
+    stopRxTask();
     
     if (spammerTaskHandle != NULL) {
         vTaskDelete(spammerTaskHandle);
         spammerTaskHandle = NULL;
     }
+}
+
+// ==================== SNIFFER MODE ====================
+
+void WiFiHandler::startSniffer() {
+    if (isSniffing()) return;
     
-    if (deauthTaskHandle != NULL) {
-        vTaskDelete(deauthTaskHandle);
-        deauthTaskHandle = NULL;
+    // Enabled first so rxTask opens the right filter from its first pass
+    rxPipeline.setEnabled(RX_TRAFFIC, true);
+    rxPipeline.setEnabled(RX_STATIONS, true);
+    rxPipeline.setEnabled(RX_SPECTRO, true);
+    startRxPipeline();
+}
+
+void WiFiHandler::stopSniffer() {
+    rxPipeline.setEnabled(RX_TRAFFIC, false);
+    rxPipeline.setEnabled(RX_STATIONS, false);
+    rxPipeline.setEnabled(RX_SPECTRO, false);
+    stopRxPipelineIfIdle();
+}
+
+WiFiStats WiFiHandler::getStats() {
+    // Never blocks the writer; if it keeps racing us, reuse the last good copy
+    WiFiStats snap;
+    if (trafficAnalyzer.readStats(snap)) {
+        lastStats = snap;
     }
     
-    if (dataQueue != NULL) {
-        vQueueDelete(dataQueue);
-        dataQueue = NULL;
+    lastStats.channel = currentChannel;
+    lastStats.isActive = isSniffing();
+    return lastStats;
+}
+
+void WiFiHandler::resetStats() {
+    if (isSniffing()) {
+        // rxTask owns the counters while running; let it clear them
+        rxPipeline.requestReset(RX_TRAFFIC);
+        rxPipeline.requestReset(RX_STATIONS);
+        return;
     }
     
-    if (deauthQueue != NULL) {
-        vQueueDelete(deauthQueue);
-        deauthQueue = NULL;
+    // Disabled analyzers are never touched by rxTask
+    trafficAnalyzer.reset(millis());
+}
+
+void WiFiHandler::getFrameHistogram(FrameHistogram& out) {
+    FrameHistogram snap;
+    if (trafficAnalyzer.readFrames(snap)) {
+        lastFrames = snap;
     }
+    
+    out = lastFrames;
 }
 
-// ==================== SNIFFER MODE ====================
+void WiFiHandler::getTopTalkers(TopTalkers& out) {
+    TopTalkers snap;
+    if (stationAnalyzer.readTopTalkers(snap)) {
+        lastTalkers = snap;
+    }
+    
+    out = lastTalkers;
+}
 
-void WiFiHandler::startSniffer() {
-    if (moduleState == STATE_SNIFFING) return;
+void WiFiHandler::setChannel(int ch) {
+    if (ch < 1 || ch > 13) return;
     
-    stopSpammer(); // Stop spammer if running
-    cleanupTasks();
+    // A manual pick overrides the scheduler
+    stopHopping();
+    
+    currentChannel = ch;
+    
+    if (moduleState == STATE_SNIFFING || moduleState == STATE_CAPTURING) {
+        esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
+    }
+}
 
-    // Create queue
-    dataQueue = xQueueCreate(50, sizeof(WiFiEventData));
-
-    // Reset statistics
-    if (xSemaphoreTake(statsMutex, portMAX_DELAY)) {
-        stats.rssi = -100;
-        stats.packetCount = 0;
-        stats.mgmtCount = 0;
-        stats.dataCount = 0;
-        stats.ctrlCount = 0;
-        stats.channel = currentChannel;
-        stats.isActive = true;
-        xSemaphoreGive(statsMutex);
-    }
-
-    // Reset waterfall
-    if (xSemaphoreTake(waterfallMutex, portMAX_DELAY)) {
-        waterfallIndex = 0;
-        for (int i = 0; i < WATERFALL_BUFFER_SIZE; i++) {
-            waterfallBuffer[i] = -100;
-        }
-        xSemaphoreGive(waterfallMutex);
+PipelineStats WiFiHandler::getPipelineStats() {
+    PipelineStats ps;
+    ps.rx = rxQueueCounters.snapshot(RX_RING_SIZE);
+    ps.rxMalformed = rxMalformed.load(std::memory_order_relaxed);
+    ps.rxStackFree = rxStackFree.load(std::memory_order_relaxed);
+    ps.capture = captureQueueCounters.snapshot(PCAP_RING_SIZE);
+    ps.filter.frameMask = activeFilterMask;
+    ps.filter.avoidedPerSec = filterAvoidedPerSec.load(std::memory_order_relaxed);
+    ps.analyzerCount = rxPipeline.count();
+    for (int i = 0; i < ps.analyzerCount; i++) {
+        rxPipeline.getStats(i, ps.analyzers[i]);
+    }
+    return ps;
+}
+
+// ==================== PROMISCUOUS FILTER ====================
+
+// Radio filter covering every frame class an analyzer slot mask touches
+CaptureFilter WiFiHandler::filterForSlots(uint64_t slots) {
+    CaptureFilter f = {0, 0};
+    if (slots & RX_SLOTS_MGMT) f.frameMask |= WIFI_PROMIS_FILTER_MASK_MGMT;
+    if (slots & RX_SLOTS_DATA) f.frameMask |= WIFI_PROMIS_FILTER_MASK_DATA;
+    if (slots & RX_SLOTS_CTRL) {
+        f.frameMask |= WIFI_PROMIS_FILTER_MASK_CTRL;
+        f.ctrlMask = WIFI_PROMIS_CTRL_FILTER_MASK_ALL;
+    }
+    return f;
+}
+
+void WiFiHandler::applyFilter(const CaptureFilter& filter) {
+    activeFilterMask = filter.frameMask;
+    filterSampleHits.store(0, std::memory_order_relaxed);
+    filterAvoidedPerSec.store(0, std::memory_order_relaxed);
+    filterSampleStart = 0;
+    filterNextSample = millis() + FILTER_SAMPLE_PERIOD_MS;
+    
+    wifi_promiscuous_filter_t f = { filter.frameMask };
+    esp_wifi_set_promiscuous_filter(&f);
+    if (filter.frameMask & WIFI_PROMIS_FILTER_MASK_CTRL) {
+        wifi_promiscuous_filter_t ctrl = { filter.ctrlMask };
+        esp_wifi_set_promiscuous_ctrl_filter(&ctrl);
+    }
+}
+
+// Called from the consuming task's loop. Briefly lets every frame through
+// so the callbacks can count what the filter normally keeps away.
+void WiFiHandler::sampleFilter(uint32_t now) {
+    if (filterSampleStart == 0) {
+        if ((int32_t)(now - filterNextSample) < 0) return;
+        
+        filterSampleHits.store(0, std::memory_order_relaxed);
+        filterSampleStart = now ? now : 1;
+        wifi_promiscuous_filter_t all = { WIFI_PROMIS_FILTER_MASK_ALL };
+        esp_wifi_set_promiscuous_filter(&all);
+        return;
     }
+    
+    uint32_t elapsed = now - filterSampleStart;
+    if (elapsed < FILTER_SAMPLE_MS) return;
+    
+    wifi_promiscuous_filter_t f = { activeFilterMask };
+    esp_wifi_set_promiscuous_filter(&f);
+    
+    uint32_t hits = filterSampleHits.load(std::memory_order_relaxed);
+    filterAvoidedPerSec.store(hits * 1000 / elapsed, std::memory_order_relaxed);
+    filterSampleStart = 0;
+    filterNextSample = now + FILTER_SAMPLE_PERIOD_MS;
+}
+
+// True (and counted) for a frame class the active mode didn't ask for
+bool WiFiHandler::filterRejects(wifi_promiscuous_pkt_type_t type) {
+    uint32_t bit;
+    switch (type) {
+        case WIFI_PKT_MGMT: bit = WIFI_PROMIS_FILTER_MASK_MGMT; break;
+        case WIFI_PKT_CTRL: bit = WIFI_PROMIS_FILTER_MASK_CTRL; break;
+        case WIFI_PKT_DATA: bit = WIFI_PROMIS_FILTER_MASK_DATA; break;
+        default:            bit = WIFI_PROMIS_FILTER_MASK_MISC; break;
+    }
+    if (activeFilterMask & bit) return false;
+    
+    filterSampleHits.store(filterSampleHits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return true;
+}
 
-    // Start sniffer task
+// Radio metadata + payload pointer, shared by the RX callbacks
+static inline RxFrame toRxFrame(const wifi_promiscuous_pkt_t* pkt, wifi_promiscuous_pkt_type_t type) {
+    RxFrame frame;
+    frame.payload = pkt->payload;
+    frame.len = pkt->rx_ctrl.sig_len;
+    if (type == WIFI_PKT_MGMT) frame.type = PKT_MGMT;
+    else if (type == WIFI_PKT_DATA) frame.type = PKT_DATA;
+    else frame.type = PKT_CTRL;
+    frame.rssi = pkt->rx_ctrl.rssi;
+    frame.channel = pkt->rx_ctrl.channel; // Radio's view, stays right across hops
+    frame.rxTimestamp = pkt->rx_ctrl.timestamp;
+    return frame;
+}
+
+// ==================== SHARED RX PIPELINE ====================
+
+// Brings the capture path up if needed; exclusive radio modes go down
+void WiFiHandler::startRxPipeline() {
+    if (moduleState == STATE_SNIFFING) return;
+    
+    stopSpammer();
+    stopCapture();
+    cleanupTasks();
+    
+    // Neither side of the ring is running here, safe to rewind it
+    rxRing.reset();
+    rxQueueCounters.reset();
+    rxMalformed.store(0, std::memory_order_relaxed);
+    rxStackFree.store(0, std::memory_order_relaxed);
+    rxStopRequested = false;
+    
     xTaskCreatePinnedToCore(
-        snifferTask, 
-        "WiFiSniff", 
-        4096, 
+        rxTask,
+        "WiFiRx",
+        RX_TASK_STACK,
         this,
         2,
-        &snifferTaskHandle, 
+        (TaskHandle_t*)&rxTaskHandle,
         0
     );
-
+    
     moduleState = STATE_SNIFFING;
 }
 
-void WiFiHandler::stopSniffer() {
-    if (moduleState != STATE_SNIFFING) return;
+// Disables every analyzer, for modes that need the radio to themselves
+void WiFiHandler::stopRxPipeline() {
+    for (int i = 0; i < rxPipeline.count(); i++) {
+        rxPipeline.setEnabled(i, false);
+    }
+    stopRxPipelineIfIdle();
+}
 
+void WiFiHandler::stopRxPipelineIfIdle() {
+    if (moduleState != STATE_SNIFFING || rxPipeline.anyEnabled()) return;
+    
     esp_wifi_set_promiscuous(false);
     esp_wifi_set_promiscuous_rx_cb(NULL);
-
+    
     cleanupTasks();
+    moduleState = STATE_IDLE;
+}
 
-    if (xSemaphoreTake(statsMutex, portMAX_DELAY)) {
-        stats.isActive = false;
-        xSemaphoreGive(statsMutex);
+void WiFiHandler::stopRxTask() {
+    if (rxTaskHandle == NULL) return;
+    
+    // Let the task finish its batch so no snapshot is left half written
+    rxStopRequested = true;
+    for (int i = 0; i < 50 && rxTaskHandle != NULL; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
     }
+    
+    if (rxTaskHandle != NULL) {
+        vTaskDelete(rxTaskHandle);
+        rxTaskHandle = NULL;
+    }
+}
 
-    moduleState = STATE_IDLE;
+// Decode once, queue for the analyzers. Frames no enabled analyzer wants
+// (beacons while only the deauth detector runs) stop here.
+void WiFiHandler::rxCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
+    if (filterRejects(type)) return;
+    
+    RxFrame frame = toRxFrame((wifi_promiscuous_pkt_t*)buf, type);
+    FrameView view(frame.payload, frame.len);
+    if (!view.valid()) {
+        countChannelFrame(frame.channel, false);
+        rxMalformed.store(rxMalformed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    
+    uint8_t slot = fcSlot(view.fc());
+    countChannelFrame(frame.channel, slotIsDeauth(slot));
+    if (!rxPipeline.wants(slot)) return;
+    
+    WiFiEventData data;
+    decodeRxFrame(frame, millis(), data, rxPipeline.wantsBody(slot));
+    
+    bool queued = rxRing.push(data);
+    rxQueueCounters.onPush(queued, rxRing.size());
 }
 
-WiFiStats WiFiHandler::getStats() {
-    WiFiStats localStats;
+void WiFiHandler::rxTask(void* pvParameters) {
+    WiFiHandler* handler = (WiFiHandler*)pvParameters;
+    
+    uint64_t appliedSlots = rxPipeline.slotMask();
+    CaptureFilter filter = filterForSlots(appliedSlots);
+    applyFilter(filter);
+    esp_wifi_set_promiscuous(true);
+    esp_wifi_set_promiscuous_rx_cb(&rxCallback);
+    esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
+    
+    // Stack budget: the batch (RX_BATCH_SIZE records, 1.8 KB) is the static
+    // rxBatch, so this frame holds only a few words. The deep paths are the
+    // analyzers' publish passes, which copy a snapshot (TopTalkers,
+    // DeauthAnalytics, a spectrogram row) into a Seqlock, and the esp_wifi
+    // calls. wifi_replay measures the firmware's part at about 0.8 KB of
+    // x86-64 frames (2.6 KB with the batch here), leaving the rest for
+    // esp_wifi. The least free stack seen is published as rxStackFree.
+    uint32_t lastStackCheck = millis() - RX_STACK_CHECK_MS;
     
-    if (xSemaphoreTake(statsMutex, pdMS_TO_TICKS(10))) {
-        localStats = stats;
-        xSemaphoreGive(statsMutex);
-    } else {
-        localStats = {-100, 0, 0, 0, 0, currentChannel, false};
+    while (!rxStopRequested) {
+        // Analyzers came or went: widen or narrow the radio filter to match
+        uint64_t slots = rxPipeline.slotMask();
+        if (slots != appliedSlots) {
+            appliedSlots = slots;
+            CaptureFilter wanted = filterForSlots(slots);
+            if (wanted.frameMask != filter.frameMask) {
+                filter = wanted;
+                applyFilter(filter);
+            }
+        }
+        
+        // Drain everything the callback queued since the last pass
+        size_t n;
+        while (!rxStopRequested && (n = rxRing.popBatch(rxBatch, RX_BATCH_SIZE)) > 0) {
+            uint32_t nowUs = (uint32_t)esp_timer_get_time();
+            for (size_t i = 0; i < n; i++) {
+                rxQueueCounters.onConsume(nowUs - rxBatch[i].rxTimestamp);
+            }
+            rxPipeline.dispatch(rxBatch, n, millis());
+        }
+        
+        // Time-driven work: RSSI buckets, rankings, spectrogram rows, alert expiry
+        rxPipeline.idle(millis());
+        sampleFilter(millis());
+        
+        if (millis() - lastStackCheck >= RX_STACK_CHECK_MS) {
+            lastStackCheck = millis();
+            rxStackFree.store(uxTaskGetStackHighWaterMark(NULL), std::memory_order_relaxed);
+        }
+        
+        // Ring is empty; sleep one tick and drain whatever arrived meanwhile
+        vTaskDelay(1);
     }
     
-    return localStats;
+    handler->rxTaskHandle = NULL;
+    vTaskDelete(NULL);
 }
 
-void WiFiHandler::resetStats() {
-    if (xSemaphoreTake(statsMutex, portMAX_DELAY)) {
-        stats.packetCount = 0;
-        stats.mgmtCount = 0;
-        stats.dataCount = 0;
-        stats.ctrlCount = 0;
-        xSemaphoreGive(statsMutex);
+// ==================== CHANNEL HOPPING ====================
+
+void WiFiHandler::countChannelFrame(uint8_t channel, bool isDeauth) {
+    if (channel > HOP_LAST_CHANNEL) return;
+    
+    // Only one RX callback is installed at a time, so plain load/store is safe
+    channelFrames[channel].store(channelFrames[channel].load(std::memory_order_relaxed) + 1,
+                                 std::memory_order_relaxed);
+    if (isDeauth) {
+        channelDeauths[channel].store(channelDeauths[channel].load(std::memory_order_relaxed) + 1,
+                                      std::memory_order_relaxed);
     }
 }
 
-void WiFiHandler::setChannel(int ch) {
-    if (ch < 1 || ch > 13) return;
+void WiFiHandler::startHopping() {
+    if (hopperTaskHandle != NULL) return;
+    if (moduleState != STATE_SNIFFING && moduleState != STATE_CAPTURING) return;
     
-    currentChannel = ch;
+    // Task isn't running, so the scheduler has no other user right now
+    hopper.setConfig(hopConfig);
+    hopper.reset();
     
-    if (moduleState == STATE_SNIFFING) {
-        esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
+    HopStats initial = hopper.getStats();
+    initial.active = true;
+    hopSnapshot.write(initial);
+    hopStopRequested = false;
+    
+    // Above the capture tasks so dwell timing isn't stretched by them
+    xTaskCreatePinnedToCore(
+        hopperTask,
+        "WiFiHop",
+        2048,
+        this,
+        3,
+        (TaskHandle_t*)&hopperTaskHandle,
+        0
+    );
+}
+
+void WiFiHandler::stopHopping() {
+    if (hopperTaskHandle == NULL) return;
+    
+    // Never delete the task inside esp_wifi_set_channel() or halfway
+    // through a snapshot; it checks the flag between slices of its dwell
+    // and publishes its own final snapshot
+    hopStopRequested = true;
+    for (int i = 0; i < 50 && hopperTaskHandle != NULL; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
     }
     
-    if (xSemaphoreTake(statsMutex, portMAX_DELAY)) {
-        stats.channel = currentChannel;
-        xSemaphoreGive(statsMutex);
+    if (hopperTaskHandle != NULL) {
+        vTaskDelete(hopperTaskHandle);
+        hopperTaskHandle = NULL;
+        
+        // Task is gone now, so the scheduler has no other user
+        HopStats last = hopper.getStats();
+        last.active = false;
+        hopSnapshot.write(last);
+    }
+}
+
+void WiFiHandler::getHopStats(HopStats& out) {
+    HopStats snap;
+    if (hopSnapshot.tryRead(snap)) {
+        lastHopStats = snap;
     }
+    
+    out = lastHopStats;
 }
 
-int WiFiHandler::getWaterfallData(int8_t* buffer, int maxSize) {
-    int count = min(maxSize, WATERFALL_BUFFER_SIZE);
+void WiFiHandler::hopperTask(void* pvParameters) {
+    WiFiHandler* handler = (WiFiHandler*)pvParameters;
     
-    if (xSemaphoreTake(waterfallMutex, pdMS_TO_TICKS(10))) {
-        for (int i = 0; i < count; i++) {
-            int idx = (waterfallIndex + i) % WATERFALL_BUFFER_SIZE;
-            buffer[i] = waterfallBuffer[idx];
+    // The channel counters are shared with the spectrogram and never
+    // reset; dwells are credited with deltas from where they stand now
+    uint32_t seenFrames[HOP_LAST_CHANNEL + 2];
+    uint32_t seenDeauths[HOP_LAST_CHANNEL + 2];
+    for (int i = 0; i <= HOP_LAST_CHANNEL + 1; i++) {
+        seenFrames[i] = channelFrames[i].load(std::memory_order_relaxed);
+        seenDeauths[i] = channelDeauths[i].load(std::memory_order_relaxed);
+    }
+    
+    while (!hopStopRequested) {
+        uint8_t ch = currentChannel;
+        uint32_t dwellStart = millis();
+        uint16_t dwell = hopper.dwellFor(ch);
+        
+        // Dwell in short slices so a stop request is seen quickly
+        while (!hopStopRequested && millis() - dwellStart < dwell) {
+            uint32_t left = dwell - (millis() - dwellStart);
+            vTaskDelay(pdMS_TO_TICKS(left < HOP_STOP_SLICE_MS ? left : HOP_STOP_SLICE_MS));
         }
-        xSemaphoreGive(waterfallMutex);
-        return count;
+        if (hopStopRequested) break;
+        
+        // Credit this dwell with what the callbacks saw on the channel
+        uint32_t frames = channelFrames[ch].load(std::memory_order_relaxed);
+        uint32_t deauths = channelDeauths[ch].load(std::memory_order_relaxed);
+        hopper.endDwell(ch, frames - seenFrames[ch], deauths - seenDeauths[ch], millis() - dwellStart);
+        seenFrames[ch] = frames;
+        seenDeauths[ch] = deauths;
+        
+        uint8_t next = hopper.nextChannel(ch);
+        int64_t t0 = esp_timer_get_time();
+        esp_wifi_set_channel(next, WIFI_SECOND_CHAN_NONE);
+        hopper.recordSwitch(next, (uint32_t)(esp_timer_get_time() - t0));
+        currentChannel = next;
+        
+        HopStats hs = hopper.getStats();
+        hs.active = true;
+        hopSnapshot.write(hs);
     }
     
-    return 0;
+    HopStats last = hopper.getStats();
+    last.active = false;
+    hopSnapshot.write(last);
+    
+    handler->hopperTaskHandle = NULL;
+    vTaskDelete(NULL);
 }
 
-void WiFiHandler::snifferCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
-    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
-    WiFiEventData data;
+// ==================== PCAP EXPORT ====================
+
+void WiFiHandler::startCapture() {
+    if (moduleState == STATE_CAPTURING) return;
+    
+    stopRxPipeline();
+    stopSpammer();
+    cleanupTasks();
+    
+    captureRing.reset();
+    captureQueueCounters.reset();
+    captureFramesSent.store(0, std::memory_order_relaxed);
+    captureBytesSent.store(0, std::memory_order_relaxed);
+    captureStopRequested = false;
+    
+    // The stream is binary from here on; the host reader resyncs on frames
+    Serial.flush();
+    consoleBaud = Serial.baudRate();
+    Serial.updateBaudRate(PCAP_SERIAL_BAUD);
+    
+    xTaskCreatePinnedToCore(
+        captureTask,
+        "PcapTx",
+        4096,
+        this,
+        1,
+        (TaskHandle_t*)&captureTaskHandle,
+        0
+    );
+    
+    applyFilter(CAPTURE_FILTER);
+    esp_wifi_set_promiscuous(true);
+    esp_wifi_set_promiscuous_rx_cb(&captureCallback);
+    esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
+    
+    moduleState = STATE_CAPTURING;
+}
 
-    data.rssi = pkt->rx_ctrl.rssi;
-    data.channel = currentChannel;
-    data.timestamp = millis();
+void WiFiHandler::stopCapture() {
+    if (moduleState != STATE_CAPTURING) return;
+    
+    esp_wifi_set_promiscuous(false);
+    esp_wifi_set_promiscuous_rx_cb(NULL);
+    
+    cleanupTasks();
+    
+    Serial.flush();
+    Serial.updateBaudRate(consoleBaud);
     
-    if (type == WIFI_PKT_MGMT) data.type = PKT_MGMT;
-    else if (type == WIFI_PKT_DATA) data.type = PKT_DATA;
-    else data.type = PKT_CTRL;
+    moduleState = STATE_IDLE;
+}
 
-    uint8_t* payload = pkt->payload;
-    snprintf(data.bssid, 18, "%02X:%02X:%02X:%02X:%02X:%02X", 
-             payload[10], payload[11], payload[12], 
-             payload[13], payload[14], payload[15]);
+void WiFiHandler::stopCaptureTask() {
+    if (captureTaskHandle == NULL) return;
+    
+    // Let the task leave on its own: deleting it inside Serial.write()
+    // would leave the UART lock held
+    captureStopRequested = true;
+    for (int i = 0; i < 50 && captureTaskHandle != NULL; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    
+    if (captureTaskHandle != NULL) {
+        vTaskDelete(captureTaskHandle);
+        captureTaskHandle = NULL;
+    }
+}
 
-    xQueueSendFromISR(dataQueue, &data, NULL);
+void WiFiHandler::setCaptureSnapLen(uint16_t len) {
+    if (len < 24) len = 24; // Always keep the MAC header
+    if (len > PCAP_MAX_SNAPLEN) len = PCAP_MAX_SNAPLEN;
+    captureSnapLen = len;
 }
 
-void WiFiHandler::snifferTask(void* pvParameters) {
-    esp_wifi_set_promiscuous(true);
-    esp_wifi_set_promiscuous_rx_cb(&snifferCallback);
-    esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
+CaptureStats WiFiHandler::getCaptureStats() {
+    CaptureStats cs;
+    cs.framesSent = captureFramesSent.load(std::memory_order_relaxed);
+    cs.bytesSent = captureBytesSent.load(std::memory_order_relaxed);
+    cs.dropped = captureQueueCounters.dropped.load(std::memory_order_relaxed);
+    cs.baud = PCAP_SERIAL_BAUD;
+    cs.snapLen = captureSnapLen;
+    cs.active = (moduleState == STATE_CAPTURING);
+    return cs;
+}
 
-    WiFiEventData receivedData;
+void WiFiHandler::captureCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
+    if (filterRejects(type)) return;
     
-    for (;;) {
-        if (xQueueReceive(dataQueue, &receivedData, pdMS_TO_TICKS(100))) {
-            
-            // Update statistics
-            if (xSemaphoreTake(statsMutex, pdMS_TO_TICKS(5))) {
-                stats.rssi = receivedData.rssi;
-                stats.packetCount++;
-                
-                switch (receivedData.type) {
-                    case PKT_MGMT: stats.mgmtCount++; break;
-                    case PKT_DATA: stats.dataCount++; break;
-                    case PKT_CTRL: stats.ctrlCount++; break;
-                    default: break;
-                }
-                
-                xSemaphoreGive(statsMutex);
-            }
+    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
+    countChannelFrame(pkt->rx_ctrl.channel, false);
+    
+    // Copy straight into the ring slot; a full ring means the link is saturated
+    PcapSlot* slot = captureRing.claim();
+    if (slot == NULL) {
+        captureQueueCounters.onPush(false, PCAP_RING_SIZE);
+        return;
+    }
+    
+    int64_t now = esp_timer_get_time();
+    uint16_t len = pkt->rx_ctrl.sig_len;
+    uint16_t snap = captureSnapLen;
+    
+    slot->tsSec = (uint32_t)(now / 1000000);
+    slot->tsUsec = (uint32_t)(now % 1000000);
+    slot->origLen = len;
+    slot->capLen = len < snap ? len : snap;
+    slot->rssi = pkt->rx_ctrl.rssi;
+    slot->channel = pkt->rx_ctrl.channel;
+    memcpy(slot->data, pkt->payload, slot->capLen);
+    
+    captureRing.commit();
+    captureQueueCounters.onPush(true, captureRing.size());
+}
 
-            // Update waterfall buffer
-            if (xSemaphoreTake(waterfallMutex, pdMS_TO_TICKS(5))) {
-                waterfallBuffer[waterfallIndex] = receivedData.rssi;
-                waterfallIndex = (waterfallIndex + 1) % WATERFALL_BUFFER_SIZE;
-                xSemaphoreGive(waterfallMutex);
-            }
+void WiFiHandler::captureTask(void* pvParameters) {
+    WiFiHandler* handler = (WiFiHandler*)pvParameters;
+    uint8_t frame[PCAP_FRAME_MAX];
+    bool headerSent = false;
+    uint32_t lastHeader = 0;
+    
+    while (!captureStopRequested) {
+        // Re-announce the global header so a late-attaching reader can start
+        if (!headerSent || millis() - lastHeader >= 2000) {
+            size_t n = pcapEncodeGlobalHeader(frame, captureSnapLen);
+            Serial.write(frame, n);
+            headerSent = true;
+            lastHeader = millis();
+        }
+        
+        const PcapSlot* slot;
+        while (!captureStopRequested && (slot = captureRing.front()) != NULL) {
+            uint32_t ageUs = (uint32_t)(esp_timer_get_time() -
+                                        ((int64_t)slot->tsSec * 1000000 + slot->tsUsec));
+            size_t n = pcapEncodeRecord(*slot, frame);
+            captureRing.release(); // Free the slot before the slow UART write
+            captureQueueCounters.onConsume(ageUs);
+            
+            Serial.write(frame, n);
+            captureFramesSent.store(captureFramesSent.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            captureBytesSent.store(captureBytesSent.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
         }
         
         vTaskDelay(1);
     }
+    
+    handler->captureTaskHandle = NULL;
+    vTaskDelete(NULL);
 }
 
 // ==================== SCANNER MODE ====================
 
 void WiFiHandler::startScan() {
-    if (moduleState == STATE_SCANNING) return;
+    if (isScanning()) return;
     
-    stopSniffer();
+    stopRxPipeline();
     stopSpammer();
+    stopCapture();
+    cleanupTasks();
     
+    scanCancelRequested = false;
+    scanCancelled = false;
+    scanChannelsDone = 0;
+    scanChannel = HOP_FIRST_CHANNEL;
     moduleState = STATE_SCANNING;
     
-    // Perform WiFi scan
-    int n = WiFi.scanNetworks(false, false, false, 300);
+    xTaskCreatePinnedToCore(
+        scanTask,
+        "WiFiScan",
+        4096,
+        this,
+        1,
+        (TaskHandle_t*)&scanTaskHandle,
+        0
+    );
+}
+
+void WiFiHandler::scanTask(void* pvParameters) {
+    WiFiHandler* handler = (WiFiHandler*)pvParameters;
     
-    if (xSemaphoreTake(networkMutex, portMAX_DELAY)) {
-        networkCount = min(n, MAX_NETWORKS);
+    // One blocking scan per channel so results reach the UI as they come
+    for (uint8_t ch = HOP_FIRST_CHANNEL; ch <= HOP_LAST_CHANNEL; ch++) {
+        if (handler->scanCancelRequested) break;
         
-        for (int i = 0; i < networkCount; i++) {
-            strncpy(networks[i].ssid, WiFi.SSID(i).c_str(), 32);
-            networks[i].ssid[32] = '\0';
-            networks[i].rssi = WiFi.RSSI(i);
-            networks[i].channel = WiFi.channel(i);
-            networks[i].encryptionType = WiFi.encryptionType(i);
-            
-            uint8_t* bssid = WiFi.BSSID(i);
-            snprintf(networks[i].bssid, 18, "%02X:%02X:%02X:%02X:%02X:%02X",
-                     bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
-        }
+        handler->scanChannel = ch;
+        int n = WiFi.scanNetworks(false, false, false, SCAN_DWELL_MS, ch);
+        if (n > 0) handler->mergeScanResults(n);
+        WiFi.scanDelete();
+        handler->scanChannelsDone = handler->scanChannelsDone + 1;
+    }
+    
+    handler->scanCancelled = handler->scanCancelRequested;
+    handler->scanChannel = 0;
+    if (handler->moduleState == STATE_SCANNING) handler->moduleState = STATE_IDLE;
+    
+    handler->scanTaskHandle = NULL;
+    vTaskDelete(NULL);
+}
+
+void WiFiHandler::stopScanTask() {
+    if (scanTaskHandle == NULL) return;
+    
+    // Never delete the task inside scanNetworks(), the driver would be
+    // left mid-scan; give the current channel time to finish instead
+    scanCancelRequested = true;
+    for (int i = 0; i < 50 && scanTaskHandle != NULL; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    
+    if (scanTaskHandle != NULL) {
+        vTaskDelete(scanTaskHandle);
+        scanTaskHandle = NULL;
+        WiFi.scanDelete();
+    }
+    
+    if (moduleState == STATE_SCANNING) moduleState = STATE_IDLE;
+}
+
+// Fold the current scan results into the network table and age out
+// anything unseen for the TTL
+void WiFiHandler::mergeScanResults(int count) {
+    if (!xSemaphoreTake(networkMutex, portMAX_DELAY)) return;
+    
+    uint32_t now = millis();
+    for (int i = 0; i < count; i++) {
+        NetworkEntry* e = networkTable.observe(macToKey(WiFi.BSSID(i)), WiFi.RSSI(i), now);
+        if (e == NULL) break;
         
-        xSemaphoreGive(networkMutex);
+        strncpy(e->ssid, WiFi.SSID(i).c_str(), 32);
+        e->ssid[32] = '\0';
+        e->channel = WiFi.channel(i);
+        e->encryptionType = WiFi.encryptionType(i);
+        networkTable.reindex(e);
     }
+    networkTable.expire(now, networkTtlMs);
+    computeChannelLoad(networkTable, channelLoad);
     
-    WiFi.scanDelete();
-    moduleState = STATE_IDLE;
+    scanGeneration = scanGeneration + 1;
+    xSemaphoreGive(networkMutex);
+}
+
+int WiFiHandler::copyNetworks(WiFiNetwork* out, int maxCount, const NetworkFilter& filter, int* matched) {
+    if (!xSemaphoreTake(networkMutex, pdMS_TO_TICKS(10))) return -1;
+    
+    // Walk in rank order; the filter is a few compares per entry
+    int n = 0;
+    int total = 0;
+    for (uint16_t r = 0; r < networkTable.size(); r++) {
+        const NetworkEntry& e = networkTable.ranked(r);
+        if (!filter.matches(e)) continue;
+        total++;
+        if (n >= maxCount) continue;
+        
+        WiFiNetwork& net = out[n++];
+        memcpy(net.ssid, e.ssid, sizeof(net.ssid));
+        net.rssi = e.rssi;
+        net.rssiAvg = NetworkTable::averageRssi(e);
+        net.channel = e.channel;
+        net.encryptionType = e.encryptionType;
+        keyToMac(e.key, net.bssid);
+        net.vendor = macVendor(net.bssid);
+        net.seenCount = e.seenCount;
+        net.firstSeen = e.firstSeen;
+        net.lastSeen = e.lastSeen;
+    }
+    
+    xSemaphoreGive(networkMutex);
+    if (matched != NULL) *matched = total;
+    return n;
+}
+
+void WiFiHandler::setNetworkSort(NetworkSort sort) {
+    if (xSemaphoreTake(networkMutex, portMAX_DELAY)) {
+        networkTable.setSort(sort);
+        scanGeneration = scanGeneration + 1;
+        xSemaphoreGive(networkMutex);
+    }
+}
+
+void WiFiHandler::clearNetworks() {
+    if (xSemaphoreTake(networkMutex, portMAX_DELAY)) {
+        networkTable.clear();
+        computeChannelLoad(networkTable, channelLoad);
+        scanGeneration = scanGeneration + 1;
+        xSemaphoreGive(networkMutex);
+    }
+}
+
+bool WiFiHandler::copyChannelLoad(ChannelLoad& out) {
+    if (!xSemaphoreTake(networkMutex, pdMS_TO_TICKS(10))) return false;
+    out = channelLoad;
+    xSemaphoreGive(networkMutex);
+    return true;
+}
+
+ScanProgress WiFiHandler::getScanProgress() {
+    ScanProgress p;
+    p.channel = scanChannel;
+    p.channelsDone = scanChannelsDone;
+    p.channelsTotal = HOP_CHANNEL_COUNT;
+    p.active = isScanning();
+    p.cancelled = scanCancelled;
+    p.generation = scanGeneration;
+    return p;
 }
 
 const char* WiFiHandler::getAuthTypeName(uint8_t authType) {
@@ -360,7 +940,7 @@ void WiFiHandler::createBeaconFrame(uint8_t* packet, const char* ssid, uint8_t c
 void WiFiHandler::startSpammer() {
     if (moduleState == STATE_SPAMMING) return;
     
-    stopSniffer();
+    stopRxPipeline();
     cleanupTasks();
     
     moduleState = STATE_SPAMMING;
@@ -409,187 +989,81 @@ void WiFiHandler::spammerTask(void* pvParameters) {
 // ==================== DEAUTH DETECTOR ====================
 
 void WiFiHandler::startDeauthDetector() {
-    if (moduleState == STATE_DEAUTH_DETECT) return;
+    if (isDeauthDetecting()) return;
     
-    stopSniffer();
-    stopSpammer();
-    cleanupTasks();
-
-    // Create queue
-    deauthQueue = xQueueCreate(30, sizeof(DeauthEvent));
-
-    // Reset stats
-    resetDeauthStats();
-
-    // Start detector task
-    xTaskCreatePinnedToCore(
-        deauthDetectorTask,
-        "DeauthDet",
-        4096,
-        this,
-        2,
-        &deauthTaskHandle,
-        0
-    );
-
-    moduleState = STATE_DEAUTH_DETECT;
+    deauthAnalyzer.setThresholds(deauthThresholds);
+    beaconAnalyzer.setThresholds(deauthThresholds);
+    twinAnalyzer.setThresholds(deauthThresholds);
+    rxPipeline.setEnabled(RX_DEAUTH, true);
+    rxPipeline.setEnabled(RX_BEACONS, true);
+    rxPipeline.setEnabled(RX_TWINS, true);
+    startRxPipeline();
 }
 
 void WiFiHandler::stopDeauthDetector() {
-    if (moduleState != STATE_DEAUTH_DETECT) return;
-
-    esp_wifi_set_promiscuous(false);
-    esp_wifi_set_promiscuous_rx_cb(NULL);
-
-    cleanupTasks();
-    moduleState = STATE_IDLE;
+    rxPipeline.setEnabled(RX_DEAUTH, false);
+    rxPipeline.setEnabled(RX_BEACONS, false);
+    rxPipeline.setEnabled(RX_TWINS, false);
+    stopRxPipelineIfIdle();
 }
 
 DeauthStats WiFiHandler::getDeauthStats() {
-    DeauthStats localStats;
-    
-    if (xSemaphoreTake(deauthMutex, pdMS_TO_TICKS(10))) {
-        localStats = deauthStats;
-        xSemaphoreGive(deauthMutex);
-    } else {
-        localStats = {0, 0, 0, false, "", 0};
+    DeauthStats snap;
+    if (deauthAnalyzer.readStats(snap)) {
+        lastDeauthStats = snap;
     }
     
-    return localStats;
+    return lastDeauthStats;
 }
 
-void WiFiHandler::resetDeauthStats() {
-    if (xSemaphoreTake(deauthMutex, portMAX_DELAY)) {
-        deauthStats.totalDeauths = 0;
-        deauthStats.broadcastDeauths = 0;
-        deauthStats.suspiciousCount = 0;
-        deauthStats.attackDetected = false;
-        deauthStats.suspiciousAP[0] = '\0';
-        deauthStats.lastDetectionTime = 0;
-        deauthHistoryIndex = 0;
-        xSemaphoreGive(deauthMutex);
+DeauthAnalytics WiFiHandler::getDeauthAnalytics() {
+    DeauthAnalytics snap;
+    if (deauthAnalyzer.readAnalytics(snap)) {
+        lastDeauthAnalytics = snap;
     }
+    
+    return lastDeauthAnalytics;
 }
 
-void WiFiHandler::deauthCallback(void* buf, wifi_promiscuous_pkt_type_t type) {
-    if (type != WIFI_PKT_MGMT) return;
-    
-    wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf;
-    uint8_t* payload = pkt->payload;
-    
-    // Check if it's a deauth frame (type 0xC0)
-    if (payload[0] != 0xC0 && payload[0] != 0xA0) return;
-    
-    DeauthEvent event;
-    event.timestamp = millis();
-    event.rssi = pkt->rx_ctrl.rssi;
-    event.reasonCode = payload[24]; // Reason code at offset 24
-    
-    // Extract AP MAC (address 2)
-    snprintf(event.apMac, 18, "%02X:%02X:%02X:%02X:%02X:%02X",
-             payload[10], payload[11], payload[12],
-             payload[13], payload[14], payload[15]);
-    
-    // Extract Client MAC (address 1)
-    snprintf(event.clientMac, 18, "%02X:%02X:%02X:%02X:%02X:%02X",
-             payload[4], payload[5], payload[6],
-             payload[7], payload[8], payload[9]);
-    
-    xQueueSendFromISR(deauthQueue, &event, NULL);
+bool WiFiHandler::getDeauthHistory(int age, DeauthEvent& out) {
+    return deauthAnalyzer.readHistory(age, out);
 }
 
-void WiFiHandler::deauthDetectorTask(void* pvParameters) {
-    esp_wifi_set_promiscuous(true);
-    esp_wifi_set_promiscuous_rx_cb(&deauthCallback);
-    esp_wifi_set_channel(currentChannel, WIFI_SECOND_CHAN_NONE);
+int WiFiHandler::getDeauthHistorySize() {
+    return deauthAnalyzer.historySize();
+}
 
-    DeauthEvent event;
-    uint32_t lastDeauthTime = 0;
-    uint32_t deauthsInWindow = 0;
-    const uint32_t WINDOW_MS = 1000; // 1 second window
-    const uint32_t THRESHOLD = 10; // 10 deauths in 1 second is suspicious
-    
-    // Track AP frequencies
-    struct APTracker {
-        char mac[18];
-        uint32_t count;
-        uint32_t lastSeen;
-    };
-    APTracker apTrackers[10];
-    int trackerCount = 0;
+BeaconFloodStats WiFiHandler::getBeaconFloodStats() {
+    BeaconFloodStats snap;
+    if (beaconAnalyzer.readStats(snap)) {
+        lastBeaconStats = snap;
+    }
     
-    for (;;) {
-        if (xQueueReceive(deauthQueue, &event, pdMS_TO_TICKS(100))) {
-            
-            if (xSemaphoreTake(deauthMutex, pdMS_TO_TICKS(5))) {
-                deauthStats.totalDeauths++;
-                
-                // Check for broadcast deauth
-                if (strcmp(event.clientMac, "FF:FF:FF:FF:FF:FF") == 0) {
-                    deauthStats.broadcastDeauths++;
-                    deauthStats.suspiciousCount++;
-                }
-                
-                // Store in history
-                deauthHistory[deauthHistoryIndex] = event;
-                deauthHistoryIndex = (deauthHistoryIndex + 1) % 20;
-                
-                // Count deauths in time window
-                if (event.timestamp - lastDeauthTime < WINDOW_MS) {
-                    deauthsInWindow++;
-                } else {
-                    deauthsInWindow = 1;
-                    lastDeauthTime = event.timestamp;
-                }
-                
-                // Track AP frequency
-                bool found = false;
-                for (int i = 0; i < trackerCount; i++) {
-                    if (strcmp(apTrackers[i].mac, event.apMac) == 0) {
-                        apTrackers[i].count++;
-                        apTrackers[i].lastSeen = event.timestamp;
-                        found = true;
-                        
-                        // Check if this AP is sending too many deauths
-                        if (apTrackers[i].count > 5) {
-                            strncpy(deauthStats.suspiciousAP, event.apMac, 17);
-                            deauthStats.suspiciousCount++;
-                        }
-                        break;
-                    }
-                }
-                
-                if (!found && trackerCount < 10) {
-                    strncpy(apTrackers[trackerCount].mac, event.apMac, 17);
-                    apTrackers[trackerCount].count = 1;
-                    apTrackers[trackerCount].lastSeen = event.timestamp;
-                    trackerCount++;
-                }
-                
-                // Detect attack
-                if (deauthsInWindow > THRESHOLD || deauthStats.broadcastDeauths > 3) {
-                    deauthStats.attackDetected = true;
-                    deauthStats.lastDetectionTime = event.timestamp;
-                }
-                
-                // Reset attack flag after 5 seconds of low activity
-                if (deauthStats.attackDetected && 
-                    event.timestamp - deauthStats.lastDetectionTime > 5000 &&
-                    deauthsInWindow < 2) {
-                    deauthStats.attackDetected = false;
-                }
-                
-                xSemaphoreGive(deauthMutex);
-            }
-        }
-        
-        // Clean old trackers
-        for (int i = 0; i < trackerCount; i++) {
-            if (millis() - apTrackers[i].lastSeen > 10000) {
-                apTrackers[i].count = 0;
-            }
-        }
-        
-        vTaskDelay(1);
+    return lastBeaconStats;
+}
+
+TwinStats WiFiHandler::getTwinStats() {
+    TwinStats snap;
+    if (twinAnalyzer.readStats(snap)) {
+        lastTwinStats = snap;
     }
-}
\ No newline at end of file
+    
+    return lastTwinStats;
+}
+
+void WiFiHandler::resetDeauthStats() {
+    if (isDeauthDetecting()) {
+        // rxTask owns the detectors while they are enabled
+        rxPipeline.requestReset(RX_DEAUTH);
+        rxPipeline.requestReset(RX_BEACONS);
+        rxPipeline.requestReset(RX_TWINS);
+        return;
+    }
+    
+    deauthAnalyzer.setThresholds(deauthThresholds);
+    deauthAnalyzer.reset(millis());
+    beaconAnalyzer.setThresholds(deauthThresholds);
+    beaconAnalyzer.reset(millis());
+    twinAnalyzer.setThresholds(deauthThresholds);
+    twinAnalyzer.reset(millis());
+}
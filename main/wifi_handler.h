@@ -4,11 +4,96 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <esp_wifi.h>
+#include <esp_timer.h>
+#include <atomic>
 #include "shared_types.h"
+#include "spsc_ring.h"
+#include "seqlock.h"
+#include "station_table.h"
+#include "channel_hopper.h"
+#include "pcap_stream.h"
+#include "frame_decode.h"
+#include "network_table.h"
+#include "channel_load.h"
+#include "rx_pipeline.h"
+#include "rx_analyzers.h"
 
-#define MAX_NETWORKS 20
-#define WATERFALL_BUFFER_SIZE 80
+#define MAX_NETWORKS 20          // Networks copied out to the UI at once
 #define SPAM_SSID_COUNT 10
+#define RX_RING_SIZE 256         // Must be a power of two
+#define RX_BATCH_SIZE 32         // Records drained per consumer pass
+#define RX_TASK_STACK 4096       // WiFiRx stack, bytes; budget at rxTask
+#define RX_STACK_CHECK_MS 1000   // How often rxTask samples its stack high-water mark
+#define SCAN_DWELL_MS 120        // Active scan time per channel
+#define HOP_STOP_SLICE_MS 10     // Hopper checks for a stop this often while dwelling
+#define FILTER_SAMPLE_PERIOD_MS 5000 // How often the radio filter is opened up
+#define FILTER_SAMPLE_MS 100         // to count what it has been hiding
+
+// Frame classes a capture mode wants delivered to its RX callback
+struct CaptureFilter {
+    uint32_t frameMask; // WIFI_PROMIS_FILTER_MASK_*
+    uint32_t ctrlMask;  // WIFI_PROMIS_CTRL_FILTER_MASK_*, used with MASK_CTRL
+};
+
+// Analyzers on the shared RX pipeline, in registration order
+enum RxAnalyzerId {
+    RX_TRAFFIC,
+    RX_STATIONS,
+    RX_SPECTRO,
+    RX_DEAUTH,
+    RX_BEACONS,
+    RX_TWINS
+};
+
+// Per-queue health counters. enqueued/dropped/highWater are written only by
+// the RX callback, the latency fields only by the consumer task.
+struct QueueCounters {
+    std::atomic<uint32_t> enqueued;
+    std::atomic<uint32_t> dropped;
+    std::atomic<uint32_t> highWater;
+    std::atomic<uint32_t> latencyAvgUs;
+    std::atomic<uint32_t> latencyMaxUs;
+
+    void reset() {
+        enqueued.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        highWater.store(0, std::memory_order_relaxed);
+        latencyAvgUs.store(0, std::memory_order_relaxed);
+        latencyMaxUs.store(0, std::memory_order_relaxed);
+    }
+
+    void onPush(bool queued, uint32_t depth) {
+        if (!queued) {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        enqueued.store(enqueued.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (depth > highWater.load(std::memory_order_relaxed)) {
+            highWater.store(depth, std::memory_order_relaxed);
+        }
+    }
+
+    void onConsume(uint32_t latencyUs) {
+        // EWMA with 1/16 weight keeps this O(1) and overflow-free
+        uint32_t avg = latencyAvgUs.load(std::memory_order_relaxed);
+        avg = (avg == 0) ? latencyUs : avg - (avg >> 4) + (latencyUs >> 4);
+        latencyAvgUs.store(avg, std::memory_order_relaxed);
+        if (latencyUs > latencyMaxUs.load(std::memory_order_relaxed)) {
+            latencyMaxUs.store(latencyUs, std::memory_order_relaxed);
+        }
+    }
+
+    QueueStats snapshot(uint32_t capacity) const {
+        QueueStats qs;
+        qs.enqueued = enqueued.load(std::memory_order_relaxed);
+        qs.dropped = dropped.load(std::memory_order_relaxed);
+        qs.highWater = highWater.load(std::memory_order_relaxed);
+        qs.capacity = capacity;
+        qs.latencyAvgUs = latencyAvgUs.load(std::memory_order_relaxed);
+        qs.latencyMaxUs = latencyMaxUs.load(std::memory_order_relaxed);
+        return qs;
+    }
+};
 
 class WiFiHandler {
 public:
@@ -21,22 +106,74 @@ public:
     ModuleState getState() const { return moduleState; }
     
     // ===== SNIFFER MODE =====
+    // Sniffer and deauth detector are analyzers on one shared capture
+    // path, so either can start or stop without disturbing the other
     void startSniffer();
     void stopSniffer();
+    bool isSniffing() const { return rxPipeline.isEnabled(RX_TRAFFIC); }
     WiFiStats getStats();
     void resetStats();
     void setChannel(int ch);
     int getChannel() const { return currentChannel; }
     
-    // Waterfall data access
-    int getWaterfallData(int8_t* buffer, int maxSize);
+    // Time x channel heatmap: row n holds spectroLevel() of the frames
+    // seen per channel (1-13) during tick n
+    uint32_t getSpectrogramRows() const { return spectroAnalyzer.rows().rowCount(); }
+    bool getSpectrogramRow(uint32_t n, uint8_t* out) const { return spectroAnalyzer.rows().readRow(n, out); }
+    
+    // 802.11 type/subtype breakdown of sniffed frames
+    void getFrameHistogram(FrameHistogram& out);
+    
+    // Busiest transmitters seen by the sniffer
+    void getTopTalkers(TopTalkers& out);
+    
+    // Capture queue health and per-analyzer cost
+    PipelineStats getPipelineStats();
+    
+    // ===== CHANNEL HOPPING (sniffer / deauth detector) =====
+    void startHopping();
+    void stopHopping();
+    bool isHopping() const { return hopperTaskHandle != NULL; }
+    void setHopConfig(const HopConfig& cfg) { hopConfig = cfg; } // Applied on next startHopping()
+    HopConfig getHopConfig() const { return hopConfig; }
+    void getHopStats(HopStats& out);
+    
+    // ===== PCAP EXPORT =====
+    void startCapture();
+    void stopCapture();
+    bool isCapturing() const { return moduleState == STATE_CAPTURING; }
+    void setCaptureSnapLen(uint16_t len);
+    uint16_t getCaptureSnapLen() const { return captureSnapLen; }
+    CaptureStats getCaptureStats();
     
     // ===== SCANNER MODE =====
+    // Scans in its own task one channel at a time, merging results as
+    // each channel completes. cancelScan() returns immediately; the scan
+    // stops after the channel in progress.
     void startScan();
-    int getNetworkCount() const { return networkCount; }
-    WiFiNetwork* getNetworks() { return networks; }
+    void cancelScan() { scanCancelRequested = true; }
+    bool isScanning() const { return scanTaskHandle != NULL; }
+    ScanProgress getScanProgress();
+    
+    // Results persist across scans, merged by BSSID and aged out after
+    // the TTL
+    int getNetworkCount() const { return networkTable.size(); }
+    int getNetworkCapacity() const { return networkTable.getCapacity(); }
+    // Copies up to maxCount matching networks in the current sort order;
+    // matched gets the total number of matches. -1 if the table is busy.
+    int copyNetworks(WiFiNetwork* out, int maxCount,
+                     const NetworkFilter& filter = NETWORK_FILTER_ALL, int* matched = NULL);
+    void setNetworkSort(NetworkSort sort);
+    NetworkSort getNetworkSort() const { return networkTable.getSort(); }
+    void clearNetworks();
+    void setNetworkTtl(uint32_t ms) { networkTtlMs = ms; }
+    uint32_t getNetworkTtl() const { return networkTtlMs; }
     const char* getAuthTypeName(uint8_t authType);
     
+    // Per-channel congestion, recomputed whenever the table changes.
+    // false if the table is busy.
+    bool copyChannelLoad(ChannelLoad& out);
+    
     // ===== BEACON SPAMMER =====
     void startSpammer();
     void stopSpammer();
@@ -44,53 +181,122 @@ public:
     const char** getSpamSSIDs() { return spamSSIDs; }
     
     // ===== DEAUTH DETECTOR =====
+    // Runs the whole management-frame set: deauth/disassoc floods, beacon
+    // floods and evil twin candidates
     void startDeauthDetector();
     void stopDeauthDetector();
+    bool isDeauthDetecting() const { return rxPipeline.isEnabled(RX_DEAUTH); }
     DeauthStats getDeauthStats();
+    DeauthAnalytics getDeauthAnalytics();
+    // age 0 = newest; read in place, no copy of the ring
+    bool getDeauthHistory(int age, DeauthEvent& out);
+    int getDeauthHistorySize();
+    BeaconFloodStats getBeaconFloodStats();
+    TwinStats getTwinStats();
     void resetDeauthStats();
+    void setDeauthThresholds(const DeauthThresholds& t) { deauthThresholds = t; } // Applied on next start
+    DeauthThresholds getDeauthThresholds() const { return deauthThresholds; }
 
 private:
     // Task functions
-    static void snifferTask(void* pvParameters);
+    static void rxTask(void* pvParameters);
     static void spammerTask(void* pvParameters);
-    static void deauthDetectorTask(void* pvParameters);
-    static void snifferCallback(void* buf, wifi_promiscuous_pkt_type_t type);
-    static void deauthCallback(void* buf, wifi_promiscuous_pkt_type_t type);
+    static void hopperTask(void* pvParameters);
+    static void captureTask(void* pvParameters);
+    static void scanTask(void* pvParameters);
+    static void captureCallback(void* buf, wifi_promiscuous_pkt_type_t type);
+    static void rxCallback(void* buf, wifi_promiscuous_pkt_type_t type);
     
     // Task handles
-    TaskHandle_t snifferTaskHandle;
+    volatile TaskHandle_t rxTaskHandle;
     TaskHandle_t spammerTaskHandle;
-    TaskHandle_t deauthTaskHandle;
+    volatile TaskHandle_t hopperTaskHandle;
+    volatile TaskHandle_t captureTaskHandle;
+    volatile TaskHandle_t scanTaskHandle;
     
-    // Queue for packet data
-    static QueueHandle_t dataQueue;
-    static QueueHandle_t deauthQueue;
+    // Shared RX callback -> rxTask (lock-free SPSC) -> analyzers. Each
+    // analyzer owns its state on rxTask and publishes its own snapshots
+    static SpscRing<WiFiEventData, RX_RING_SIZE> rxRing;
+    static QueueCounters rxQueueCounters;
+    static volatile bool rxStopRequested;
+    static std::atomic<uint32_t> rxMalformed;
+    static WiFiEventData rxBatch[RX_BATCH_SIZE];  // rxTask's drain buffer, off its stack
+    static std::atomic<uint32_t> rxStackFree;
+    static RxPipeline rxPipeline;
+    static TrafficAnalyzer trafficAnalyzer;
+    static StationAnalyzer stationAnalyzer;
+    static SpectrogramAnalyzer spectroAnalyzer;
+    static DeauthAnalyzer deauthAnalyzer;
+    static BeaconFloodAnalyzer beaconAnalyzer;
+    static TwinAnalyzer twinAnalyzer;
+    void startRxPipeline();
+    void stopRxPipeline();
+    void stopRxPipelineIfIdle();
+    
+    // PCAP export: RX callback -> captureTask -> Serial
+    static SpscRing<PcapSlot, PCAP_RING_SIZE> captureRing;
+    static QueueCounters captureQueueCounters;
+    static volatile uint16_t captureSnapLen;
+    static volatile bool captureStopRequested;
+    static std::atomic<uint32_t> captureFramesSent;
+    static std::atomic<uint32_t> captureBytesSent;
+    uint32_t consoleBaud;
     
     // Mutex for thread-safe access
-    static SemaphoreHandle_t statsMutex;
-    static SemaphoreHandle_t waterfallMutex;
     static SemaphoreHandle_t networkMutex;
-    static SemaphoreHandle_t deauthMutex;
     
-    // Sniffer statistics (protected by mutex)
-    static WiFiStats stats;
-    static int currentChannel;
+    // Last consistent analyzer snapshots seen by the UI
+    WiFiStats lastStats;
+    FrameHistogram lastFrames;
+    TopTalkers lastTalkers;
+    
+    // Channel control. Frames/deauths per channel are bumped by the RX
+    // callbacks (index = channel). Running totals, never reset: hopperTask
+    // and the spectrogram each keep their own baseline and use deltas
+    static volatile int currentChannel;
+    static ChannelHopper hopper;
+    static volatile bool hopStopRequested;
+    HopConfig hopConfig;
+    static Seqlock<HopStats> hopSnapshot;
+    HopStats lastHopStats;
+    static std::atomic<uint32_t> channelFrames[HOP_LAST_CHANNEL + 2];
+    static std::atomic<uint32_t> channelDeauths[HOP_LAST_CHANNEL + 2];
+    static void countChannelFrame(uint8_t channel, bool isDeauth);
     
-    // Waterfall buffer (circular)
-    static int8_t waterfallBuffer[WATERFALL_BUFFER_SIZE];
-    static int waterfallIndex;
+    // Hardware promiscuous filter. Callbacks count frames outside the
+    // mode's mask, which only reach them while a sample window has the
+    // radio filter opened to everything
+    static volatile uint32_t activeFilterMask;
+    static CaptureFilter filterForSlots(uint64_t slots);
+    static std::atomic<uint32_t> filterSampleHits;
+    static std::atomic<uint32_t> filterAvoidedPerSec;
+    static uint32_t filterSampleStart;
+    static uint32_t filterNextSample;
+    static void applyFilter(const CaptureFilter& filter);
+    static void sampleFilter(uint32_t now);
+    static bool filterRejects(wifi_promiscuous_pkt_type_t type);
     
-    // Scanner data
-    WiFiNetwork networks[MAX_NETWORKS];
-    int networkCount;
+    // Scanner data, written by scanTask under networkMutex. Storage is
+    // allocated once in begin(), from PSRAM when the board has it
+    NetworkTable networkTable;
+    volatile uint32_t networkTtlMs;
+    volatile bool scanCancelRequested;
+    volatile bool scanCancelled;
+    volatile uint8_t scanChannel;
+    volatile uint8_t scanChannelsDone;
+    volatile uint32_t scanGeneration;
+    ChannelLoad channelLoad;
+    void mergeScanResults(int count);
     
     // Spammer SSIDs
     static const char* spamSSIDs[SPAM_SSID_COUNT];
     
-    // Deauth detection
-    static DeauthStats deauthStats;
-    static DeauthEvent deauthHistory[20];
-    static int deauthHistoryIndex;
+    // Management frame detectors, run by deauth/beacon/twinAnalyzer
+    DeauthStats lastDeauthStats;
+    DeauthAnalytics lastDeauthAnalytics;
+    BeaconFloodStats lastBeaconStats;
+    TwinStats lastTwinStats;
+    DeauthThresholds deauthThresholds;
     
     // State
     ModuleState moduleState;
@@ -98,6 +304,9 @@ private:
     
     // Helper functions
     void cleanupTasks();
+    void stopCaptureTask();
+    void stopScanTask();
+    void stopRxTask();
     uint8_t beaconPacket[128];
     void createBeaconFrame(uint8_t* packet, const char* ssid, uint8_t channel);
 };
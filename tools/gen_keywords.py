@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Generate main/name_keywords.h from tools/bt_keywords.txt.
+
+Builds an Aho-Corasick automaton over every BLE name keyword and flattens
+it into a DFA, so main/name_classifier.cpp can match all of them,
+case-insensitively, in one pass over a name with one table lookup per
+character. Each line of the keyword file is a device type followed by its
+keywords; a "flag" line adds keywords that set the tracker flag instead:
+
+    Phone: phone|iphone|galaxy|pixel
+    flag Tracker: tile|airtag|chipolo
+
+Only the characters that appear in some keyword get their own input
+class; everything else (digits, spaces, UTF-8 bytes) shares class 0,
+which always leads back to the root.
+
+The automaton is built here rather than by constexpr code in main/
+because main/ is held to gnu++11 (arduino-esp32 2.x; see
+host/CMakeLists.txt). C++11 constexpr functions are a single return
+statement, which is no way to run a BFS over a trie. Building offline also
+keeps the sketch's compile time down and leaves the tables as a readable
+diff when a keyword changes.
+
+Usage:
+    gen_keywords.py main/name_keywords.h [tools/bt_keywords.txt]
+"""
+
+import os
+import sys
+from collections import deque
+
+TRACKER_BIT = 0x80
+
+
+def load_keywords(path):
+    """Return [(keyword, output bits)] and the type names in order."""
+    keywords = []
+    types = []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            name, words = line.split(":", 1)
+            name = name.strip()
+            if name.startswith("flag "):
+                bit = TRACKER_BIT
+            else:
+                types.append(name)
+                bit = 1 << (len(types) - 1)
+            for w in words.split("|"):
+                w = w.strip().lower()
+                if w:
+                    keywords.append((w, bit))
+    if len(types) > 7:
+        sys.exit("at most 7 device types fit below the tracker bit")
+    return keywords, types
+
+
+def build(keywords):
+    """Aho-Corasick trie plus failure links, flattened to a full DFA."""
+    alphabet = sorted({c for w, _ in keywords for c in w})
+    if any(ord(c) > 127 for c in alphabet):
+        sys.exit("keywords must be ASCII")
+    classes = {c: i + 1 for i, c in enumerate(alphabet)}
+
+    goto = [{}]
+    out = [0]
+    for word, bit in keywords:
+        s = 0
+        for c in word:
+            if c not in goto[s]:
+                goto.append({})
+                out.append(0)
+                goto[s][c] = len(goto) - 1
+            s = goto[s][c]
+        out[s] |= bit
+
+    if len(goto) > 256:
+        sys.exit("more than 256 states, widen the state type")
+
+    n_classes = len(alphabet) + 1
+    fail = [0] * len(goto)
+    dfa = [[0] * n_classes for _ in goto]
+    queue = deque()
+    for c, t in goto[0].items():
+        dfa[0][classes[c]] = t
+        queue.append(t)
+
+    # Breadth first, so a state's failure target is complete before it
+    while queue:
+        s = queue.popleft()
+        out[s] |= out[fail[s]]
+        for cls in range(n_classes):
+            dfa[s][cls] = dfa[fail[s]][cls]
+        for c, t in goto[s].items():
+            fail[t] = dfa[fail[s]][classes[c]]
+            dfa[s][classes[c]] = t
+            queue.append(t)
+
+    return classes, dfa, out
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    here = os.path.dirname(os.path.abspath(__file__))
+    keywords_path = sys.argv[2] if len(sys.argv) > 2 else os.path.join(here, "bt_keywords.txt")
+    keywords, types = load_keywords(keywords_path)
+    classes, dfa, out = build(keywords)
+
+    char_class = [0] * 128
+    for c, cls in classes.items():
+        char_class[ord(c)] = cls
+        char_class[ord(c.upper())] = cls
+
+    with open(sys.argv[1], "w", encoding="utf-8") as f:
+        f.write("#ifndef NAME_KEYWORDS_H\n#define NAME_KEYWORDS_H\n\n")
+        f.write("// Generated by tools/gen_keywords.py from tools/bt_keywords.txt, do not edit.\n")
+        f.write("// %d keywords, %d types (%s), %d states, %d input classes.\n\n"
+                % (len(keywords), len(types), ", ".join(types), len(dfa), len(dfa[0])))
+        f.write("#include <stdint.h>\n\n")
+        f.write("#define NAME_KW_STATES %d\n" % len(dfa))
+        f.write("#define NAME_KW_CLASSES %d\n" % len(dfa[0]))
+        f.write("#define NAME_KW_TRACKER 0x%02X\n\n" % TRACKER_BIT)
+        f.write("// ASCII -> input class, case folded; 0 = not in any keyword\n")
+        f.write("static constexpr uint8_t NAME_KW_CLASS[128] = {\n")
+        for i in range(0, 128, 16):
+            f.write("    " + " ".join("%2d," % v for v in char_class[i:i + 16]) + "\n")
+        f.write("};\n\n")
+        f.write("// [state][class] -> next state, failure links already folded in\n")
+        f.write("static constexpr uint8_t NAME_KW_NEXT[NAME_KW_STATES][NAME_KW_CLASSES] = {\n")
+        for row in dfa:
+            f.write("    {" + ",".join("%d" % v for v in row) + "},\n")
+        f.write("};\n\n")
+        f.write("// Keywords ending in each state: bit (type - 1), or NAME_KW_TRACKER\n")
+        f.write("static constexpr uint8_t NAME_KW_OUT[NAME_KW_STATES] = {\n")
+        for i in range(0, len(out), 16):
+            f.write("    " + " ".join("0x%02X," % v for v in out[i:i + 16]) + "\n")
+        f.write("};\n\n#endif\n")
+
+    print("%d keywords, %d states -> %s" % (len(keywords), len(dfa), sys.argv[1]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Generate main/oui_data.h from the IEEE MA-L registry.
+
+The full registry is ~35k assignments, far too much flash next to the Wi-Fi
+and BLE stacks, so only the vendors listed in tools/oui_vendors.txt are
+kept. Each line there is a short display name followed by the registry
+organisation names it covers (case-insensitive substrings):
+
+    Apple: Apple, Inc.
+    TP-Link: TP-LINK|TP-Link Systems
+
+The output is a sorted constexpr table of (prefix << 8 | vendor index)
+words plus the vendor name table, both in flash. main/oui_lookup.cpp
+binary-searches it.
+
+Usage:
+    gen_oui.py oui.csv main/oui_data.h [tools/oui_vendors.txt]
+
+oui.csv is https://standards-oui.ieee.org/oui/oui.csv
+"""
+
+import csv
+import os
+import sys
+
+
+def load_vendors(path):
+    vendors = []
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            name, patterns = line.split(":", 1)
+            vendors.append((name.strip(), [p.strip().lower() for p in patterns.split("|") if p.strip()]))
+    if len(vendors) > 255:
+        sys.exit("at most 255 vendors fit the 8-bit index")
+    return vendors
+
+
+def load_registry(path, vendors):
+    """Yield (prefix, vendor index) for every assignment owned by a listed vendor."""
+    with open(path, newline="", encoding="utf-8") as f:
+        for row in csv.DictReader(f):
+            if row.get("Registry", "MA-L") != "MA-L":
+                continue
+            org = row["Organization Name"].lower()
+            for idx, (_, patterns) in enumerate(vendors):
+                if any(p in org for p in patterns):
+                    yield int(row["Assignment"], 16), idx
+                    break
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit(__doc__)
+    here = os.path.dirname(os.path.abspath(__file__))
+    vendors_path = sys.argv[3] if len(sys.argv) > 3 else os.path.join(here, "oui_vendors.txt")
+    vendors = load_vendors(vendors_path)
+
+    table = {}
+    for prefix, idx in load_registry(sys.argv[1], vendors):
+        table.setdefault(prefix, idx)
+    entries = sorted(table.items())
+
+    with open(sys.argv[2], "w", encoding="utf-8") as out:
+        out.write("#ifndef OUI_DATA_H\n#define OUI_DATA_H\n\n")
+        out.write("// Generated by tools/gen_oui.py from the IEEE MA-L registry, do not edit.\n")
+        out.write("// %d assignments, %d vendors.\n\n" % (len(entries), len(vendors)))
+        out.write("#include <stdint.h>\n\n")
+        out.write("static constexpr const char* OUI_VENDOR_NAMES[] = {\n")
+        for name, _ in vendors:
+            out.write('    "%s",\n' % name.replace('"', '\\"'))
+        out.write("};\n\n")
+        out.write("// (prefix << 8) | index into OUI_VENDOR_NAMES, sorted by prefix\n")
+        out.write("static constexpr uint32_t OUI_TABLE[] = {\n")
+        for i in range(0, len(entries), 6):
+            row = entries[i:i + 6]
+            out.write("    " + " ".join("0x%06X%02X," % (p, v) for p, v in row) + "\n")
+        out.write("};\n\n#endif\n")
+
+    print("%d assignments, %d vendors -> %s" % (len(entries), len(vendors), sys.argv[2]))
+
+
+if __name__ == "__main__":
+    main()
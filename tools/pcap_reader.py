@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Reassemble the ESP32 "PCAP Export" serial stream into a .pcap file.
+
+The device wraps every pcap piece in a small frame so it can be picked out
+of any console text on the same port:
+
+    0xA5 0x5A | type (1) | length (2, LE) | payload | fletcher16 (2, LE)
+
+type 1 = pcap global header (re-sent every ~2 s), type 2 = one pcap record
+(radiotap + 802.11). See main/pcap_stream.h.
+
+Usage:
+    pcap_reader.py /dev/ttyUSB0 capture.pcap      # live, needs pyserial
+    pcap_reader.py raw_dump.bin capture.pcap      # replay a saved byte dump
+"""
+
+import os
+import stat
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+FRAME_HEADER = 1
+FRAME_PACKET = 2
+BAUD = 921600
+
+
+def fletcher16(data):
+    a = b = 0
+    for byte in data:
+        a = (a + byte) % 255
+        b = (b + a) % 255
+    return (b << 8) | a
+
+
+def frames(chunks):
+    """Yield (type, payload) for every valid frame in a stream of byte chunks."""
+    buf = bytearray()
+    for chunk in chunks:
+        buf += chunk
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                del buf[:-1]  # Keep a possible half sync byte
+                break
+            del buf[:start]
+            if len(buf) < 5:
+                break
+            ftype = buf[2]
+            length = struct.unpack_from("<H", buf, 3)[0]
+            total = 5 + length + 2
+            if len(buf) < total:
+                break
+            checksum = struct.unpack_from("<H", buf, 5 + length)[0]
+            if ftype in (FRAME_HEADER, FRAME_PACKET) and checksum == fletcher16(buf[2:5 + length]):
+                yield ftype, bytes(buf[5:5 + length])
+                del buf[:total]
+            else:
+                del buf[:2]  # False sync, skip it and rescan
+
+
+def open_source(path):
+    if stat.S_ISCHR(os.stat(path).st_mode):
+        import serial  # pyserial
+        port = serial.Serial(path, BAUD, timeout=0.5)
+        return iter(lambda: port.read(4096), None)
+    f = open(path, "rb")
+    return iter(lambda: f.read(65536), b"")
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 1
+
+    packets = 0
+    header_written = False
+    with open(sys.argv[2], "wb") as out:
+        try:
+            for ftype, payload in frames(open_source(sys.argv[1])):
+                if ftype == FRAME_HEADER:
+                    if not header_written:
+                        out.write(payload)
+                        header_written = True
+                elif header_written:
+                    out.write(payload)
+                    packets += 1
+                    if packets % 100 == 0:
+                        out.flush()
+                        print("\r%d packets" % packets, end="", file=sys.stderr)
+        except KeyboardInterrupt:
+            pass
+
+    print("\r%d packets written to %s" % (packets, sys.argv[2]), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())